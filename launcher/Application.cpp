@@ -108,6 +108,8 @@
 #include <minecraft/auth/AccountList.h>
 #include "icons/IconList.h"
 #include "net/HttpMetaCache.h"
+#include "modplatform/helpers/ResourceStore.h"
+#include "minecraft/AssetsManifest.h"
 
 #include "java/JavaInstallList.h"
 
@@ -609,6 +611,9 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting("ConsoleFontSize", defaultSize);
         m_settings->registerSetting("ConsoleMaxLines", 100000);
         m_settings->registerSetting("ConsoleOverflowStop", true);
+        m_settings->registerSetting("ConsoleOverflowSpill", false);
+        // in MiB
+        m_settings->registerSetting("ConsoleSpillMaxSize", 256);
 
         // Folders
         m_settings->registerSetting("InstanceDir", "instances");
@@ -899,6 +904,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_metacache->addBase("meta", QDir("meta").absolutePath());
         m_metacache->addBase("java", QDir("cache/java").absolutePath());
         m_metacache->Load();
+        m_resourceStore.reset(new ResourceStore(QDir("cache/store").absolutePath()));
+        m_assetsManifest.reset(new AssetsManifest(QDir("assets/objects").absolutePath(), QDir("cache").absoluteFilePath("assets.json")));
         qDebug() << "<> Cache initialized.";
     }
 
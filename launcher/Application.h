@@ -58,6 +58,8 @@ class SetupWizard;
 class GenericPageProvider;
 class QFile;
 class HttpMetaCache;
+class ResourceStore;
+class AssetsManifest;
 class SettingsObject;
 class InstanceList;
 class AccountList;
@@ -144,6 +146,10 @@ class Application : public QApplication {
 
     shared_qobject_ptr<HttpMetaCache> metacache();
 
+    std::shared_ptr<ResourceStore> resourceStore() const { return m_resourceStore; }
+
+    std::shared_ptr<AssetsManifest> assetsManifest() const { return m_assetsManifest; }
+
     shared_qobject_ptr<Meta::Index> metadataIndex();
 
     void updateCapabilities();
@@ -245,6 +251,8 @@ class Application : public QApplication {
     shared_qobject_ptr<AccountList> m_accounts;
 
     shared_qobject_ptr<HttpMetaCache> m_metacache;
+    std::shared_ptr<ResourceStore> m_resourceStore;
+    std::shared_ptr<AssetsManifest> m_assetsManifest;
     shared_qobject_ptr<Meta::Index> m_metadataIndex;
 
     std::shared_ptr<SettingsObject> m_settings;
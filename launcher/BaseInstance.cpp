@@ -95,6 +95,8 @@ BaseInstance::BaseInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr s
 
     m_settings->registerPassthrough(globalSettings->getSetting("ConsoleMaxLines"), nullptr);
     m_settings->registerPassthrough(globalSettings->getSetting("ConsoleOverflowStop"), nullptr);
+    m_settings->registerPassthrough(globalSettings->getSetting("ConsoleOverflowSpill"), nullptr);
+    m_settings->registerPassthrough(globalSettings->getSetting("ConsoleSpillMaxSize"), nullptr);
 
     // Managed Packs
     m_settings->registerSetting("ManagedPack", false);
@@ -190,7 +192,18 @@ int BaseInstance::getConsoleMaxLines() const
 
 bool BaseInstance::shouldStopOnConsoleOverflow() const
 {
-    return m_settings->get("ConsoleOverflowStop").toBool();
+    // keeping the lines that scroll out makes stopping pointless
+    return m_settings->get("ConsoleOverflowStop").toBool() && !shouldSpillConsoleOverflow();
+}
+
+bool BaseInstance::shouldSpillConsoleOverflow() const
+{
+    return m_settings->get("ConsoleOverflowSpill").toBool();
+}
+
+qint64 BaseInstance::getConsoleSpillMaxSize() const
+{
+    return qint64(qMax(1, m_settings->get("ConsoleSpillMaxSize").toInt())) * 1024 * 1024;
 }
 
 QStringList BaseInstance::getLinkedInstances() const
@@ -262,6 +262,9 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
 
     int getConsoleMaxLines() const;
     bool shouldStopOnConsoleOverflow() const;
+    bool shouldSpillConsoleOverflow() const;
+    // in bytes, for all kept console logs of the instance together
+    qint64 getConsoleSpillMaxSize() const;
 
     QStringList getLinkedInstances() const;
     void setLinkedInstances(const QStringList& list);
@@ -0,0 +1,113 @@
+#include "CensorFilter.h"
+
+#include <QQueue>
+#include <QVarLengthArray>
+
+CensorFilter::CensorFilter(const QMap<QString, QString>& secrets)
+{
+    for (auto it = secrets.begin(); it != secrets.end(); it++) {
+        for (auto c : it.key()) {
+            auto code = c.unicode();
+            if (code < 128 && m_ascii[code] == 0)
+                m_ascii[code] = m_columns++;
+            else if (code >= 128 && !m_other.contains(code))
+                m_other.insert(code, m_columns++);
+        }
+    }
+
+    // the trie first, with -1 for missing transitions
+    m_next.assign(m_columns, -1);
+    m_output.assign(1, -1);
+    for (auto it = secrets.begin(); it != secrets.end(); it++) {
+        if (it.key().isEmpty())
+            continue;
+        int state = 0;
+        for (auto c : it.key()) {
+            auto& next = m_next[state * m_columns + column(c.unicode())];
+            if (next == -1) {
+                next = static_cast<int>(m_output.size());
+                m_output.push_back(-1);
+                m_next.resize(m_next.size() + m_columns, -1);
+            }
+            state = m_next[state * m_columns + column(c.unicode())];
+        }
+        m_output[state] = static_cast<int>(m_patterns.size());
+        m_patterns.push_back({ static_cast<int>(it.key().size()), it.value() });
+    }
+
+    // then the failure links, folded into the table breadth first, so matching never has to follow them
+    std::vector<int> fail(m_output.size(), 0);
+    QQueue<int> queue;
+    for (int c = 0; c < m_columns; c++) {
+        auto& next = m_next[c];
+        if (next == -1) {
+            next = 0;
+        } else {
+            queue.enqueue(next);
+        }
+    }
+    while (!queue.isEmpty()) {
+        auto state = queue.dequeue();
+        for (int c = 0; c < m_columns; c++) {
+            auto& next = m_next[state * m_columns + c];
+            auto fallback = m_next[fail[state] * m_columns + c];
+            if (next == -1) {
+                next = fallback;
+                continue;
+            }
+            fail[next] = fallback;
+            // a secret ending here is longer than any of its suffixes
+            if (m_output[next] == -1)
+                m_output[next] = m_output[fallback];
+            queue.enqueue(next);
+        }
+    }
+}
+
+QString CensorFilter::apply(const QString& in) const
+{
+    if (m_patterns.empty())
+        return in;
+
+    struct Span {
+        int start;
+        int end;
+        int pattern;
+    };
+    QVarLengthArray<Span, 8> spans;
+
+    int state = 0;
+    const auto* data = in.constData();
+    for (int i = 0, size = in.size(); i < size; i++) {
+        state = m_next[state * m_columns + column(data[i].unicode())];
+        auto pattern = m_output[state];
+        if (pattern == -1)
+            continue;
+
+        Span span{ i + 1 - m_patterns[pattern].length, i + 1, pattern };
+        // overlapping secrets are merged, keeping the placeholder of the one that starts first
+        while (!spans.isEmpty() && spans.last().end > span.start) {
+            auto last = spans.last();
+            spans.removeLast();
+            if (last.start <= span.start) {
+                if (last.start < span.start)
+                    span.pattern = last.pattern;
+                span.start = last.start;
+            }
+        }
+        spans.append(span);
+    }
+    if (spans.isEmpty())
+        return in;
+
+    QString out;
+    out.reserve(in.size());
+    int position = 0;
+    for (auto& span : spans) {
+        out.append(data + position, span.start - position);
+        out.append(m_patterns[span.pattern].replacement);
+        position = span.end;
+    }
+    out.append(data + position, in.size() - position);
+    return out;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+
+#include <vector>
+
+/* Replaces secrets (tokens, ids) in text with placeholders.
+ *
+ * The secrets are compiled into an Aho-Corasick automaton, so a line is scanned once no matter how many secrets
+ * there are, and a line without any comes back as is, without a copy. Where secrets overlap, the whole stretch
+ * they cover is replaced, with the placeholder of the one starting first, so no part of either is left. */
+class CensorFilter {
+   public:
+    CensorFilter() = default;
+    // maps each secret to its placeholder. empty secrets are ignored
+    explicit CensorFilter(const QMap<QString, QString>& secrets);
+
+    bool isEmpty() const { return m_patterns.empty(); }
+    QString apply(const QString& in) const;
+
+   private:
+    struct Pattern {
+        int length;
+        QString replacement;
+    };
+
+    int column(ushort c) const
+    {
+        if (c < 128)
+            return m_ascii[c];
+        return m_other.value(c, 0);
+    }
+
+    // column 0 is every character no secret contains
+    int m_columns = 1;
+    int m_ascii[128] = {};
+    QHash<ushort, int> m_other;
+
+    // the full transition table, m_columns entries per state
+    std::vector<int> m_next;
+    // per state, the longest secret ending there, or -1
+    std::vector<int> m_output;
+    std::vector<Pattern> m_patterns;
+};
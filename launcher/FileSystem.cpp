@@ -102,10 +102,12 @@ namespace fs = ghc::filesystem;
 #include <fcntl.h> /* Definition of FICLONE* constants */
 #include <linux/fs.h>
 #include <sys/ioctl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #elif defined(Q_OS_MACOS)
 #include <sys/attr.h>
 #include <sys/clonefile.h>
+#include <sys/stat.h>
 #elif defined(Q_OS_WIN)
 // winbtrfs clone vs rundll32 shellbtrfs.dll,ReflinkCopy
 #include <fileapi.h>
@@ -1654,6 +1656,30 @@ uintmax_t hardLinkCount(const QString& path)
     return count;
 }
 
+quint64 fileId(const QString& path)
+{
+#if defined(Q_OS_WIN)
+    auto handle = CreateFileW(path.toStdWString().c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return 0;
+    quint64 id = 0;
+    BY_HANDLE_FILE_INFORMATION info;
+    if (GetFileInformationByHandle(handle, &info))
+        id = quint64(info.nFileIndexHigh) << 32 | info.nFileIndexLow;
+    CloseHandle(handle);
+    return id;
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    struct stat info;
+    if (::stat(QFile::encodeName(path).constData(), &info) != 0)
+        return 0;
+    return quint64(info.st_ino);
+#else
+    Q_UNUSED(path)
+    return 0;
+#endif
+}
+
 #ifdef Q_OS_WIN
 // returns 8.3 file format from long path
 QString shortPathName(const QString& file)
@@ -556,6 +556,12 @@ bool canLink(const QString& src, const QString& dst);
 
 uintmax_t hardLinkCount(const QString& path);
 
+/**
+ * @brief identifies the file on its filesystem (the inode on Unix, the file index on Windows), 0 if that fails
+ *
+ */
+quint64 fileId(const QString& path);
+
 #ifdef Q_OS_WIN
 QString getPathNameInLocal8bit(const QString& file);
 #endif
@@ -60,22 +60,35 @@ bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedByte
     }
 
     int err = Z_OK;
+    // total_out starts over with every gzip member
+    unsigned totalOut = 0;
+    bool hadMember = false;
 
     while (!done) {
         // If our output buffer is too small
-        if (strm.total_out >= uncompLength) {
+        if (totalOut >= uncompLength) {
             uncompressedBytes.resize(uncompLength * 2);
             uncompLength *= 2;
         }
 
-        strm.next_out = reinterpret_cast<Bytef*>((uncompressedBytes.data() + strm.total_out));
-        strm.avail_out = uncompLength - strm.total_out;
+        strm.next_out = reinterpret_cast<Bytef*>((uncompressedBytes.data() + totalOut));
+        strm.avail_out = uncompLength - totalOut;
 
         // Inflate another chunk.
+        unsigned availOut = strm.avail_out;
         err = inflate(&strm, Z_SYNC_FLUSH);
-        if (err == Z_STREAM_END)
-            done = true;
-        else if (err != Z_OK) {
+        totalOut += availOut - strm.avail_out;
+        if (err == Z_STREAM_END) {
+            // a gzip file may be several members in a row, which make up one stream together
+            hadMember = true;
+            if (strm.avail_in == 0)
+                done = true;
+            else if (inflateReset(&strm) != Z_OK)
+                break;
+        } else if (err != Z_OK) {
+            // like gzip, ignore whatever comes after a complete member and doesn't read as one, e.g. the last one of a
+            // file that was still being written
+            done = hadMember;
             break;
         }
     }
@@ -84,11 +97,11 @@ bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedByte
         return false;
     }
 
-    uncompressedBytes.resize(strm.total_out);
+    uncompressedBytes.resize(totalOut);
     return true;
 }
 
-bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
+bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes, int level)
 {
     if (uncompressedBytes.size() == 0) {
         compressedBytes = uncompressedBytes;
@@ -102,7 +115,7 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
     z_stream zs;
     memset(&zs, 0, sizeof(zs));
 
-    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (16 + MAX_WBITS), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    if (deflateInit2(&zs, level, Z_DEFLATED, (16 + MAX_WBITS), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
         return false;
     }
 
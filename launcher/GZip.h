@@ -4,5 +4,6 @@
 class GZip {
    public:
     static bool unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes);
-    static bool zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes);
+    // level is zlib's compression level, -1 for its default
+    static bool zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes, int level = -1);
 };
@@ -94,20 +94,26 @@ void InstanceImportTask::downloadFromUrl()
 {
     const QString path(m_sourceUrl.host() + '/' + m_sourceUrl.path());
 
-    auto entry = APPLICATION->metacache()->resolveEntry("general", path);
-    entry->setStale(true);
-    m_archivePath = entry->getFullPath();
-
-    auto filesNetJob = makeShared<NetJob>(tr("Modpack download"), APPLICATION->network());
-    filesNetJob->addNetAction(Net::ApiDownload::makeCached(m_sourceUrl, entry));
-
-    connect(filesNetJob.get(), &NetJob::succeeded, this, &InstanceImportTask::processZipPack);
-    connect(filesNetJob.get(), &NetJob::progress, this, &InstanceImportTask::setProgress);
-    connect(filesNetJob.get(), &NetJob::stepProgress, this, &InstanceImportTask::propagateStepProgress);
-    connect(filesNetJob.get(), &NetJob::failed, this, &InstanceImportTask::emitFailed);
-    connect(filesNetJob.get(), &NetJob::aborted, this, &InstanceImportTask::emitAborted);
-    m_task.reset(filesNetJob);
-    filesNetJob->start();
+    // a cached modpack can be large, so checking it is left to the thread pool
+    APPLICATION->metacache()->resolveEntries("general", { path }, this, [this](QList<MetaEntryPtr> entries) {
+        // aborted meanwhile
+        if (!isRunning())
+            return;
+        auto entry = entries.first();
+        entry->setStale(true);
+        m_archivePath = entry->getFullPath();
+
+        auto filesNetJob = makeShared<NetJob>(tr("Modpack download"), APPLICATION->network());
+        filesNetJob->addNetAction(Net::ApiDownload::makeCached(m_sourceUrl, entry, Net::Download::Option::Segmented));
+
+        connect(filesNetJob.get(), &NetJob::succeeded, this, &InstanceImportTask::processZipPack);
+        connect(filesNetJob.get(), &NetJob::progress, this, &InstanceImportTask::setProgress);
+        connect(filesNetJob.get(), &NetJob::stepProgress, this, &InstanceImportTask::propagateStepProgress);
+        connect(filesNetJob.get(), &NetJob::failed, this, &InstanceImportTask::emitFailed);
+        connect(filesNetJob.get(), &NetJob::aborted, this, &InstanceImportTask::emitAborted);
+        m_task.reset(filesNetJob);
+        filesNetJob->start();
+    });
 }
 
 QString InstanceImportTask::getRootFromZip(QuaZip* zip, const QString& root)
@@ -38,9 +38,10 @@
 #include <QDebug>
 #include <QTextDecoder>
 #include "MessageLevel.h"
+#include "launch/LogPipeline.h"
 
 LoggedProcess::LoggedProcess(const QTextCodec* output_codec, QObject* parent)
-    : QProcess(parent), m_err_decoder(output_codec), m_out_decoder(output_codec)
+    : QProcess(parent), m_codec(output_codec), m_err_decoder(output_codec), m_out_decoder(output_codec)
 {
     // QProcess has a strange interface... let's map a lot of those into a few.
     connect(this, &QProcess::readyReadStandardOutput, this, &LoggedProcess::on_stdOut);
@@ -74,12 +75,20 @@ QStringList LoggedProcess::reprocess(const QByteArray& data, QTextDecoder& decod
 
 void LoggedProcess::on_stdErr()
 {
+    if (m_pipeline) {
+        m_pipeline->addData(readAllStandardError(), MessageLevel::StdErr);
+        return;
+    }
     auto lines = reprocess(readAllStandardError(), m_err_decoder);
     emit log(lines, MessageLevel::StdErr);
 }
 
 void LoggedProcess::on_stdOut()
 {
+    if (m_pipeline) {
+        m_pipeline->addData(readAllStandardOutput(), MessageLevel::StdOut);
+        return;
+    }
     auto lines = reprocess(readAllStandardOutput(), m_out_decoder);
     emit log(lines, MessageLevel::StdOut);
 }
@@ -178,3 +187,10 @@ void LoggedProcess::setDetachable(bool detachable)
 {
     m_is_detachable = detachable;
 }
+
+void LoggedProcess::setLogPipeline(LogPipeline* pipeline)
+{
+    m_pipeline = pipeline;
+    if (m_pipeline)
+        m_pipeline->setCodec(m_codec);
+}
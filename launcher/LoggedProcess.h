@@ -39,6 +39,8 @@
 #include <QTextDecoder>
 #include "MessageLevel.h"
 
+class LogPipeline;
+
 /*
  * This is a basic process.
  * It has line-based logging support and hides some of the nasty bits.
@@ -56,6 +58,8 @@ class LoggedProcess : public QProcess {
     int exitCode() const;
 
     void setDetachable(bool detachable);
+    // hand the output to pipeline undecoded, instead of emitting it through log()
+    void setLogPipeline(LogPipeline* pipeline);
 
    signals:
     void log(QStringList lines, MessageLevel::Enum level);
@@ -80,6 +84,8 @@ class LoggedProcess : public QProcess {
     QStringList reprocess(const QByteArray& data, QTextDecoder& decoder);
 
    private:
+    const QTextCodec* m_codec;
+    LogPipeline* m_pipeline = nullptr;
     QTextDecoder m_err_decoder;
     QTextDecoder m_out_decoder;
     QString m_leftover_line;
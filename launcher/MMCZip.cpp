@@ -70,14 +70,18 @@ bool mergeZipFiles(QuaZip* into, QFileInfo from, QSet<QString>& contained, const
         }
         contained.insert(filename);
 
-        if (!fileInsideMod.open(QIODevice::ReadOnly)) {
+        // copy the compressed data as is, instead of inflating and deflating it again
+        QuaZipFileInfo64 info_in;
+        int method, level;
+        if (!modZip.getCurrentFileInfo(&info_in) || !fileInsideMod.open(QIODevice::ReadOnly, &method, &level, true)) {
             qCritical() << "Failed to open " << filename << " from " << from.fileName();
             return false;
         }
 
         QuaZipNewInfo info_out(fileInsideMod.getActualFileName());
+        info_out.uncompressedSize = info_in.uncompressedSize;
 
-        if (!zipOutFile.open(QIODevice::WriteOnly, info_out)) {
+        if (!zipOutFile.open(QIODevice::WriteOnly, info_out, nullptr, info_in.crc, method, level, true)) {
             qCritical() << "Failed to open " << filename << " in the jar";
             fileInsideMod.close();
             return false;
@@ -25,6 +25,7 @@
 #include "minecraft/mod/ResourceFolderModel.h"
 
 #include "modplatform/helpers/HashUtils.h"
+#include "modplatform/helpers/ResourceStore.h"
 #include "net/ApiDownload.h"
 #include "net/ChecksumValidator.h"
 
@@ -55,7 +56,8 @@ ResourceDownloadTask::ResourceDownloadTask(ModPlatform::IndexedPack::Ptr pack,
         }
     }
 
-    auto action = Net::ApiDownload::makeFile(m_pack_version.downloadUrl, dir.absoluteFilePath(getFilename()));
+    m_target_path = dir.absoluteFilePath(getFilename());
+    auto action = Net::ApiDownload::makeFile(m_pack_version.downloadUrl, m_target_path);
     if (!m_pack_version.hash_type.isEmpty() && !m_pack_version.hash.isEmpty()) {
         switch (Hashing::algorithmFromString(m_pack_version.hash_type)) {
             case Hashing::Algorithm::Md4:
@@ -77,6 +79,11 @@ ResourceDownloadTask::ResourceDownloadTask(ModPlatform::IndexedPack::Ptr pack,
                 break;
         }
     }
+    if (ResourceStore::supports(Hashing::algorithmFromString(m_pack_version.hash_type))) {
+        connect(action.get(), &Task::succeeded, this, [this] {
+            APPLICATION->resourceStore()->add(m_target_path, Hashing::algorithmFromString(m_pack_version.hash_type), m_pack_version.hash);
+        });
+    }
     m_filesNetJob->addNetAction(action);
     connect(m_filesNetJob.get(), &NetJob::succeeded, this, &ResourceDownloadTask::downloadSucceeded);
     connect(m_filesNetJob.get(), &NetJob::progress, this, &ResourceDownloadTask::downloadProgressChanged);
@@ -86,6 +93,15 @@ ResourceDownloadTask::ResourceDownloadTask(ModPlatform::IndexedPack::Ptr pack,
     addTask(m_filesNetJob);
 }
 
+void ResourceDownloadTask::executeTask()
+{
+    // with the file already in the store there is nothing to download, but the emptied job still
+    // finishes after the update task, so the old version gets removed as usual
+    if (APPLICATION->resourceStore()->deploy(Hashing::algorithmFromString(m_pack_version.hash_type), m_pack_version.hash, m_target_path))
+        m_filesNetJob->clear();
+    SequentialTask::executeTask();
+}
+
 void ResourceDownloadTask::downloadSucceeded()
 {
     m_filesNetJob.reset();
@@ -0,0 +1,248 @@
+#include "ZipReader.h"
+
+#include <zlib.h>
+#include <QDebug>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace {
+constexpr quint32 endOfDirectorySignature = 0x06054b50;
+constexpr quint32 zip64LocatorSignature = 0x07064b50;
+constexpr quint32 zip64EndOfDirectorySignature = 0x06064b50;
+constexpr quint32 directoryEntrySignature = 0x02014b50;
+constexpr quint32 localHeaderSignature = 0x04034b50;
+
+constexpr int endOfDirectorySize = 22;
+constexpr int zip64LocatorSize = 20;
+constexpr int zip64EndOfDirectorySize = 56;
+constexpr int directoryEntrySize = 46;
+constexpr int localHeaderSize = 30;
+
+constexpr quint16 encryptedFlag = 1 << 0;
+constexpr quint16 utf8Flag = 1 << 11;
+constexpr quint16 stored = 0;
+constexpr quint16 deflated = 8;
+
+// nothing we look for is anywhere near this, it only keeps a broken archive from asking for all the memory
+constexpr qint64 maxFileSize = 256 * 1024 * 1024;
+
+quint16 u16(const char* data)
+{
+    return qFromLittleEndian<quint16>(data);
+}
+quint32 u32(const char* data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+quint64 u64(const char* data)
+{
+    return qFromLittleEndian<quint64>(data);
+}
+}  // namespace
+
+ZipReader::ZipReader(const QString& path) : m_file(path) {}
+
+QByteArray ZipReader::bytes(qint64 offset, qint64 size) const
+{
+    if (offset < 0 || size < 0 || offset > m_size || size > m_size - offset) {
+        return {};
+    }
+    if (m_map) {
+        return QByteArray::fromRawData(reinterpret_cast<const char*>(m_map + offset), int(size));
+    }
+    if (!m_file.seek(offset)) {
+        return {};
+    }
+    if (size == 0) {
+        return QByteArray("", 0);
+    }
+    auto data = m_file.read(size);
+    return data.size() == size ? data : QByteArray();
+}
+
+bool ZipReader::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    m_size = m_file.size();
+    // falls back to reading when the file can't be mapped
+    m_map = m_file.map(0, m_size);
+    m_open = readDirectory();
+    if (!m_open) {
+        qWarning() << "Could not read the zip directory of" << m_file.fileName();
+        m_entries.clear();
+        m_names.clear();
+        m_folders.clear();
+    }
+    return m_open;
+}
+
+bool ZipReader::readDirectory()
+{
+    if (m_size < endOfDirectorySize) {
+        return false;
+    }
+    // the end of directory record is followed by a comment of up to 64 KiB
+    auto tailSize = std::min<qint64>(m_size, endOfDirectorySize + 0xffff);
+    auto tail = bytes(m_size - tailSize, tailSize);
+    if (tail.isNull()) {
+        return false;
+    }
+    int end = -1;
+    for (int i = tail.size() - endOfDirectorySize; i >= 0; i--) {
+        if (u32(tail.constData() + i) == endOfDirectorySignature) {
+            end = i;
+            break;
+        }
+    }
+    if (end < 0) {
+        return false;
+    }
+    auto record = tail.constData() + end;
+    qint64 count = u16(record + 10);
+    qint64 directorySize = u32(record + 12);
+    qint64 directoryOffset = u32(record + 16);
+
+    if (count == 0xffff || directorySize == 0xffffffff || directoryOffset == 0xffffffff) {
+        auto locatorOffset = m_size - tailSize + end - zip64LocatorSize;
+        auto locator = bytes(locatorOffset, zip64LocatorSize);
+        if (locator.isNull() || u32(locator.constData()) != zip64LocatorSignature) {
+            return false;
+        }
+        auto zip64 = bytes(qint64(u64(locator.constData() + 8)), zip64EndOfDirectorySize);
+        if (zip64.isNull() || u32(zip64.constData()) != zip64EndOfDirectorySignature) {
+            return false;
+        }
+        count = qint64(u64(zip64.constData() + 32));
+        directorySize = qint64(u64(zip64.constData() + 40));
+        directoryOffset = qint64(u64(zip64.constData() + 48));
+    }
+
+    auto directory = bytes(directoryOffset, directorySize);
+    if (directory.isNull() || count < 0 || count > directorySize / directoryEntrySize) {
+        return false;
+    }
+    m_entries.reserve(int(count));
+    m_names.reserve(int(count));
+
+    const char* data = directory.constData();
+    qint64 pos = 0;
+    // most archives list the files of a folder together
+    QString lastFolder;
+    for (qint64 i = 0; i < count; i++) {
+        if (directorySize - pos < directoryEntrySize || u32(data + pos) != directoryEntrySignature) {
+            return false;
+        }
+        auto header = data + pos;
+        Entry entry;
+        entry.flags = u16(header + 8);
+        entry.method = u16(header + 10);
+        entry.compressed_size = u32(header + 20);
+        entry.size = u32(header + 24);
+        int nameSize = u16(header + 28);
+        int extraSize = u16(header + 30);
+        int commentSize = u16(header + 32);
+        entry.local_header_offset = u32(header + 42);
+        if (directorySize - pos - directoryEntrySize < nameSize + extraSize + commentSize) {
+            return false;
+        }
+
+        auto nameData = header + directoryEntrySize;
+        // the codepage of the archive is unknown without the flag, but what we look for is ascii anyway
+        auto name = entry.flags & utf8Flag ? QString::fromUtf8(nameData, nameSize) : QString::fromLatin1(nameData, nameSize);
+
+        // the zip64 extra field has the values that didn't fit, in this order
+        auto extra = nameData + nameSize;
+        for (int e = 0; e + 4 <= extraSize;) {
+            int id = u16(extra + e);
+            int size = u16(extra + e + 2);
+            if (e + 4 + size > extraSize) {
+                break;
+            }
+            if (id == 0x0001) {
+                auto field = extra + e + 4;
+                int used = 0;
+                auto next = [&](qint64& value) {
+                    if (value == 0xffffffff && used + 8 <= size) {
+                        value = qint64(u64(field + used));
+                        used += 8;
+                    }
+                };
+                next(entry.size);
+                next(entry.compressed_size);
+                next(entry.local_header_offset);
+            }
+            e += 4 + size;
+        }
+        pos += directoryEntrySize + nameSize + extraSize + commentSize;
+
+        auto folder = name.left(std::max(0, int(name.lastIndexOf('/'))));
+        if (folder != lastFolder) {
+            for (int slash = name.indexOf('/'); slash > 0; slash = name.indexOf('/', slash + 1)) {
+                m_folders.insert(name.left(slash));
+            }
+            lastFolder = folder;
+        }
+        if (name.endsWith('/')) {
+            continue;
+        }
+        // like QuaZip, the first of the same name wins
+        if (!m_entries.contains(name)) {
+            m_names.append(name);
+            m_entries.insert(name, entry);
+        }
+    }
+    return true;
+}
+
+QByteArray ZipReader::read(const QString& name) const
+{
+    auto it = m_entries.constFind(name);
+    if (!m_open || it == m_entries.constEnd()) {
+        return {};
+    }
+    auto& entry = *it;
+    if (entry.flags & encryptedFlag || entry.size > maxFileSize || entry.compressed_size > maxFileSize) {
+        qWarning() << "Can't read" << name << "from" << m_file.fileName();
+        return {};
+    }
+
+    auto header = bytes(entry.local_header_offset, localHeaderSize);
+    if (header.isNull() || u32(header.constData()) != localHeaderSignature) {
+        return {};
+    }
+    auto dataOffset = entry.local_header_offset + localHeaderSize + u16(header.constData() + 26) + u16(header.constData() + 28);
+    auto data = bytes(dataOffset, entry.compressed_size);
+    if (data.isNull()) {
+        return {};
+    }
+
+    switch (entry.method) {
+        case stored:
+            return data.size() == entry.size ? data : QByteArray();
+        case deflated: {
+            QByteArray result(int(entry.size), Qt::Uninitialized);
+            z_stream stream{};
+            // raw deflate, there is no zlib header in a zip
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+                return {};
+            }
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+            stream.avail_in = uInt(data.size());
+            stream.next_out = reinterpret_cast<Bytef*>(result.data());
+            stream.avail_out = uInt(result.size());
+            auto status = inflate(&stream, Z_FINISH);
+            inflateEnd(&stream);
+            // an empty file may be stored as just the end of the stream, or as nothing at all
+            if ((status != Z_STREAM_END && !(entry.size == 0 && status == Z_BUF_ERROR)) || stream.total_out != uLong(entry.size)) {
+                return {};
+            }
+            return result;
+        }
+        default:
+            qWarning() << "Can't read" << name << "from" << m_file.fileName() << ", it uses compression method" << entry.method;
+            return {};
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/* Reads single files out of a zip archive, for looking into mods and packs.
+ *
+ * The central directory is read once when the archive is opened and kept as a hash of the names in it, so asking for
+ * a file that isn't there costs nothing, unlike QuaZip::setCurrentFile which walks the whole directory every time.
+ * The archive is memory mapped when possible and stored files are read without copying. Only stored and deflated
+ * files can be read, without encryption; zip64 archives are supported. */
+class ZipReader {
+   public:
+    explicit ZipReader(const QString& path);
+
+    bool open();
+    bool isOpen() const { return m_open; }
+
+    bool contains(const QString& name) const { return m_entries.contains(name); }
+    // whether there is a folder of this path, like QuaZipDir::exists. without slashes around it
+    bool containsFolder(const QString& path) const { return m_folders.contains(path); }
+    // in the order of the central directory
+    QStringList fileNames() const { return m_names; }
+
+    // the contents of the file, a null QByteArray if it isn't there or can't be read.
+    // the result may point into the mapped archive, so it must not outlive the reader
+    QByteArray read(const QString& name) const;
+
+   private:
+    struct Entry {
+        quint16 flags;
+        quint16 method;
+        qint64 compressed_size;
+        qint64 size;
+        qint64 local_header_offset;
+    };
+
+    // bytes of the archive, from the map or read from the file
+    QByteArray bytes(qint64 offset, qint64 size) const;
+    bool readDirectory();
+
+    mutable QFile m_file;
+    uchar* m_map = nullptr;
+    qint64 m_size = 0;
+    bool m_open = false;
+
+    QHash<QString, Entry> m_entries;
+    QStringList m_names;
+    QSet<QString> m_folders;
+};
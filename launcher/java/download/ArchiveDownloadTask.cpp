@@ -36,10 +36,19 @@ void ArchiveDownloadTask::executeTask()
     // JRE found ! download the zip
     setStatus(tr("Downloading Java"));
 
-    MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry("java", m_url.fileName());
+    // a cached runtime archive is large, so checking it is left to the thread pool
+    APPLICATION->metacache()->resolveEntries("java", { m_url.fileName() }, this, [this](QList<MetaEntryPtr> entries) {
+        // aborted meanwhile
+        if (!isRunning())
+            return;
+        downloadArchive(entries.first());
+    });
+}
 
+void ArchiveDownloadTask::downloadArchive(MetaEntryPtr entry)
+{
     auto download = makeShared<NetJob>(QString("JRE::DownloadJava"), APPLICATION->network());
-    auto action = Net::Download::makeCached(m_url, entry);
+    auto action = Net::Download::makeCached(m_url, entry, Net::Download::Option::Segmented);
     if (!m_checksum_hash.isEmpty() && !m_checksum_type.isEmpty()) {
         auto hashType = QCryptographicHash::Algorithm::Sha1;
         if (m_checksum_type == "sha256") {
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <QUrl>
+#include "net/HttpMetaCache.h"
 #include "tasks/Task.h"
 
 namespace Java {
@@ -35,6 +36,9 @@ class ArchiveDownloadTask : public Task {
    private slots:
     void extractJava(QString input);
 
+   private:
+    void downloadArchive(MetaEntryPtr entry);
+
    protected:
     QUrl m_url;
     QString m_final_path;
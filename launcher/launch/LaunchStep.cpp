@@ -24,3 +24,18 @@ LaunchStep::LaunchStep(LaunchTask* parent) : Task(), m_parent(parent)
     connect(this, &LaunchStep::finished, parent, &LaunchTask::onStepFinished);
     connect(this, &LaunchStep::progressReportingRequest, parent, &LaunchTask::onProgressReportingRequested);
 }
+
+void LaunchStep::declare(Resources reads, Resources writes)
+{
+    m_declared = true;
+    m_reads = reads;
+    m_writes = writes;
+}
+
+bool LaunchStep::dependsOn(const LaunchStep& earlier) const
+{
+    if (!m_declared || !earlier.m_declared)
+        return true;
+    // reading the same things is fine, anything else has to keep the order
+    return !!(m_writes & (earlier.m_reads | earlier.m_writes)) || !!(m_reads & earlier.m_writes);
+}
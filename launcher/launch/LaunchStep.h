@@ -23,10 +23,35 @@
 class LaunchTask;
 class LaunchStep : public Task {
     Q_OBJECT
+   public:
+    /// what launch steps work on. a step that changes something runs apart from the other steps that use it
+    enum Resource {
+        GameFolder = 1 << 0,
+        ServerAddress = 1 << 1,
+        Components = 1 << 2,
+        Java = 1 << 3,
+        Account = 1 << 4,
+        Libraries = 1 << 5,
+        JarMods = 1 << 6,
+        Mods = 1 << 7,
+        Natives = 1 << 8,
+        Assets = 1 << 9,
+    };
+    Q_DECLARE_FLAGS(Resources, Resource)
+
    public: /* methods */
     explicit LaunchStep(LaunchTask* parent);
     virtual ~LaunchStep() = default;
 
+    /// declares what the step reads and changes, so it may run at the same time as steps it has nothing in common with.
+    /// a step that doesn't declare anything runs after all the steps before it, and before all the steps after it
+    void declare(Resources reads, Resources writes);
+    /// whether this step has to wait for the earlier one to finish
+    bool dependsOn(const LaunchStep& earlier) const;
+
+    /// shown in the timings of the launch
+    virtual QString name() const { return metaObject()->className(); }
+
    signals:
     void logLines(QStringList lines, MessageLevel::Enum level);
     void logLine(QString line, MessageLevel::Enum level);
@@ -40,4 +65,11 @@ class LaunchStep : public Task {
 
    protected: /* data */
     LaunchTask* m_parent;
+
+   private:
+    bool m_declared = false;
+    Resources m_reads;
+    Resources m_writes;
 };
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(LaunchStep::Resources)
@@ -43,7 +43,11 @@
 #include <QEventLoop>
 #include <QRegularExpression>
 #include <QStandardPaths>
+#include <algorithm>
+#include <limits>
+#include "FileSystem.h"
 #include "MessageLevel.h"
+#include "launch/LogSpill.h"
 #include "tasks/Task.h"
 
 void LaunchTask::init()
@@ -70,52 +74,141 @@ void LaunchTask::prependStep(shared_qobject_ptr<LaunchStep> step)
     m_steps.prepend(step);
 }
 
+namespace {
+// most steps wait on the disk or the network, a few at a time keeps them busy without getting in each other's way
+const int maxRunningSteps = 4;
+}  // namespace
+
 void LaunchTask::executeTask()
 {
+    m_timer.start();
+    m_trace = LaunchTrace();
     m_instance->setCrashed(false);
     if (!m_steps.size()) {
         state = LaunchTask::Finished;
         emitSucceeded();
+        return;
+    }
+    m_dependencies.clear();
+    for (int i = 0; i < m_steps.size(); i++) {
+        QList<int> dependencies;
+        for (int j = 0; j < i; j++) {
+            if (m_steps[i]->dependsOn(*m_steps[j])) {
+                dependencies.append(j);
+            }
+        }
+        m_dependencies.append(dependencies);
     }
+    m_runs = QVector<StepRun>(m_steps.size());
     state = LaunchTask::Running;
-    onStepFinished();
+    startReadySteps();
+}
+
+int LaunchTask::stepIndex(const QObject* step) const
+{
+    for (int i = 0; i < m_runs.size(); i++) {
+        if (m_steps[i].get() == step) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void LaunchTask::startReadySteps()
+{
+    if (m_scheduling) {
+        // a step finished while being started, the loop below looks again
+        m_rescan = true;
+        return;
+    }
+    m_scheduling = true;
+    do {
+        m_rescan = false;
+        for (int i = 0; i < m_runs.size() && m_running.size() < maxRunningSteps && !m_failed; i++) {
+            if (m_runs[i].started >= 0) {
+                continue;
+            }
+            auto& dependencies = m_dependencies[i];
+            if (!std::all_of(dependencies.cbegin(), dependencies.cend(), [this](int j) { return m_runs[j].finished >= 0; })) {
+                continue;
+            }
+            m_runs[i].started = m_timer.elapsed();
+            m_runs[i].event = m_trace.begin(m_steps[i]->name(), "step");
+            m_running.append(i);
+            m_startOrder.append(i);
+            m_steps[i]->start();
+        }
+    } while (m_rescan);
+    m_scheduling = false;
+
+    if (!m_running.isEmpty()) {
+        return;
+    }
+    if (m_failed) {
+        finalizeSteps(false, m_failReason);
+    } else if (std::all_of(m_runs.cbegin(), m_runs.cend(), [](const StepRun& run) { return run.finished >= 0; })) {
+        finalizeSteps(true, QString());
+    }
 }
 
 void LaunchTask::onReadyForLaunch()
 {
+    auto index = stepIndex(sender());
+    m_waitingStep = index >= 0 ? m_steps[index].get() : nullptr;
     state = LaunchTask::Waiting;
+    logTimings(index);
+    saveTrace();
     emit readyForLaunch();
 }
 
 void LaunchTask::onStepFinished()
 {
-    // initial -> just start the first step
-    if (currentStep == -1) {
-        currentStep++;
-        m_steps[currentStep]->start();
+    auto index = stepIndex(sender());
+    if (index < 0 || m_runs[index].started < 0 || m_runs[index].finished >= 0) {
         return;
     }
-
-    auto step = m_steps[currentStep];
-    if (step->wasSuccessful()) {
-        // end?
-        if (currentStep == m_steps.size() - 1) {
-            finalizeSteps(true, QString());
-        } else {
-            currentStep++;
-            step = m_steps[currentStep];
-            step->start();
+    auto step = m_steps[index];
+    m_runs[index].finished = m_timer.elapsed();
+    m_trace.end(m_runs[index].event);
+    m_running.removeOne(index);
+    if (m_waitingStep == step.get()) {
+        m_waitingStep = nullptr;
+    }
+    flushLogs();
+    if (m_reportingStep == step.get()) {
+        m_reportingStep = nullptr;
+        reportNextProgress();
+    }
+    if (!step->wasSuccessful() && !m_failed) {
+        m_failed = true;
+        m_failReason = step->failReason();
+        // the steps running alongside it go the way of the ones that didn't start
+        auto running = m_running;
+        for (auto other : running) {
+            if (m_runs[other].finished < 0 && m_steps[other]->canAbort()) {
+                m_steps[other]->abort();
+            }
         }
-    } else {
-        finalizeSteps(false, step->failReason());
     }
+    startReadySteps();
 }
 
 void LaunchTask::finalizeSteps(bool successful, const QString& error)
 {
-    for (auto step = currentStep; step >= 0; step--) {
-        m_steps[step]->finalize();
+    if (m_finalized) {
+        return;
+    }
+    m_finalized = true;
+    for (auto it = m_startOrder.crbegin(); it != m_startOrder.crend(); ++it) {
+        m_steps[*it]->finalize();
+    }
+    // the steps that would have let these through may never have run
+    for (int i = 0; i < m_runs.size(); i++) {
+        for (auto& held : m_heldLogs.take(i)) {
+            logPipeline()->addLines(held.lines, held.level);
+        }
     }
+    saveTrace();
     if (successful) {
         emitSucceeded();
     } else {
@@ -123,33 +216,112 @@ void LaunchTask::finalizeSteps(bool successful, const QString& error)
     }
 }
 
+int LaunchTask::traceEvent(const LaunchStep* step) const
+{
+    auto index = stepIndex(step);
+    return index >= 0 ? m_runs[index].event : -1;
+}
+
+QString LaunchTask::traceFilePath() const
+{
+    return FS::PathCombine(m_instance->instanceRoot(), "launch-trace.json");
+}
+
+void LaunchTask::saveTrace()
+{
+    m_trace.save(traceFilePath());
+}
+
+void LaunchTask::flushLogs()
+{
+    while (m_logFront < m_runs.size()) {
+        for (auto& held : m_heldLogs.take(m_logFront)) {
+            logPipeline()->addLines(held.lines, held.level);
+        }
+        if (m_runs[m_logFront].finished < 0) {
+            break;
+        }
+        m_logFront++;
+    }
+}
+
+void LaunchTask::logTimings(int lastStep)
+{
+    if (m_timingsLogged || lastStep < 0) {
+        return;
+    }
+    m_timingsLogged = true;
+    // going back from the last step through whichever of its dependencies finished last
+    QStringList path;
+    for (int i = lastStep; i >= 0;) {
+        path.prepend(m_steps[i]->name());
+        int next = -1;
+        for (auto j : m_dependencies[i]) {
+            if (next < 0 || m_runs[j].finished > m_runs[next].finished) {
+                next = j;
+            }
+        }
+        i = next;
+    }
+    // the game started, so all the steps that had to run before it are in the table
+    auto lines = m_trace.summary();
+    lines << "Critical path: " + path.join(" > ") << "The launch trace is in " + traceFilePath();
+    logPipeline()->addLines(lines, MessageLevel::Debug);
+}
+
 void LaunchTask::onProgressReportingRequested()
 {
+    auto index = stepIndex(sender());
+    if (index < 0) {
+        return;
+    }
+    auto step = m_steps[index].get();
+    if (m_reportingStep) {
+        // the progress of one step is shown at a time, the others go on meanwhile and are shown after it
+        step->proceed();
+        m_reportQueue.append(step);
+        return;
+    }
+    m_reportingStep = step;
+    m_waitingStep = step;
     state = LaunchTask::Waiting;
-    emit requestProgress(m_steps[currentStep].get());
+    // the progress dialog runs its own event loop, which must not happen in the middle of starting the other steps
+    QMetaObject::invokeMethod(this, [this, step] { emit requestProgress(step); }, Qt::QueuedConnection);
+}
+
+void LaunchTask::reportNextProgress()
+{
+    while (!m_reportQueue.isEmpty()) {
+        auto step = m_reportQueue.takeFirst();
+        auto index = stepIndex(step);
+        if (index < 0 || m_runs[index].finished >= 0) {
+            continue;
+        }
+        m_reportingStep = step;
+        QMetaObject::invokeMethod(this, [this, step] { emit requestProgress(step); }, Qt::QueuedConnection);
+        return;
+    }
 }
 
 void LaunchTask::setCensorFilter(QMap<QString, QString> filter)
 {
-    m_censorFilter = filter;
+    m_censorFilter = CensorFilter(filter);
+    logPipeline()->setCensorFilter(m_censorFilter);
 }
 
 QString LaunchTask::censorPrivateInfo(QString in)
 {
-    auto iter = m_censorFilter.begin();
-    while (iter != m_censorFilter.end()) {
-        in.replace(iter.key(), iter.value());
-        iter++;
-    }
-    return in;
+    return m_censorFilter.apply(in);
 }
 
 void LaunchTask::proceed()
 {
-    if (state != LaunchTask::Waiting) {
+    if (state != LaunchTask::Waiting || !m_waitingStep) {
         return;
     }
-    m_steps[currentStep]->proceed();
+    auto step = m_waitingStep;
+    m_waitingStep = nullptr;
+    step->proceed();
 }
 
 bool LaunchTask::canAbort() const
@@ -163,8 +335,7 @@ bool LaunchTask::canAbort() const
             return true;
         case LaunchTask::Running:
         case LaunchTask::Waiting: {
-            auto step = m_steps[currentStep];
-            return step->canAbort();
+            return std::all_of(m_running.cbegin(), m_running.cend(), [this](int i) { return m_steps[i]->canAbort(); });
         }
     }
     return false;
@@ -184,11 +355,18 @@ bool LaunchTask::abort()
         }
         case LaunchTask::Running:
         case LaunchTask::Waiting: {
-            auto step = m_steps[currentStep];
-            if (!step->canAbort()) {
+            if (!canAbort()) {
                 return false;
             }
-            if (step->abort()) {
+            bool aborted = true;
+            // aborting one may finish the others already
+            auto running = m_running;
+            for (auto i : running) {
+                if (m_runs[i].finished < 0) {
+                    aborted = m_steps[i]->abort() && aborted;
+                }
+            }
+            if (aborted) {
                 state = LaunchTask::Aborted;
                 return true;
             }
@@ -205,6 +383,11 @@ shared_qobject_ptr<LogModel> LaunchTask::getLogModel()
         m_logModel.reset(new LogModel());
         m_logModel->setMaxLines(m_instance->getConsoleMaxLines());
         m_logModel->setStopOnOverflow(m_instance->shouldStopOnConsoleOverflow());
+        if (m_instance->shouldSpillConsoleOverflow()) {
+            // next to the game's own logs, where the other logs page finds them
+            auto folder = FS::PathCombine(m_instance->getLogFileRoot(), "logs");
+            m_logModel->setSpill(std::make_unique<LogSpill>(folder, "console", m_instance->getConsoleSpillMaxSize()));
+        }
         // FIXME: should this really be here?
         m_logModel->setOverflowMessage(tr("Stopped watching the game log because the log length surpassed %1 lines.\n"
                                           "You may have to fix your mods because the game is still logging to files and"
@@ -214,31 +397,36 @@ shared_qobject_ptr<LogModel> LaunchTask::getLogModel()
     return m_logModel;
 }
 
-void LaunchTask::onLogLines(const QStringList& lines, MessageLevel::Enum defaultLevel)
+LogPipeline* LaunchTask::logPipeline()
 {
-    for (auto& line : lines) {
-        onLogLine(line, defaultLevel);
+    if (!m_logPipeline) {
+        auto model = getLogModel();
+        auto instance = m_instance;
+        // lines that scroll out can't be dropped on the way when they are kept
+        int maxLines = model->spill() ? std::numeric_limits<int>::max() : model->getMaxLines();
+        m_logPipeline = std::make_unique<LogPipeline>(
+            [instance](const QString& line, MessageLevel::Enum level) { return instance->guessLevel(line, level); }, maxLines,
+            m_instance->shouldStopOnConsoleOverflow());
+        m_logPipeline->setCensorFilter(m_censorFilter);
+        connect(m_logPipeline.get(), &LogPipeline::linesReady, model.get(), QOverload<const QVector<LogModel::Line>&>::of(&LogModel::append));
     }
+    return m_logPipeline.get();
 }
 
-void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
+void LaunchTask::onLogLines(const QStringList& lines, MessageLevel::Enum defaultLevel)
 {
-    // if the launcher part set a log level, use it
-    auto innerLevel = MessageLevel::fromLine(line);
-    if (innerLevel != MessageLevel::Unknown) {
-        level = innerLevel;
-    }
-
-    // If the level is still undetermined, guess level
-    if (level == MessageLevel::StdErr || level == MessageLevel::StdOut || level == MessageLevel::Unknown) {
-        level = m_instance->guessLevel(line, level);
+    // a step running ahead of earlier ones holds its lines back, the log reads as if the steps ran one after the other
+    auto index = stepIndex(sender());
+    if (index > m_logFront && !m_finalized) {
+        m_heldLogs[index].append({ lines, defaultLevel });
+        return;
     }
+    logPipeline()->addLines(lines, defaultLevel);
+}
 
-    // censor private user info
-    line = censorPrivateInfo(line);
-
-    auto& model = *getLogModel();
-    model.append(level, line);
+void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
+{
+    onLogLines({ line }, level);
 }
 
 void LaunchTask::emitSucceeded()
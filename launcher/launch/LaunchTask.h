@@ -38,10 +38,14 @@
 #pragma once
 #include <QObjectPtr.h>
 #include <minecraft/MinecraftInstance.h>
+#include <QElapsedTimer>
 #include <QProcess>
 #include "BaseInstance.h"
+#include "CensorFilter.h"
 #include "LaunchStep.h"
+#include "LaunchTrace.h"
 #include "LogModel.h"
+#include "LogPipeline.h"
 #include "MessageLevel.h"
 
 class LaunchTask : public Task {
@@ -67,6 +71,13 @@ class LaunchTask : public Task {
 
     qint64 pid() { return m_pid; }
 
+    /// milliseconds since the launch started
+    qint64 elapsed() const { return m_timer.elapsed(); }
+
+    LaunchTrace& trace() { return m_trace; }
+    /// the trace event of a step that started, -1 for the others
+    int traceEvent(const LaunchStep* step) const;
+
     /**
      * @brief prepare the process for launch (for multi-stage launch)
      */
@@ -85,6 +96,8 @@ class LaunchTask : public Task {
     bool canAbort() const override;
 
     shared_qobject_ptr<LogModel> getLogModel();
+    // everything logged goes through here on its way to the log model
+    LogPipeline* logPipeline();
 
    public:
     QString substituteVariables(QString& cmd, bool isLaunch = false) const;
@@ -113,13 +126,56 @@ class LaunchTask : public Task {
 
    private: /*methods */
     void finalizeSteps(bool successful, const QString& error);
+    int stepIndex(const QObject* step) const;
+    /// starts the steps whose dependencies are done, as many as may run at once
+    void startReadySteps();
+    /// passes on the lines held back for steps whose earlier steps are all done
+    void flushLogs();
+    void reportNextProgress();
+    void logTimings(int lastStep);
+    QString traceFilePath() const;
+    void saveTrace();
 
    protected: /* data */
     MinecraftInstancePtr m_instance;
     shared_qobject_ptr<LogModel> m_logModel;
+    CensorFilter m_censorFilter;
+    // steps hold on to the pipeline (e.g. the game process logs through it), so it has to outlive them
+    std::unique_ptr<LogPipeline> m_logPipeline;
     QList<shared_qobject_ptr<LaunchStep>> m_steps;
-    QMap<QString, QString> m_censorFilter;
-    int currentStep = -1;
     State state = NotStarted;
     qint64 m_pid = -1;
+    QElapsedTimer m_timer;
+    LaunchTrace m_trace;
+
+   private: /* data */
+    struct StepRun {
+        // milliseconds since the launch started, -1 until then
+        qint64 started = -1;
+        qint64 finished = -1;
+        int event = -1;
+    };
+    struct HeldLines {
+        QStringList lines;
+        MessageLevel::Enum level;
+    };
+    /// by step, the earlier steps it waits for
+    QList<QList<int>> m_dependencies;
+    QVector<StepRun> m_runs;
+    QList<int> m_running;
+    QList<int> m_startOrder;
+    /// the first step that isn't done. what later steps log is held back until it is
+    int m_logFront = 0;
+    QHash<int, QList<HeldLines>> m_heldLogs;
+    /// the step proceed() is for
+    LaunchStep* m_waitingStep = nullptr;
+    /// the step whose progress is shown, and the ones to show after it
+    LaunchStep* m_reportingStep = nullptr;
+    QList<LaunchStep*> m_reportQueue;
+    bool m_failed = false;
+    QString m_failReason;
+    bool m_finalized = false;
+    bool m_scheduling = false;
+    bool m_rescan = false;
+    bool m_timingsLogged = false;
 };
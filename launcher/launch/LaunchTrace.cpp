@@ -0,0 +1,117 @@
+#include "LaunchTrace.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "Exception.h"
+#include "FileSystem.h"
+#include "Json.h"
+#include "StringUtils.h"
+#include "net/NetRequest.h"
+
+LaunchTrace::LaunchTrace()
+{
+    m_timer.start();
+}
+
+qint64 LaunchTrace::now() const
+{
+    return m_timer.nsecsElapsed() / 1000;
+}
+
+int LaunchTrace::begin(const QString& name, const QString& category, int parent)
+{
+    int row = 0;
+    if (parent >= 0 && parent < m_events.size()) {
+        row = m_events[parent].row;
+    } else {
+        // the first row no other running event is on
+        QList<int> taken;
+        for (auto& event : m_events) {
+            if (event.end < 0) {
+                taken.append(event.row);
+            }
+        }
+        while (taken.contains(row)) {
+            row++;
+        }
+    }
+    m_events.append({ name, category, now(), -1, row, Net::NetRequest::receivedBytes(), Net::NetRequest::sentRequests() });
+    return m_events.size() - 1;
+}
+
+void LaunchTrace::end(int event)
+{
+    if (event < 0 || event >= m_events.size() || m_events[event].end >= 0) {
+        return;
+    }
+    auto& ended = m_events[event];
+    ended.bytes = bytes(ended);
+    ended.requests = requests(ended);
+    ended.end = now();
+}
+
+qint64 LaunchTrace::bytes(const Event& event) const
+{
+    return event.end >= 0 ? event.bytes : Net::NetRequest::receivedBytes() - event.bytes;
+}
+
+int LaunchTrace::requests(const Event& event) const
+{
+    return event.end >= 0 ? event.requests : Net::NetRequest::sentRequests() - event.requests;
+}
+
+QStringList LaunchTrace::summary() const
+{
+    QStringList lines{ QString("%1 %2 %3 %4 %5")
+                           .arg("Launch profile", -40)
+                           .arg("start", 10)
+                           .arg("took", 10)
+                           .arg("requests", 9)
+                           .arg("downloaded", 11) };
+    auto milliseconds = [](qint64 microseconds) { return QString::number(microseconds / 1000.0, 'f', 1) + " ms"; };
+    for (auto& event : m_events) {
+        // what happens inside a step is indented under it
+        auto name = (event.category == "step" ? "  " : "    ") + event.name;
+        auto bytes = this->bytes(event);
+        lines.append(QString("%1 %2 %3 %4 %5")
+                         .arg(name, -40)
+                         .arg(milliseconds(event.start), 10)
+                         .arg(event.end >= 0 ? milliseconds(event.end - event.start) : QString("running"), 10)
+                         .arg(requests(event), 9)
+                         .arg(bytes ? StringUtils::humanReadableFileSize(bytes) : QString(), 11));
+    }
+    return lines;
+}
+
+bool LaunchTrace::save(const QString& path) const
+{
+    auto pid = QCoreApplication::applicationPid();
+    auto time = now();
+    QJsonArray events;
+    for (auto& event : m_events) {
+        QJsonObject args{ { "requests", requests(event) }, { "bytesDownloaded", double(bytes(event)) } };
+        if (event.end < 0) {
+            args.insert("running", true);
+        }
+        // complete events, with their start and duration in microseconds
+        events.append(QJsonObject{ { "name", event.name },
+                                   { "cat", event.category },
+                                   { "ph", "X" },
+                                   { "ts", double(event.start) },
+                                   { "dur", double((event.end >= 0 ? event.end : time) - event.start) },
+                                   { "pid", double(pid) },
+                                   { "tid", event.row },
+                                   { "args", args } });
+    }
+    try {
+        FS::ensureFilePathExists(path);
+        Json::write(QJsonObject{ { "traceEvents", events }, { "displayTimeUnit", "ms" } }, path);
+    } catch (const Exception& e) {
+        qWarning() << "Could not write the launch trace" << path << ":" << e.cause();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/* A record of where the time of a launch goes, an event for each launch step and for each task run by one.
+ *
+ * It is saved in the Chrome trace event format, which chrome://tracing and Perfetto open. Events that overlap without
+ * one being inside the other are put on rows of their own. The bytes downloaded during an event are those of all the
+ * requests running meanwhile, so steps running at the same time each count them. */
+class LaunchTrace {
+   public:
+    LaunchTrace();
+
+    /// starts an event and returns it. one with a parent is drawn inside that one
+    int begin(const QString& name, const QString& category, int parent = -1);
+    void end(int event);
+
+    /// a table of the events so far, a line each
+    QStringList summary() const;
+    /// writes the trace out, returns whether it could
+    bool save(const QString& path) const;
+
+   private:
+    struct Event {
+        QString name;
+        QString category;
+        // microseconds since the trace started, -1 while the event goes on
+        qint64 start;
+        qint64 end = -1;
+        int row;
+        // what was downloaded in the whole launcher at the start, then during the event
+        qint64 bytes;
+        int requests;
+    };
+
+    qint64 now() const;
+    // the counters as they are now, or at the end of the event
+    qint64 bytes(const Event& event) const;
+    int requests(const Event& event) const;
+
+    QElapsedTimer m_timer;
+    QList<Event> m_events;
+};
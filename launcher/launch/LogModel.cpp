@@ -1,10 +1,42 @@
 #include "LogModel.h"
 
+#include <algorithm>
+
+#include "LogSpill.h"
+
+namespace {
+// lines are packed into chunks of this size, a longer line gets a chunk of its own
+constexpr int chunkSize = 64 * 1024;
+// an entry has 24 bits for the size of its line
+constexpr int maxLineSize = (1 << 24) - 1;
+// lines per search signature
+constexpr int blockSize = 16;
+constexpr int signatureBits = 64 * 64;
+
+// calls f with the signature bit of each ASCII case folded trigram in text. trigrams with other characters are left out
+template <typename F>
+void forTrigramBits(const char* text, int size, F f)
+{
+    auto fold = [](uchar c) -> quint32 { return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c; };
+    for (int i = 0; i + 2 < size; i++) {
+        auto a = uchar(text[i]), b = uchar(text[i + 1]), c = uchar(text[i + 2]);
+        // case folding anything but ASCII is not worth it here, such trigrams just don't narrow down a search
+        if ((a | b | c) & 0x80) {
+            continue;
+        }
+        quint32 trigram = fold(a) << 16 | fold(b) << 8 | fold(c);
+        f(int((trigram * 2654435761u) >> 20) % signatureBits);
+    }
+}
+}  // namespace
+
 LogModel::LogModel(QObject* parent) : QAbstractListModel(parent)
 {
     m_content.resize(m_maxLines);
 }
 
+LogModel::~LogModel() = default;
+
 int LogModel::rowCount(const QModelIndex& parent) const
 {
     if (parent.isValid())
@@ -19,12 +51,12 @@ QVariant LogModel::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto row = index.row();
-    auto realRow = (row + m_firstLine) % m_maxLines;
+    auto& entry = m_content[(row + m_firstLine) % m_maxLines];
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        return m_content[realRow].line;
+        return QString::fromUtf8(bytes(entry), entry.size());
     }
     if (role == LevelRole) {
-        return m_content[realRow].level;
+        return entry.level();
     }
 
     return QVariant();
@@ -43,7 +75,9 @@ void LogModel::append(MessageLevel::Enum level, QString line)
             return;
         }
         beginRemoveRows(QModelIndex(), 0, 0);
+        spillRows(1);
         m_firstLine = (m_firstLine + 1) % m_maxLines;
+        m_firstSerial++;
         m_numLines--;
         endRemoveRows();
     } else if (m_numLines == m_maxLines - 1 && m_stopOnOverflow) {
@@ -51,10 +85,261 @@ void LogModel::append(MessageLevel::Enum level, QString line)
         line = m_overflowMessage;
     }
     beginInsertRows(QModelIndex(), m_numLines, m_numLines);
+    store(m_content[lineNum], m_firstSerial + m_numLines, level, line);
     m_numLines++;
-    m_content[lineNum].level = level;
-    m_content[lineNum].line = line;
     endInsertRows();
+    releaseDropped();
+}
+
+void LogModel::append(const QVector<Line>& lines)
+{
+    if (m_suspended || lines.isEmpty()) {
+        return;
+    }
+    int count = lines.size();
+    int skip = 0;
+    if (m_stopOnOverflow) {
+        // whatever doesn't fit is dropped, and the line taking the last free row becomes the overflow message
+        count = std::min(count, m_maxLines - m_numLines);
+        if (count <= 0) {
+            return;
+        }
+    } else {
+        // lines that would scroll out again right away are never added
+        skip = std::max(0, count - m_maxLines);
+        count -= skip;
+        int drop = std::max(0, m_numLines + count - m_maxLines);
+        if (drop > 0) {
+            beginRemoveRows(QModelIndex(), 0, drop - 1);
+            spillRows(drop);
+            m_firstLine = (m_firstLine + drop) % m_maxLines;
+            m_firstSerial += drop;
+            m_numLines -= drop;
+            endRemoveRows();
+        }
+        if (m_spill) {
+            for (int i = 0; i < skip; i++) {
+                m_spill->add(lines[i].level, lines[i].text);
+            }
+        }
+        // they are numbered all the same, which keeps the serials in step with the spill
+        m_firstSerial += skip;
+    }
+
+    beginInsertRows(QModelIndex(), m_numLines, m_numLines + count - 1);
+    for (int i = 0; i < count; i++) {
+        auto& entry = m_content[(m_firstLine + m_numLines) % m_maxLines];
+        auto serial = m_firstSerial + m_numLines;
+        if (m_stopOnOverflow && m_numLines == m_maxLines - 1) {
+            store(entry, serial, MessageLevel::Fatal, m_overflowMessage);
+        } else {
+            store(entry, serial, lines[skip + i].level, lines[skip + i].text);
+        }
+        m_numLines++;
+    }
+    endInsertRows();
+    releaseDropped();
+}
+
+void LogModel::store(entry& entry, qint64 serial, MessageLevel::Enum level, const QString& line)
+{
+    auto utf8 = line.toUtf8();
+    if (utf8.size() > maxLineSize) {
+        utf8.truncate(maxLineSize);
+    }
+    if (m_chunks.empty() || m_chunks.back().size() + utf8.size() > chunkSize) {
+        m_chunks.emplace_back();
+        m_chunks.back().reserve(std::max<int>(chunkSize, utf8.size()));
+    }
+    auto& chunk = m_chunks.back();
+    entry.chunk = m_firstChunk + quint32(m_chunks.size() - 1);
+    entry.offset = chunk.size();
+    entry.sizeAndLevel = quint32(utf8.size()) << 8 | quint32(level);
+    chunk.append(utf8.constData(), utf8.size());
+
+    m_levelSerials[level].push_back(serial);
+    auto block = serial / blockSize;
+    if (m_signatures.empty()) {
+        m_firstBlock = block;
+    }
+    while (m_firstBlock + qint64(m_signatures.size()) <= block) {
+        m_signatures.push_back({});
+    }
+    auto& signature = m_signatures.back();
+    forTrigramBits(utf8.constData(), utf8.size(), [&signature](int bit) { signature[bit / 64] |= quint64(1) << (bit % 64); });
+}
+
+void LogModel::spillRows(int count)
+{
+    if (!m_spill) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        auto& entry = m_content[(m_firstLine + i) % m_maxLines];
+        m_spill->add(entry.level(), bytes(entry), entry.size());
+    }
+}
+
+const char* LogModel::bytes(const entry& entry) const
+{
+    return m_chunks[entry.chunk - m_firstChunk].constData() + entry.offset;
+}
+
+void LogModel::releaseDropped()
+{
+    for (auto& serials : m_levelSerials) {
+        while (!serials.empty() && serials.front() < m_firstSerial) {
+            serials.pop_front();
+        }
+    }
+    if (m_numLines == 0) {
+        m_firstChunk += quint32(m_chunks.size());
+        m_chunks.clear();
+        m_signatures.clear();
+        return;
+    }
+    // lines are stored in order, so the first line is in the oldest chunk still needed
+    auto needed = m_content[m_firstLine].chunk;
+    while (m_firstChunk != needed) {
+        m_chunks.pop_front();
+        m_firstChunk++;
+    }
+    while (!m_signatures.empty() && (m_firstBlock + 1) * blockSize <= m_firstSerial) {
+        m_signatures.pop_front();
+        m_firstBlock++;
+    }
+}
+
+bool LogModel::blockMayMatch(qint64 block, const QVector<int>& bits) const
+{
+    auto index = block - m_firstBlock;
+    if (index < 0 || index >= qint64(m_signatures.size())) {
+        return true;
+    }
+    auto& signature = m_signatures[index];
+    for (auto bit : bits) {
+        if (!(signature[bit / 64] & (quint64(1) << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Match>
+int LogModel::scan(int from, bool reverse, const QVector<int>& bits, Match match) const
+{
+    // visits the rows from first to last, skipping whole blocks whose signature rules them out
+    auto visit = [&](qint64 first, qint64 last) -> int {
+        auto row = first;
+        while (reverse ? row >= last : row <= last) {
+            auto block = (m_firstSerial + row) / blockSize;
+            if (!blockMayMatch(block, bits)) {
+                row = reverse ? block * blockSize - m_firstSerial - 1 : (block + 1) * blockSize - m_firstSerial;
+                continue;
+            }
+            if (match(m_content[(m_firstLine + row) % m_maxLines])) {
+                return int(row);
+            }
+            row += reverse ? -1 : 1;
+        }
+        return -1;
+    };
+    if (m_numLines == 0) {
+        return -1;
+    }
+    int row;
+    if (reverse) {
+        from = std::clamp(from, 0, m_numLines);
+        row = visit(from - 1, 0);
+        if (row == -1) {
+            row = visit(m_numLines - 1, from);
+        }
+    } else {
+        from = std::clamp(from, -1, m_numLines - 1);
+        row = visit(from + 1, m_numLines - 1);
+        if (row == -1) {
+            row = visit(0, from);
+        }
+    }
+    return row;
+}
+
+int LogModel::findText(const QString& text, int from, bool reverse, Qt::CaseSensitivity cs) const
+{
+    if (text.isEmpty()) {
+        return -1;
+    }
+    auto utf8 = text.toUtf8();
+    QVector<int> bits;
+    forTrigramBits(utf8.constData(), utf8.size(), [&bits](int bit) { bits.append(bit); });
+    return scan(from, reverse, bits,
+                [this, &text, cs](const entry& entry) { return QString::fromUtf8(bytes(entry), entry.size()).contains(text, cs); });
+}
+
+int LogModel::findRegularExpression(const QRegularExpression& expression, int from, bool reverse) const
+{
+    if (!expression.isValid()) {
+        return -1;
+    }
+    // nothing is known about what it matches, so every line is looked at
+    return scan(from, reverse, {}, [this, &expression](const entry& entry) {
+        return expression.match(QString::fromUtf8(bytes(entry), entry.size())).hasMatch();
+    });
+}
+
+int LogModel::findLevel(MessageLevel::Enum atLeast, int from, bool reverse) const
+{
+    if (m_numLines == 0) {
+        return -1;
+    }
+    const qint64 none = -1;
+    qint64 best = none;
+    qint64 wrapped = none;
+    if (reverse) {
+        auto origin = m_firstSerial + std::clamp(from, 0, m_numLines);
+        for (int level = atLeast; level <= MessageLevel::Fatal; level++) {
+            auto& serials = m_levelSerials[level];
+            if (serials.empty()) {
+                continue;
+            }
+            auto it = std::lower_bound(serials.begin(), serials.end(), origin);
+            if (it != serials.begin()) {
+                best = std::max(best, *std::prev(it));
+            }
+            wrapped = std::max(wrapped, serials.back());
+        }
+    } else {
+        auto origin = m_firstSerial + std::clamp(from, -1, m_numLines - 1);
+        for (int level = atLeast; level <= MessageLevel::Fatal; level++) {
+            auto& serials = m_levelSerials[level];
+            if (serials.empty()) {
+                continue;
+            }
+            auto it = std::upper_bound(serials.begin(), serials.end(), origin);
+            if (it != serials.end() && (best == none || *it < best)) {
+                best = *it;
+            }
+            if (wrapped == none || serials.front() < wrapped) {
+                wrapped = serials.front();
+            }
+        }
+    }
+    if (best == none) {
+        best = wrapped;
+    }
+    return best == none ? -1 : int(best - m_firstSerial);
+}
+
+QVector<int> LogModel::rowsAtLevel(MessageLevel::Enum atLeast) const
+{
+    QVector<int> rows;
+    for (int level = atLeast; level <= MessageLevel::Fatal; level++) {
+        for (auto serial : m_levelSerials[level]) {
+            rows.append(int(serial - m_firstSerial));
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
 }
 
 void LogModel::suspend(bool suspend)
@@ -70,21 +355,50 @@ bool LogModel::suspended()
 void LogModel::clear()
 {
     beginResetModel();
+    spillRows(m_numLines);
     m_firstLine = 0;
+    m_firstSerial += m_numLines;
     m_numLines = 0;
+    releaseDropped();
     endResetModel();
 }
 
-QString LogModel::toPlainText()
+QString LogModel::toPlainText(MessageLevel::Enum atLeast)
+{
+    QVector<int> rows;
+    if (atLeast != MessageLevel::Unknown) {
+        rows = rowsAtLevel(atLeast);
+    }
+    int count = atLeast == MessageLevel::Unknown ? m_numLines : rows.size();
+    auto entryAt = [this, atLeast, &rows](int i) -> const entry& {
+        return m_content[(m_firstLine + (atLeast == MessageLevel::Unknown ? i : rows[i])) % m_maxLines];
+    };
+
+    // gathered as UTF-8 and decoded in one go
+    qsizetype size = 0;
+    for (int i = 0; i < count; i++) {
+        size += entryAt(i).size() + 1;
+    }
+    QByteArray out;
+    out.reserve(size);
+    for (int i = 0; i < count; i++) {
+        auto& entry = entryAt(i);
+        out.append(bytes(entry), entry.size());
+        out.append('\n');
+    }
+    return QString::fromUtf8(out);
+}
+
+qint64 LogModel::memoryUsage() const
 {
-    QString out;
-    out.reserve(m_numLines * 80);
-    for (int i = 0; i < m_numLines; i++) {
-        QString& line = m_content[(m_firstLine + i) % m_maxLines].line;
-        out.append(line + '\n');
+    qint64 usage = qint64(m_content.capacity()) * sizeof(entry);
+    for (auto& chunk : m_chunks) {
+        usage += chunk.capacity();
     }
-    out.squeeze();
-    return out;
+    for (auto& serials : m_levelSerials) {
+        usage += qint64(serials.size()) * sizeof(qint64);
+    }
+    return usage + qint64(m_signatures.size()) * sizeof(Signature);
 }
 
 void LogModel::setMaxLines(int maxLines)
@@ -93,34 +407,26 @@ void LogModel::setMaxLines(int maxLines)
     if (maxLines == m_maxLines) {
         return;
     }
-    // if it all still fits in the buffer, just resize it
-    if (m_firstLine + m_numLines < m_maxLines) {
-        m_maxLines = maxLines;
-        m_content.resize(maxLines);
-        return;
-    }
-    // otherwise, we need to reorganize the data because it crosses the wrap boundary
-    QVector<entry> newContent;
-    newContent.resize(maxLines);
-    if (m_numLines <= maxLines) {
-        // if it all fits in the new buffer, just copy it over
-        for (int i = 0; i < m_numLines; i++) {
-            newContent[i] = m_content[(m_firstLine + i) % m_maxLines];
-        }
-        m_content.swap(newContent);
-    } else {
-        // if it doesn't fit, part of the data needs to be thrown away (the oldest log messages)
-        int lead = m_numLines - maxLines;
+    // only the entries are moved into the new ring buffer, the text stays in its chunks.
+    // if not all lines fit anymore, the oldest ones are thrown away
+    int lead = std::max(0, m_numLines - maxLines);
+    if (lead > 0) {
         beginRemoveRows(QModelIndex(), 0, lead - 1);
-        for (int i = 0; i < maxLines; i++) {
-            newContent[i] = m_content[(m_firstLine + lead + i) % m_maxLines];
-        }
-        m_numLines = m_maxLines;
-        m_content.swap(newContent);
-        endRemoveRows();
+        spillRows(lead);
     }
+    QVector<entry> newContent(maxLines);
+    for (int i = 0; i < m_numLines - lead; i++) {
+        newContent[i] = m_content[(m_firstLine + lead + i) % m_maxLines];
+    }
+    m_content.swap(newContent);
     m_firstLine = 0;
+    m_firstSerial += lead;
+    m_numLines -= lead;
     m_maxLines = maxLines;
+    releaseDropped();
+    if (lead > 0) {
+        endRemoveRows();
+    }
 }
 
 int LogModel::getMaxLines()
@@ -138,6 +444,22 @@ void LogModel::setOverflowMessage(const QString& overflowMessage)
     m_overflowMessage = overflowMessage;
 }
 
+void LogModel::setSpill(std::unique_ptr<LogSpill> spill)
+{
+    m_spill = std::move(spill);
+    m_spillStart = m_firstSerial;
+}
+
+LogSpill* LogModel::spill() const
+{
+    return m_spill.get();
+}
+
+qint64 LogModel::spillLine(int row) const
+{
+    return m_firstSerial + row - m_spillStart;
+}
+
 void LogModel::setLineWrap(bool state)
 {
     if (m_lineWrap != state) {
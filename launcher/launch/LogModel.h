@@ -1,30 +1,74 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QByteArray>
+#include <QRegularExpression>
 #include <QString>
+#include <QVector>
+
+#include <array>
+#include <deque>
+#include <memory>
+
 #include "MessageLevel.h"
 
+class LogSpill;
+
+/* The lines of a log, the last getMaxLines() of them (or the first, with setStopOnOverflow()).
+ *
+ * Lines are kept as UTF-8 in large shared chunks, with a small fixed size record per line in the ring buffer, and
+ * only become QStrings when a view asks for them. A chunk goes away once the ring buffer no longer refers to it.
+ *
+ * For searching, the rows of each level are indexed, and every block of a few lines has a bitmap of the trigrams in
+ * them, so a search only looks at the lines of blocks that can contain what it is looking for.
+ *
+ * With a LogSpill set, lines that scroll out (or are cleared) are handed to it instead of being thrown away. */
 class LogModel : public QAbstractListModel {
     Q_OBJECT
    public:
+    struct Line {
+        MessageLevel::Enum level;
+        QString text;
+    };
+
     explicit LogModel(QObject* parent = 0);
+    virtual ~LogModel();
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const;
     QVariant data(const QModelIndex& index, int role) const;
 
     void append(MessageLevel::Enum, QString line);
+    // same as appending the lines one by one, but with at most one row removal and one row insertion
+    void append(const QVector<Line>& lines);
     void clear();
 
     void suspend(bool suspend);
     bool suspended();
 
-    QString toPlainText();
+    // the lines of this level or any level after it in MessageLevel::Enum, as the log page shows them with a level filter
+    QString toPlainText(MessageLevel::Enum atLeast = MessageLevel::Unknown);
+    // bytes held for the lines, including the ring buffer and the search indexes
+    qint64 memoryUsage() const;
+
+    // the row of the next line containing text after from, or before it if reverse, wrapping around. -1 if there is none
+    int findText(const QString& text, int from, bool reverse, Qt::CaseSensitivity cs = Qt::CaseInsensitive) const;
+    int findRegularExpression(const QRegularExpression& expression, int from, bool reverse) const;
+    // same for the next line of this level or any level after it in MessageLevel::Enum, e.g. Error finds errors and fatal errors
+    int findLevel(MessageLevel::Enum atLeast, int from, bool reverse) const;
+    // all rows of this level or any level after it, in order
+    QVector<int> rowsAtLevel(MessageLevel::Enum atLeast) const;
 
     int getMaxLines();
     void setMaxLines(int maxLines);
     void setStopOnOverflow(bool stop);
     void setOverflowMessage(const QString& overflowMessage);
 
+    // lines that would be dropped go here from now on, until the model goes away
+    void setSpill(std::unique_ptr<LogSpill> spill);
+    LogSpill* spill() const;
+    // the number of the line of this row in the spill, once it is there. rows before 0 are lines the spill has already
+    qint64 spillLine(int row) const;
+
     void setLineWrap(bool state);
     bool wrapLines() const;
 
@@ -32,12 +76,44 @@ class LogModel : public QAbstractListModel {
 
    private /* types */:
     struct entry {
-        MessageLevel::Enum level;
-        QString line;
+        // id of the chunk holding the line, and where in it
+        quint32 chunk;
+        quint32 offset;
+        // the size in bytes, shifted left by 8, with the level in the low byte
+        quint32 sizeAndLevel;
+
+        int size() const { return sizeAndLevel >> 8; }
+        MessageLevel::Enum level() const { return static_cast<MessageLevel::Enum>(sizeAndLevel & 0xff); }
     };
 
+    // one bit per trigram hash, for blockSize consecutive lines
+    using Signature = std::array<quint64, 64>;
+
+   private:
+    // serial is the number of the line since the model was created
+    void store(entry& entry, qint64 serial, MessageLevel::Enum level, const QString& line);
+    const char* bytes(const entry& entry) const;
+    // drops the chunks and index entries of lines no longer in the ring buffer
+    void releaseDropped();
+    // hands the first count rows to the spill, if there is one
+    void spillRows(int count);
+
+    bool blockMayMatch(qint64 block, const QVector<int>& bits) const;
+    template <typename Match>
+    int scan(int from, bool reverse, const QVector<int>& bits, Match match) const;
+
    private: /* data */
     QVector<entry> m_content;
+    std::deque<QByteArray> m_chunks;
+    // id of the first chunk in m_chunks
+    quint32 m_firstChunk = 0;
+    // serial of the first line
+    qint64 m_firstSerial = 0;
+    // per level, the serials of its lines
+    std::array<std::deque<qint64>, MessageLevel::Fatal + 1> m_levelSerials;
+    std::deque<Signature> m_signatures;
+    // block of the first signature in m_signatures
+    qint64 m_firstBlock = 0;
     int m_maxLines = 1000;
     // first line in the circular buffer
     int m_firstLine = 0;
@@ -47,6 +123,9 @@ class LogModel : public QAbstractListModel {
     QString m_overflowMessage = "OVERFLOW";
     bool m_suspended = false;
     bool m_lineWrap = true;
+    std::unique_ptr<LogSpill> m_spill;
+    // serial of the first line handed to the spill
+    qint64 m_spillStart = 0;
 
    private:
     Q_DISABLE_COPY(LogModel)
@@ -0,0 +1,150 @@
+#include "LogPipeline.h"
+
+#include <QCoreApplication>
+
+class LogPipeline::Worker : public QObject {
+   public:
+    Worker(LogPipeline* pipeline, Classifier classifier, int max_lines, bool stop_on_overflow)
+        : m_pipeline(pipeline), m_classifier(std::move(classifier)), m_max_lines(max_lines), m_stop_on_overflow(stop_on_overflow)
+    {}
+
+    void setCodec(const QTextCodec* codec)
+    {
+        m_out_decoder = std::make_unique<QTextDecoder>(codec);
+        m_err_decoder = std::make_unique<QTextDecoder>(codec);
+    }
+
+    void addData(const QByteArray& data, MessageLevel::Enum level)
+    {
+        bool err = level == MessageLevel::StdErr;
+        auto& decoder = err ? m_err_decoder : m_out_decoder;
+        if (!decoder)
+            decoder = std::make_unique<QTextDecoder>(QTextCodec::codecForLocale());
+        auto& leftover = err ? m_err_leftover : m_out_leftover;
+
+        auto str = leftover + decoder->toUnicode(data);
+        auto lines = str.remove(QChar::CarriageReturn).split(QChar::LineFeed);
+        leftover = lines.takeLast();
+        addLines(lines, level);
+    }
+
+    void addLines(const QStringList& lines, MessageLevel::Enum defaultLevel)
+    {
+        for (auto line : lines) {
+            auto level = defaultLevel;
+            // if the launcher part set a log level, use it
+            auto innerLevel = MessageLevel::fromLine(line);
+            if (innerLevel != MessageLevel::Unknown) {
+                level = innerLevel;
+            }
+            // If the level is still undetermined, guess level
+            if (m_classifier && (level == MessageLevel::StdErr || level == MessageLevel::StdOut || level == MessageLevel::Unknown)) {
+                level = m_classifier(line, level);
+            }
+            m_pending.append({ level, censor.apply(line) });
+        }
+        trim();
+        send();
+    }
+
+    // for the end, nothing is sent anymore after this
+    QVector<LogModel::Line> takePending()
+    {
+        m_in_flight = true;
+        QVector<LogModel::Line> pending;
+        pending.swap(m_pending);
+        return pending;
+    }
+
+    void delivered()
+    {
+        m_in_flight = false;
+        send();
+    }
+
+    CensorFilter censor;
+
+   private:
+    // the log would only keep this much of the pending lines anyway
+    void trim()
+    {
+        auto excess = m_pending.size() - m_max_lines;
+        if (excess <= 0)
+            return;
+        if (m_stop_on_overflow)
+            m_pending.resize(m_max_lines);
+        else
+            m_pending.remove(0, excess);
+    }
+
+    void send()
+    {
+        if (m_in_flight || m_pending.isEmpty())
+            return;
+        m_in_flight = true;
+        QVector<LogModel::Line> batch;
+        batch.swap(m_pending);
+        QMetaObject::invokeMethod(m_pipeline, [pipeline = m_pipeline, worker = this, batch] {
+            emit pipeline->linesReady(batch);
+            // the next batch waits until the GUI thread got here
+            QMetaObject::invokeMethod(worker, [worker] { worker->delivered(); });
+        });
+    }
+
+    LogPipeline* m_pipeline;
+    Classifier m_classifier;
+    int m_max_lines;
+    bool m_stop_on_overflow;
+
+    std::unique_ptr<QTextDecoder> m_out_decoder;
+    std::unique_ptr<QTextDecoder> m_err_decoder;
+    QString m_out_leftover;
+    QString m_err_leftover;
+
+    QVector<LogModel::Line> m_pending;
+    bool m_in_flight = false;
+};
+
+LogPipeline::LogPipeline(Classifier classifier, int max_lines, bool stop_on_overflow, QObject* parent)
+    : QObject(parent), m_worker(new Worker(this, std::move(classifier), max_lines, stop_on_overflow))
+{
+    m_thread.setObjectName("LogPipeline");
+    m_worker->moveToThread(&m_thread);
+    m_thread.start();
+}
+
+LogPipeline::~LogPipeline()
+{
+    // the batch already posted to us comes first, then the one the worker may send when it hears about that,
+    // and then whatever else it still has
+    QCoreApplication::sendPostedEvents(this);
+    QVector<LogModel::Line> rest;
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, &rest] { rest = worker->takePending(); }, Qt::BlockingQueuedConnection);
+    QCoreApplication::sendPostedEvents(this);
+    if (!rest.isEmpty())
+        emit linesReady(rest);
+
+    m_thread.quit();
+    m_thread.wait();
+    delete m_worker;
+}
+
+void LogPipeline::setCensorFilter(const CensorFilter& filter)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, filter] { worker->censor = filter; });
+}
+
+void LogPipeline::setCodec(const QTextCodec* codec)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, codec] { worker->setCodec(codec); });
+}
+
+void LogPipeline::addData(const QByteArray& data, MessageLevel::Enum level)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, data, level] { worker->addData(data, level); });
+}
+
+void LogPipeline::addLines(const QStringList& lines, MessageLevel::Enum level)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, lines, level] { worker->addLines(lines, level); });
+}
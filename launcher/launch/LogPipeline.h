@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+#include <QTextDecoder>
+#include <QThread>
+
+#include <functional>
+#include <memory>
+
+#include "CensorFilter.h"
+#include "LogModel.h"
+#include "MessageLevel.h"
+
+/* Turns the output of a launch into log lines on a thread of its own.
+ *
+ * Raw process output is decoded and split there, and every line gets its level and is censored before it comes
+ * back to the GUI thread as a batch. A new batch is only handed over once the GUI thread got to the previous
+ * one, and whatever arrives in the meantime is gathered into the next batch. Lines that would scroll out of the
+ * log right away are dropped on the way, so a log storm costs the GUI one model update per event loop round. */
+class LogPipeline : public QObject {
+    Q_OBJECT
+   public:
+    using Classifier = std::function<MessageLevel::Enum(const QString& line, MessageLevel::Enum level)>;
+
+    // max_lines: how many lines the receiving log keeps. stop_on_overflow: whether it keeps the first or the last ones
+    LogPipeline(Classifier classifier, int max_lines, bool stop_on_overflow, QObject* parent = nullptr);
+    // hands over everything still on its way before it goes
+    virtual ~LogPipeline();
+
+    void setCensorFilter(const CensorFilter& filter);
+    void setCodec(const QTextCodec* codec);
+
+    // raw output of the process, in whatever encoding setCodec() was given. lines are only complete at a line feed
+    void addData(const QByteArray& data, MessageLevel::Enum level);
+    void addLines(const QStringList& lines, MessageLevel::Enum level);
+
+   signals:
+    void linesReady(const QVector<LogModel::Line>& lines);
+
+   private:
+    class Worker;
+
+    QThread m_thread;
+    Worker* m_worker;
+};
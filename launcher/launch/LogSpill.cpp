@@ -0,0 +1,243 @@
+#include "LogSpill.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+
+#include "FileSystem.h"
+#include "GZip.h"
+
+namespace {
+// a block is compressed once it has this many bytes or lines
+constexpr int blockBytes = 256 * 1024;
+constexpr int blockLines = 4096;
+// fast enough to keep up with a log storm on the GUI thread, logs compress well anyway
+constexpr int compressionLevel = 1;
+}  // namespace
+
+LogSpill::LogSpill(const QString& folder, const QString& family, qint64 max_size)
+    : m_folder(QDir(folder).absolutePath())
+    , m_family(family)
+    , m_name(family + "-" + QDateTime::currentDateTime().toString("yyyy-MM-dd-HHmmss"))
+    , m_max_size(max_size)
+{}
+
+LogSpill::~LogSpill()
+{
+    flush();
+}
+
+void LogSpill::add(MessageLevel::Enum level, const char* text, int size)
+{
+    if (m_failed) {
+        return;
+    }
+    auto start = m_pending_text.size();
+    m_pending_text.append(text, size);
+    // one line in the file per line of the log
+    for (auto i = start; i < m_pending_text.size(); i++) {
+        if (m_pending_text[i] == '\n') {
+            m_pending_text[i] = ' ';
+        }
+    }
+    m_pending_text.append('\n');
+    m_pending.levels.append(char(level));
+    m_pending.levelMask |= 1 << level;
+    if (m_pending_text.size() >= blockBytes || m_pending.levels.size() >= blockLines) {
+        flush();
+    }
+}
+
+void LogSpill::add(MessageLevel::Enum level, const QString& line)
+{
+    auto utf8 = line.toUtf8();
+    add(level, utf8.constData(), utf8.size());
+}
+
+void LogSpill::flush()
+{
+    if (m_failed || m_pending.levels.isEmpty()) {
+        return;
+    }
+    QByteArray compressed;
+    if (!GZip::zip(m_pending_text, compressed, compressionLevel)) {
+        qWarning() << "Could not compress log lines, no longer keeping lines that scroll out of the log";
+        m_failed = true;
+        return;
+    }
+    if (m_file_size > 0 && m_file_size + compressed.size() > m_max_size / 4) {
+        m_part++;
+        m_file_size = 0;
+    }
+    if (!FS::ensureFolderPathExists(m_folder)) {
+        qWarning() << "Could not create" << m_folder << ", no longer keeping lines that scroll out of the log";
+        m_failed = true;
+        return;
+    }
+    QFile file(currentFile());
+    if (!file.open(QIODevice::Append)) {
+        qWarning() << "Could not open" << file.fileName() << ":" << file.errorString()
+                   << ", no longer keeping lines that scroll out of the log";
+        m_failed = true;
+        return;
+    }
+    auto offset = file.size();
+    if (file.write(compressed) != compressed.size()) {
+        qWarning() << "Could not write to" << file.fileName() << ":" << file.errorString()
+                   << ", no longer keeping lines that scroll out of the log";
+        m_failed = true;
+        return;
+    }
+    file.close();
+
+    m_pending.file = file.fileName();
+    m_pending.offset = offset;
+    m_pending.size = compressed.size();
+    m_blocks.push_back(m_pending);
+    m_file_size = offset + compressed.size();
+
+    m_pending = Block();
+    m_pending.first = lineCount();
+    m_pending_text.clear();
+    prune();
+}
+
+void LogSpill::prune()
+{
+    // oldest first
+    auto files = QDir(m_folder).entryInfoList({ m_family + "-*.log.gz" }, QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (auto& info : files) {
+        total += info.size();
+    }
+    auto current = currentFile();
+    for (auto& info : files) {
+        if (total <= m_max_size) {
+            break;
+        }
+        auto path = info.absoluteFilePath();
+        if (path == current || !QFile::remove(path)) {
+            continue;
+        }
+        total -= info.size();
+        // one of our own earlier parts
+        m_blocks.erase(std::remove_if(m_blocks.begin(), m_blocks.end(), [&path](const Block& block) { return block.file == path; }),
+                       m_blocks.end());
+    }
+}
+
+QString LogSpill::currentFile() const
+{
+    auto name = m_part == 1 ? m_name : QString("%1.%2").arg(m_name).arg(m_part);
+    return FS::PathCombine(m_folder, name + ".log.gz");
+}
+
+qint64 LogSpill::firstLine() const
+{
+    return m_blocks.empty() ? m_pending.first : m_blocks.front().first;
+}
+
+qint64 LogSpill::lineCount() const
+{
+    return m_pending.first + m_pending.levels.size();
+}
+
+QList<QByteArray> LogSpill::blockLines(const Block& block) const
+{
+    auto split = [&block](const QByteArray& text) {
+        auto lines = text.split('\n');
+        // after the last line feed
+        lines.removeLast();
+        if (lines.size() != block.levels.size()) {
+            lines.clear();
+        }
+        return lines;
+    };
+    if (block.file.isEmpty()) {
+        return split(m_pending_text);
+    }
+    if (m_cached_first == block.first) {
+        return m_cached_lines;
+    }
+
+    QFile file(block.file);
+    QByteArray text;
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(block.offset) || !GZip::unzip(file.read(block.size), text)) {
+        qWarning() << "Could not read log lines back from" << block.file;
+        return {};
+    }
+    m_cached_first = block.first;
+    m_cached_lines = split(text);
+    return m_cached_lines;
+}
+
+QVector<LogModel::Line> LogSpill::lines(qint64 first, int count) const
+{
+    QVector<LogModel::Line> result;
+    auto end = first + count;
+    for (int i = 0; i < blockCount(); i++) {
+        auto& block = this->block(i);
+        auto blockEnd = block.first + block.levels.size();
+        if (blockEnd <= first || block.first >= end) {
+            continue;
+        }
+        auto lines = blockLines(block);
+        if (lines.isEmpty()) {
+            continue;
+        }
+        for (auto line = std::max(first, block.first); line < std::min(end, blockEnd); line++) {
+            auto index = int(line - block.first);
+            result.append({ static_cast<MessageLevel::Enum>(block.levels[index]), QString::fromUtf8(lines[index]) });
+        }
+    }
+    return result;
+}
+
+qint64 LogSpill::findText(const QString& text, qint64 from, bool reverse, Qt::CaseSensitivity cs) const
+{
+    if (text.isEmpty()) {
+        return -1;
+    }
+    for (int n = 0; n < blockCount(); n++) {
+        auto& block = this->block(reverse ? blockCount() - 1 - n : n);
+        int count = block.levels.size();
+        if (count == 0 || (reverse ? block.first >= from : block.first + count - 1 <= from)) {
+            continue;
+        }
+        auto lines = blockLines(block);
+        if (lines.isEmpty()) {
+            continue;
+        }
+        for (int k = 0; k < count; k++) {
+            auto index = reverse ? count - 1 - k : k;
+            auto line = block.first + index;
+            if ((reverse ? line < from : line > from) && QString::fromUtf8(lines[index]).contains(text, cs)) {
+                return line;
+            }
+        }
+    }
+    return -1;
+}
+
+qint64 LogSpill::findLevel(MessageLevel::Enum atLeast, qint64 from, bool reverse) const
+{
+    auto wanted = quint16(~((1u << atLeast) - 1));
+    for (int n = 0; n < blockCount(); n++) {
+        auto& block = this->block(reverse ? blockCount() - 1 - n : n);
+        int count = block.levels.size();
+        if (!(block.levelMask & wanted) || (reverse ? block.first >= from : block.first + count - 1 <= from)) {
+            continue;
+        }
+        for (int k = 0; k < count; k++) {
+            auto index = reverse ? count - 1 - k : k;
+            auto line = block.first + index;
+            if ((reverse ? line < from : line > from) && block.levels[index] >= atLeast) {
+                return line;
+            }
+        }
+    }
+    return -1;
+}
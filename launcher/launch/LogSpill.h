@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include <deque>
+
+#include "LogModel.h"
+#include "MessageLevel.h"
+
+/* Keeps the lines that scroll out of a LogModel in compressed files, so a long session doesn't lose its beginning.
+ *
+ * Lines are compressed in blocks, each one a gzip member appended to the file, which makes the file a regular gzip
+ * file of the log text. Where each block is and the levels of its lines stay in memory, so reading a range of lines
+ * or searching only inflates the blocks involved, and looking for a level inflates none.
+ *
+ * The files of a launch are named <family>-<date and time>[.<part>].log.gz. A new part is started when a file gets
+ * to a quarter of the size limit, and the oldest files of the family in the folder, those of earlier launches first,
+ * are deleted to keep all of them under it. */
+class LogSpill {
+   public:
+    LogSpill(const QString& folder, const QString& family, qint64 max_size);
+    // writes out what is still pending
+    ~LogSpill();
+
+    void add(MessageLevel::Enum level, const char* text, int size);
+    void add(MessageLevel::Enum level, const QString& line);
+    // compresses and writes the pending lines now instead of when there are enough for a block
+    void flush();
+
+    // the lines are numbered from 0 in the order they were added. the ones before firstLine() were pruned
+    qint64 firstLine() const;
+    qint64 lineCount() const;
+    QVector<LogModel::Line> lines(qint64 first, int count) const;
+
+    // the next line containing text after from, or before it if reverse, -1 if there is none. no wrapping around
+    qint64 findText(const QString& text, qint64 from, bool reverse, Qt::CaseSensitivity cs = Qt::CaseInsensitive) const;
+    // same for the next line of this level or any level after it in MessageLevel::Enum
+    qint64 findLevel(MessageLevel::Enum atLeast, qint64 from, bool reverse) const;
+
+    // the file being written to at the moment
+    QString currentFile() const;
+
+   private:
+    struct Block {
+        // an empty file for the pending lines
+        QString file;
+        qint64 offset = 0;
+        int size = 0;
+        qint64 first = 0;
+        // one byte per line
+        QByteArray levels;
+        // bit n is set if there is a line of level n
+        quint16 levelMask = 0;
+    };
+
+    int blockCount() const { return int(m_blocks.size()) + 1; }
+    const Block& block(int index) const { return index < int(m_blocks.size()) ? m_blocks[index] : m_pending; }
+    // the lines of a block, without their line feeds. empty if the block can't be read anymore
+    QList<QByteArray> blockLines(const Block& block) const;
+    void prune();
+
+    QString m_folder;
+    QString m_family;
+    QString m_name;
+    qint64 m_max_size;
+
+    int m_part = 1;
+    qint64 m_file_size = 0;
+    bool m_failed = false;
+
+    std::deque<Block> m_blocks;
+    Block m_pending;
+    QByteArray m_pending_text;
+
+    // the last block read, for reading and searching it line by line
+    mutable qint64 m_cached_first = -1;
+    mutable QList<QByteArray> m_cached_lines;
+};
@@ -14,6 +14,7 @@
  */
 
 #include "TaskStepWrapper.h"
+#include "launch/LaunchTask.h"
 #include "tasks/Task.h"
 
 void TaskStepWrapper::executeTask()
@@ -22,6 +23,11 @@ void TaskStepWrapper::executeTask()
         emitFailed(tr("Task aborted."));
         return;
     }
+    if (m_skip && m_skip()) {
+        m_task.reset();
+        emitSucceeded();
+        return;
+    }
     connect(m_task.get(), &Task::finished, this, &TaskStepWrapper::updateFinished);
     connect(m_task.get(), &Task::progress, this, &TaskStepWrapper::setProgress);
     connect(m_task.get(), &Task::stepProgress, this, &TaskStepWrapper::propagateStepProgress);
@@ -32,11 +38,14 @@ void TaskStepWrapper::executeTask()
 
 void TaskStepWrapper::proceed()
 {
+    // the step also waited for this, the task is what did the work
+    m_trace_event = m_parent->trace().begin(m_name, "task", m_parent->traceEvent(this));
     m_task->start();
 }
 
 void TaskStepWrapper::updateFinished()
 {
+    m_parent->trace().end(m_trace_event);
     if (m_task->wasSuccessful()) {
         m_task.reset();
         emitSucceeded();
@@ -21,15 +21,22 @@
 #include <launch/LaunchStep.h>
 #include <net/Mode.h>
 
+#include <functional>
+
 class TaskStepWrapper : public LaunchStep {
     Q_OBJECT
    public:
-    explicit TaskStepWrapper(LaunchTask* parent, Task::Ptr task) : LaunchStep(parent), m_task(task) {};
+    explicit TaskStepWrapper(LaunchTask* parent, Task::Ptr task)
+        : LaunchStep(parent), m_task(task), m_name(task->metaObject()->className()) {};
     virtual ~TaskStepWrapper() = default;
 
     void executeTask() override;
     bool canAbort() const override;
     void proceed() override;
+    QString name() const override { return m_name; }
+
+    // the task isn't run if this is true once the step starts
+    void skipIf(std::function<bool()> skip) { m_skip = std::move(skip); }
    public slots:
     bool abort() override;
 
@@ -38,4 +45,8 @@ class TaskStepWrapper : public LaunchStep {
 
    private:
     Task::Ptr m_task;
+    // the task is let go of when it is done
+    QString m_name;
+    std::function<bool()> m_skip;
+    int m_trace_event = -1;
 };
@@ -22,7 +22,7 @@
 class CheckJava : public LaunchStep {
     Q_OBJECT
    public:
-    explicit CheckJava(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit CheckJava(LaunchTask* parent) : LaunchStep(parent) { declare({}, Java); };
     virtual ~CheckJava() = default;
 
     virtual void executeTask();
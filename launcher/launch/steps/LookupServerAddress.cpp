@@ -19,6 +19,7 @@
 
 LookupServerAddress::LookupServerAddress(LaunchTask* parent) : LaunchStep(parent), m_dnsLookup(new QDnsLookup(this))
 {
+    declare({}, ServerAddress);
     connect(m_dnsLookup, &QDnsLookup::finished, this, &LookupServerAddress::on_dnsLookupFinished);
 
     m_dnsLookup->setType(QDnsLookup::SRV);
@@ -21,6 +21,7 @@
 
 PrintServers::PrintServers(LaunchTask* parent, const QStringList& servers) : LaunchStep(parent)
 {
+    declare({}, {});
     m_servers = servers;
 }
 
@@ -2,11 +2,13 @@
 
 TextPrint::TextPrint(LaunchTask* parent, const QStringList& lines, MessageLevel::Enum level) : LaunchStep(parent)
 {
+    declare({}, {});
     m_lines = lines;
     m_level = level;
 }
 TextPrint::TextPrint(LaunchTask* parent, const QString& line, MessageLevel::Enum level) : LaunchStep(parent)
 {
+    declare({}, {});
     m_lines.append(line);
     m_level = level;
 }
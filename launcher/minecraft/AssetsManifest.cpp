@@ -0,0 +1,201 @@
+#include "AssetsManifest.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+#include "FileSystem.h"
+#include "Json.h"
+
+namespace {
+const int manifestVersion = 1;
+}
+
+AssetsManifest::AssetsManifest(QString objects_dir, QString manifest_file)
+    : m_objects_dir(std::move(objects_dir)), m_manifest_file(std::move(manifest_file))
+{}
+
+QString AssetsManifest::objectPath(const QString& hash) const
+{
+    return FS::PathCombine(m_objects_dir, hash.left(2), hash);
+}
+
+QString AssetsManifest::folderPath(const QString& prefix) const
+{
+    return FS::PathCombine(m_objects_dir, prefix);
+}
+
+qint64 AssetsManifest::modifiedTime(const QString& path)
+{
+    QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+bool AssetsManifest::matches(const QString& path, const QString& hash)
+{
+    QFile file(path);
+    QCryptographicHash sha1(QCryptographicHash::Sha1);
+    return file.open(QIODevice::ReadOnly) && sha1.addData(&file) && QString::fromLatin1(sha1.result().toHex()) == hash;
+}
+
+void AssetsManifest::load()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+    if (!QFileInfo::exists(m_manifest_file))
+        return;
+    try {
+        auto root = Json::requireObject(Json::requireDocument(m_manifest_file, "assets manifest"));
+        if (Json::ensureInteger(root, "version") != manifestVersion)
+            return;
+        auto folders = Json::ensureObject(root, "folders");
+        for (auto it = folders.begin(); it != folders.end(); ++it)
+            m_folders.insert(it.key(), qint64(it.value().toDouble()));
+        // [size, modified] by hash
+        auto objects = Json::ensureObject(root, "objects");
+        for (auto it = objects.begin(); it != objects.end(); ++it) {
+            auto values = it.value().toArray();
+            m_objects[it.key().left(2)].insert(it.key(), { qint64(values.at(0).toDouble()), qint64(values.at(1).toDouble()) });
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Ignoring the assets manifest" << m_manifest_file << ":" << e.cause();
+        m_objects.clear();
+        m_folders.clear();
+    }
+}
+
+void AssetsManifest::checkFolder(const QString& prefix)
+{
+    if (m_checked.contains(prefix))
+        return;
+    m_checked.insert(prefix);
+
+    auto path = folderPath(prefix);
+    auto modified = modifiedTime(path);
+    // -1 is for a folder that doesn't exist
+    if (m_folders.value(prefix, -2) == modified)
+        return;
+
+    QHash<QString, QFileInfo> files;
+    for (auto& info : QDir(path).entryInfoList(QDir::Files))
+        files.insert(info.fileName(), info);
+    auto& objects = m_objects[prefix];
+    for (auto it = objects.begin(); it != objects.end();) {
+        auto file = files.constFind(it.key());
+        if (file == files.constEnd() || file->size() != it->size) {
+            it = objects.erase(it);
+            continue;
+        }
+        // a file written since it was recorded is hashed again, and removed to be downloaded again if it doesn't match
+        auto modified = file->lastModified().toMSecsSinceEpoch();
+        if (modified != it->modified) {
+            if (!matches(file->filePath(), it.key())) {
+                qWarning() << "Asset object" << it.key() << "was changed, removing it";
+                QFile::remove(file->filePath());
+                it = objects.erase(it);
+                continue;
+            }
+            it->modified = modified;
+        }
+        ++it;
+    }
+    m_folders.insert(prefix, modified);
+    m_dirty = true;
+}
+
+bool AssetsManifest::contains(const QString& hash, qint64 size)
+{
+    QMutexLocker locker(&m_lock);
+    load();
+    auto prefix = hash.left(2);
+    checkFolder(prefix);
+
+    auto& objects = m_objects[prefix];
+    auto it = objects.constFind(hash);
+    if (it != objects.constEnd())
+        return it->size == size;
+
+    // put there by something else, or from before the manifest
+    QFileInfo info(objectPath(hash));
+    if (!info.isFile() || info.size() != size)
+        return false;
+    objects.insert(hash, { size, info.lastModified().toMSecsSinceEpoch() });
+    m_dirty = true;
+    return true;
+}
+
+void AssetsManifest::add(const QString& hash, qint64 size)
+{
+    QMutexLocker locker(&m_lock);
+    load();
+    auto prefix = hash.left(2);
+    m_objects[prefix].insert(hash, { size, modifiedTime(objectPath(hash)) });
+    // the folder changed because of this object. changes from before were already picked up if it was looked at
+    if (m_checked.contains(prefix))
+        m_folders.insert(prefix, modifiedTime(folderPath(prefix)));
+    m_dirty = true;
+}
+
+void AssetsManifest::save()
+{
+    QJsonObject folders;
+    QJsonObject objects;
+    {
+        QMutexLocker locker(&m_lock);
+        if (!m_dirty)
+            return;
+        for (auto it = m_folders.cbegin(); it != m_folders.cend(); ++it)
+            folders.insert(it.key(), double(it.value()));
+        for (auto& folder : m_objects) {
+            for (auto it = folder.cbegin(); it != folder.cend(); ++it)
+                objects.insert(it.key(), QJsonArray{ double(it->size), double(it->modified) });
+        }
+        m_dirty = false;
+    }
+    try {
+        FS::ensureFilePathExists(m_manifest_file);
+        Json::write(QJsonObject{ { "version", manifestVersion }, { "folders", folders }, { "objects", objects } }, m_manifest_file);
+    } catch (const Exception& e) {
+        qWarning() << "Could not write the assets manifest" << m_manifest_file << ":" << e.cause();
+    }
+}
+
+AssetsManifest::Report AssetsManifest::verify()
+{
+    QHash<QString, QHash<QString, Object>> objects;
+    {
+        QMutexLocker locker(&m_lock);
+        load();
+        objects = m_objects;
+    }
+
+    // the hashing is done without the lock, launches can go on meanwhile
+    Report report;
+    QStringList broken;
+    for (auto& folder : objects) {
+        for (auto it = folder.cbegin(); it != folder.cend(); ++it) {
+            report.objects++;
+            auto path = objectPath(it.key());
+            if (QFileInfo(path).size() != it->size || !matches(path, it.key())) {
+                broken.append(it.key());
+            }
+        }
+    }
+    report.broken = broken.size();
+
+    QMutexLocker locker(&m_lock);
+    for (auto& hash : broken) {
+        qWarning() << "Asset object" << hash << "is broken, removing it";
+        QFile::remove(objectPath(hash));
+        m_objects[hash.left(2)].remove(hash);
+        m_dirty = true;
+    }
+    return report;
+}
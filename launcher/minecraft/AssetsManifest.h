@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+/* The asset objects known to be in place, shared by all instances.
+ *
+ * Every object that was downloaded and checked, or found with the right size, is recorded with its size and the
+ * modification time it had then, and the list is kept across sessions. Finding out whether an index is complete is
+ * then a lookup per object, instead of looking at every object file on each launch.
+ *
+ * To notice objects removed behind the launcher's back, the modification time of each objects/<xx> folder is kept too.
+ * The first time a folder is used in a session it is looked at, and only if it changed are its files looked at again.
+ * Then a file that is gone or has another size is forgotten, and one with another modification time is hashed again.
+ * A file rewritten in place leaves the folder as it was and isn't noticed this way, verify() hashes every object. */
+class AssetsManifest {
+   public:
+    struct Report {
+        int objects = 0;
+        // missing, or with the wrong size or hash. the ones still there were removed, to be downloaded again
+        int broken = 0;
+    };
+
+    AssetsManifest(QString objects_dir, QString manifest_file);
+
+    // whether the object with this hash and size is in place
+    bool contains(const QString& hash, qint64 size);
+    // records an object that was just downloaded and checked
+    void add(const QString& hash, qint64 size);
+
+    // writes the manifest out, if anything changed
+    void save();
+
+    // hashes all the objects known and forgets those that don't match. slow, it is meant to be run off the GUI thread
+    Report verify();
+
+   private:
+    struct Object {
+        qint64 size;
+        qint64 modified;
+    };
+
+    QString objectPath(const QString& hash) const;
+    QString folderPath(const QString& prefix) const;
+    void load();
+    // looks at the files of objects/<prefix> again if the folder changed since the last time
+    void checkFolder(const QString& prefix);
+    static qint64 modifiedTime(const QString& path);
+    // whether the SHA-1 of the file is hash
+    static bool matches(const QString& path, const QString& hash);
+
+    QString m_objects_dir;
+    QString m_manifest_file;
+
+    QMutex m_lock;
+    bool m_loaded = false;
+    bool m_dirty = false;
+    // by folder, then by hash
+    QHash<QString, QHash<QString, Object>> m_objects;
+    // modification time of each folder when its files were last looked at
+    QHash<QString, qint64> m_folders;
+    // folders looked at in this session
+    QSet<QString> m_checked;
+};
@@ -36,13 +36,14 @@
 #include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
-#include <QDirIterator>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
 #include <QVariant>
+#include <QtConcurrentMap>
 
+#include "AssetsManifest.h"
 #include "AssetsUtils.h"
 #include "BuildConfig.h"
 #include "FileSystem.h"
@@ -53,27 +54,22 @@
 #include "Application.h"
 #include "net/NetRequest.h"
 
-namespace {
-QSet<QString> collectPathsFromDir(QString dirPath)
-{
-    QFileInfo dirInfo(dirPath);
+#include <atomic>
 
-    if (!dirInfo.exists()) {
-        return {};
-    }
+namespace {
+// in a reconstructed virtual folder, the hash of the index it was made from
+const char* reconstructedStamp = ".reconstructed";
 
-    QSet<QString> out;
+enum class PlaceMode { Clone, Link, Copy };
 
-    QDirIterator iter(dirPath, QDirIterator::Subdirectories);
-    while (iter.hasNext()) {
-        QString value = iter.next();
-        QFileInfo info(value);
-        if (info.isFile()) {
-            out.insert(value);
-            qDebug() << value;
-        }
-    }
-    return out;
+bool placeObject(const QString& source, const QString& target, PlaceMode mode)
+{
+    std::error_code ec;
+    if (mode == PlaceMode::Clone && FS::clone_file(source, target, ec))
+        return true;
+    if (mode == PlaceMode::Link && FS::create_link(source, target).useHardLinks(true)())
+        return true;
+    return QFile::copy(source, target);
 }
 }  // namespace
 
@@ -213,12 +209,12 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
     QFile indexFile(indexPath);
     QDir virtualRoot(FS::PathCombine(virtualDir.path(), assetsId));
 
-    if (!indexFile.exists()) {
+    if (!indexFile.open(QIODevice::ReadOnly)) {
         qCritical() << "No assets index file" << indexPath << "; can't reconstruct assets!";
         return false;
     }
-
-    qDebug() << "reconstructAssets" << assetsDir.path() << indexDir.path() << objectDir.path() << virtualDir.path() << virtualRoot.path();
+    auto indexHash = QCryptographicHash::hash(indexFile.readAll(), QCryptographicHash::Sha1).toHex();
+    indexFile.close();
 
     AssetsIndex index;
     if (!AssetsUtils::loadAssetsIndexJson(assetsId, indexPath, index)) {
@@ -227,50 +223,77 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
     }
 
     QString targetPath;
-    bool removeLeftovers = false;
     if (index.isVirtual) {
         targetPath = virtualRoot.path();
-        removeLeftovers = true;
-        qDebug() << "Reconstructing virtual assets folder at" << targetPath;
     } else if (index.mapToResources) {
         targetPath = resourcesFolder;
-        qDebug() << "Reconstructing resources folder at" << targetPath;
     }
+    if (targetPath.isNull())
+        return true;
 
-    if (!targetPath.isNull()) {
-        auto presentFiles = collectPathsFromDir(targetPath);
-        for (QString map : index.objects.keys()) {
-            AssetObject asset_object = index.objects.value(map);
-            QString target_path = FS::PathCombine(targetPath, map);
-            QFile target(target_path);
-
-            QString tlk = asset_object.hash.left(2);
-
-            QString original_path = FS::PathCombine(objectDir.path(), tlk, asset_object.hash);
-            QFile original(original_path);
-            if (!original.exists())
-                continue;
-
-            presentFiles.remove(target_path);
-
-            if (!target.exists()) {
-                QFileInfo info(target_path);
-                QDir target_dir = info.dir();
-
-                qDebug() << target_dir.path();
-                FS::ensureFolderPathExists(target_dir.path());
-
-                bool couldCopy = original.copy(target_path);
-                qDebug() << " Copying" << original_path << "to" << target_path << QString::number(couldCopy);
-            }
+    // nothing to do if everything was put in place the last time, from the same index. only the virtual folder belongs to
+    // the launcher, the game and the player may change what is in the resources folder, so that is looked at every time
+    QString stampPath;
+    if (index.isVirtual) {
+        stampPath = FS::PathCombine(targetPath, reconstructedStamp);
+        QFile stamp(stampPath);
+        if (stamp.open(QIODevice::ReadOnly) && stamp.readAll().trimmed() == indexHash) {
+            qDebug() << "Assets at" << targetPath << "are already reconstructed";
+            return true;
         }
-
-        // TODO: Write last used time to virtualRoot/.lastused
-        if (removeLeftovers) {
-            for (auto& file : presentFiles) {
-                qDebug() << "Would remove" << file;
-            }
+    }
+    qDebug() << "Reconstructing assets" << assetsId << "at" << targetPath;
+
+    struct Placement {
+        QString source;
+        QString target;
+    };
+    QList<Placement> placements;
+    QSet<QString> folders;
+    for (auto it = index.objects.cbegin(); it != index.objects.cend(); ++it) {
+        auto source = FS::PathCombine(objectDir.path(), it->hash.left(2), it->hash);
+        auto target = FS::PathCombine(targetPath, it.key());
+        placements.append({ source, target });
+        folders.insert(QFileInfo(target).path());
+    }
+    // made up front, so the workers don't race each other creating the same parents
+    for (auto& folder : folders)
+        FS::ensureFolderPathExists(folder);
+
+    // deciding this looks at the filesystems, so it is done once and not for every file.
+    // links are only used for the virtual folder, the game may change what is in its resources folder
+    auto mode = PlaceMode::Copy;
+    if (FS::canClone(objectDir.path(), targetPath))
+        mode = PlaceMode::Clone;
+    else if (index.isVirtual && FS::canLink(objectDir.path(), targetPath))
+        mode = PlaceMode::Link;
+
+    std::atomic<int> missing = 0;
+    std::atomic<int> failed = 0;
+    QtConcurrent::blockingMap(placements, [mode, &missing, &failed](const Placement& placement) {
+        if (QFileInfo::exists(placement.target))
+            return;
+        if (!QFileInfo::exists(placement.source)) {
+            missing++;
+            return;
+        }
+        if (!placeObject(placement.source, placement.target, mode)) {
+            qWarning() << "Failed to place asset" << placement.source << "at" << placement.target;
+            failed++;
         }
+    });
+
+    if (missing || failed) {
+        qWarning() << "Reconstructed assets at" << targetPath << "with" << missing.load() << "objects missing and" << failed.load()
+                   << "that could not be placed";
+        return true;
+    }
+    if (stampPath.isNull())
+        return true;
+    try {
+        FS::write(stampPath, indexHash);
+    } catch (const Exception& e) {
+        qWarning() << "Could not write" << stampPath << ":" << e.cause();
     }
     return true;
 }
@@ -279,13 +302,15 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
 
 Net::NetRequest::Ptr AssetObject::getDownloadAction()
 {
-    QFileInfo objectFile(getLocalPath());
-    if ((!objectFile.isFile()) || (objectFile.size() != size)) {
-        auto objectDL = Net::ApiDownload::makeFile(getUrl(), objectFile.filePath());
+    auto manifest = APPLICATION->assetsManifest();
+    if (!manifest->contains(hash, size)) {
+        auto objectDL = Net::ApiDownload::makeFile(getUrl(), getLocalPath());
         if (hash.size()) {
             objectDL->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, hash));
         }
         objectDL->setProgress(objectDL->getProgress(), size);
+        objectDL->setExpectedSize(size);
+        QObject::connect(objectDL.get(), &Task::succeeded, [manifest, hash = hash, size = size] { manifest->add(hash, size); });
         return objectDL;
     }
     return nullptr;
@@ -315,7 +340,12 @@ NetJob::Ptr AssetsIndex::getDownloadJob()
             job->addNetAction(dl);
         }
     }
-    if (job->size())
+    auto manifest = APPLICATION->assetsManifest();
+    if (job->size()) {
+        QObject::connect(job.get(), &Task::finished, [manifest] { manifest->save(); });
         return job;
+    }
+    // objects found on disk without being in the manifest yet
+    manifest->save();
     return nullptr;
 }
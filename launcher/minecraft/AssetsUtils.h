@@ -46,5 +46,6 @@ bool loadAssetsIndexJson(const QString& id, const QString& file, AssetsIndex& in
 QDir getAssetsDir(const QString& assetsId, const QString& resourcesFolder);
 
 /// Reconstruct a virtual assets folder for the given assets ID and return the folder
+/// Skipped for a virtual folder that was completed from the same index before, see the .reconstructed stamp in it
 bool reconstructAssets(QString assetsId, QString resourcesFolder);
 }  // namespace AssetsUtils
@@ -40,6 +40,8 @@
 #include "Library.h"
 
 class LaunchProfile : public ProblemProvider {
+    friend class OneSixVersionFormat;
+
    public:
     virtual ~LaunchProfile() {}
 
@@ -108,7 +108,8 @@ void Library::getApplicableFiles(const RuntimeContext& runtimeContext,
 QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeContext,
                                                   class HttpMetaCache* cache,
                                                   QStringList& failedLocalFiles,
-                                                  const QString& overridePath) const
+                                                  const QString& overridePath,
+                                                  const QHash<QString, MetaEntryPtr>& resolved) const
 {
     QList<Net::NetRequest::Ptr> out;
     bool stale = isAlwaysStale();
@@ -128,11 +129,14 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
     };
 
     // Lambda function to add a download request
-    auto add_download = [this, local, check_local_file, cache, stale, &out](QString storage, QString url, QString sha1) {
+    auto add_download = [this, local, check_local_file, cache, stale, &resolved, &out](QString storage, QString url, QString sha1) {
         if (local) {
             return check_local_file(storage);
         }
-        auto entry = cache->resolveEntry("libraries", storage);
+        auto entry = resolved.value(storage);
+        if (!entry) {
+            entry = cache->resolveEntry("libraries", storage);
+        }
         if (stale) {
             entry->setStale(true);
         }
@@ -158,6 +162,38 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
         return true;
     };
 
+    forEachArtifact(runtimeContext, add_download);
+    return out;
+}
+
+/**
+ * @brief Get the metacache paths of the library files.
+ *
+ * These are the paths getDownloads resolves in the "libraries" cache base, so they can be
+ * resolved for many libraries in one batch beforehand. Local libraries are not cached and have none.
+ *
+ * @param runtimeContext The current runtime context.
+ * @return QStringList Paths relative to the "libraries" cache base.
+ */
+QStringList Library::getCacheStorages(const RuntimeContext& runtimeContext) const
+{
+    QStringList out;
+    if (isLocal() || isAlwaysStale()) {
+        return out;
+    }
+    forEachArtifact(runtimeContext, [&out](QString storage, QString, QString) { out.append(storage); });
+    return out;
+}
+
+/**
+ * @brief Call a function for every file of the library that applies to the runtime context.
+ *
+ * @param runtimeContext The current runtime context.
+ * @param visit Called with the storage path, download URL and SHA-1 (if known) of each file.
+ */
+void Library::forEachArtifact(const RuntimeContext& runtimeContext,
+                              const std::function<void(QString storage, QString url, QString sha1)>& visit) const
+{
     QString raw_storage = storageSuffix(runtimeContext);
     if (m_mojangDownloads) {
         if (isNative()) {
@@ -172,18 +208,18 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
                     if (nat32info) {
                         auto cooked_storage = raw_storage;
                         cooked_storage.replace("${arch}", "32");
-                        add_download(cooked_storage, nat32info->url, nat32info->sha1);
+                        visit(cooked_storage, nat32info->url, nat32info->sha1);
                     }
                     auto nat64info = m_mojangDownloads->getDownloadInfo(nat64Classifier);
                     if (nat64info) {
                         auto cooked_storage = raw_storage;
                         cooked_storage.replace("${arch}", "64");
-                        add_download(cooked_storage, nat64info->url, nat64info->sha1);
+                        visit(cooked_storage, nat64info->url, nat64info->sha1);
                     }
                 } else {
                     auto info = m_mojangDownloads->getDownloadInfo(nativeClassifier);
                     if (info) {
-                        add_download(raw_storage, info->url, info->sha1);
+                        visit(raw_storage, info->url, info->sha1);
                     }
                 }
             } else {
@@ -192,7 +228,7 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
         } else {
             if (m_mojangDownloads->artifact) {
                 auto artifact = m_mojangDownloads->artifact;
-                add_download(raw_storage, artifact->url, artifact->sha1);
+                visit(raw_storage, artifact->url, artifact->sha1);
             } else {
                 qDebug() << "Ignoring java library" << m_name.serialize() << "because it has no artifact";
             }
@@ -216,15 +252,14 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
         if (raw_storage.contains("${arch}")) {
             QString cooked_storage = raw_storage;
             QString cooked_dl = raw_dl;
-            add_download(cooked_storage.replace("${arch}", "32"), cooked_dl.replace("${arch}", "32"), QString());
+            visit(cooked_storage.replace("${arch}", "32"), cooked_dl.replace("${arch}", "32"), QString());
             cooked_storage = raw_storage;
             cooked_dl = raw_dl;
-            add_download(cooked_storage.replace("${arch}", "64"), cooked_dl.replace("${arch}", "64"), QString());
+            visit(cooked_storage.replace("${arch}", "64"), cooked_dl.replace("${arch}", "64"), QString());
         } else {
-            add_download(raw_storage, raw_dl, QString());
+            visit(raw_storage, raw_dl, QString());
         }
     }
-    return out;
 }
 
 /**
@@ -35,18 +35,21 @@
 
 #pragma once
 #include <QDir>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QPair>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <functional>
 #include <memory>
 
 #include "GradleSpecifier.h"
 #include "MojangDownloadInfo.h"
 #include "Rule.h"
 #include "RuntimeContext.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetRequest.h"
 
 class Library;
@@ -143,11 +146,15 @@ class Library {
     /// Return true if the library requires forge XZ hacks
     bool isForge() const;
 
-    // Get a list of downloads for this library
+    // Get a list of downloads for this library. entries already resolved, by storage path, are used instead of resolving them again
     QList<Net::NetRequest::Ptr> getDownloads(const RuntimeContext& runtimeContext,
                                              class HttpMetaCache* cache,
                                              QStringList& failedLocalFiles,
-                                             const QString& overridePath) const;
+                                             const QString& overridePath,
+                                             const QHash<QString, MetaEntryPtr>& resolved = {}) const;
+
+    // Get the paths of this library's files in the "libraries" cache base
+    QStringList getCacheStorages(const RuntimeContext& runtimeContext) const;
 
     QString getCompatibleNative(const RuntimeContext& runtimeContext) const;
 
@@ -155,6 +162,10 @@ class Library {
     /// the default storage prefix used by Prism Launcher
     static QString defaultStoragePrefix();
 
+    /// call visit for every file of the library that applies to the runtime context
+    void forEachArtifact(const RuntimeContext& runtimeContext,
+                         const std::function<void(QString storage, QString url, QString sha1)>& visit) const;
+
     /// Get the prefix - root of the storage to be used
     QString storagePrefix() const;
 
@@ -0,0 +1,133 @@
+#include "LogLevelClassifier.h"
+
+std::shared_ptr<const LogLevelClassifier> LogLevelClassifier::minecraft()
+{
+    static const auto classifier = [] {
+        std::shared_ptr<LogLevelClassifier> classifier(new LogLevelClassifier);
+        classifier->addLevelName("INFO", MessageLevel::Message);
+        classifier->addLevelName("WARN", MessageLevel::Warning);
+        classifier->addLevelName("ERROR", MessageLevel::Error);
+        classifier->addLevelName("FATAL", MessageLevel::Fatal);
+        classifier->addLevelName("TRACE", MessageLevel::Debug);
+        classifier->addLevelName("DEBUG", MessageLevel::Debug);
+
+        // old style forge logs
+        for (auto tag : { "INFO", "CONFIG", "FINE", "FINER", "FINEST" })
+            classifier->addTag(tag, MessageLevel::Message);
+        classifier->addTag("SEVERE", MessageLevel::Error);
+        classifier->addTag("STDERR", MessageLevel::Error);
+        classifier->addTag("WARNING", MessageLevel::Warning);
+        classifier->addTag("DEBUG", MessageLevel::Debug);
+
+        classifier->addFatalText("overwriting existing");
+
+        // NOTE: this diverges from the real regexp. no unicode, the first section is + instead of *
+        static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
+        classifier->addErrorPattern("Exception in thread", { "Exception in thread" });
+        classifier->addErrorPattern("\\s+at " + javaSymbol, { "at " });
+        classifier->addErrorPattern("Caused by: " + javaSymbol, { "Caused by: " });
+        classifier->addErrorPattern("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)",
+                                    { "Exception", "Error", "Throwable" });
+        classifier->addErrorPattern("... \\d+ more$", { " more" });
+        return classifier;
+    }();
+    return classifier;
+}
+
+void LogLevelClassifier::addLevelName(const QString& name, MessageLevel::Enum level)
+{
+    m_level_names.append({ name, level });
+}
+
+void LogLevelClassifier::addTag(const QString& tag, MessageLevel::Enum level)
+{
+    m_tags.append({ tag, level });
+}
+
+void LogLevelClassifier::addFatalText(const QString& text)
+{
+    m_fatal_texts.append(text);
+}
+
+void LogLevelClassifier::addErrorPattern(const QString& pattern, const QStringList& hints)
+{
+    m_error_patterns.append("(?:" + pattern + ")");
+    for (auto& hint : hints)
+        if (!m_error_hints.contains(hint))
+            m_error_hints.append(hint);
+
+    m_errors.setPattern(m_error_patterns.join('|'));
+    m_errors.optimize();
+}
+
+QStringView LogLevelClassifier::log4jLevel(const QString& line)
+{
+    // same as \[[0-9:]+\] \[[^/]+/([^\]]+)\] anywhere in the line
+    const auto size = line.size();
+    for (auto start = line.indexOf('['); start != -1; start = line.indexOf('[', start + 1)) {
+        auto i = start + 1;
+        while (i < size && ((line[i] >= '0' && line[i] <= '9') || line[i] == ':'))
+            i++;
+        if (i == start + 1 || !QStringView(line).mid(i).startsWith(QLatin1String("] [")))
+            continue;
+        auto thread = i + 3;
+        auto slash = line.indexOf('/', thread);
+        if (slash <= thread)
+            continue;
+        auto end = line.indexOf(']', slash + 1);
+        if (end <= slash + 1)
+            continue;
+        return QStringView(line).mid(slash + 1, end - slash - 1);
+    }
+    return {};
+}
+
+MessageLevel::Enum LogLevelClassifier::tagLevel(const QString& line, MessageLevel::Enum level) const
+{
+    int best = -1;
+    for (auto start = line.indexOf('['); start != -1; start = line.indexOf('[', start + 1)) {
+        auto end = line.indexOf(']', start + 1);
+        if (end == -1)
+            break;
+        auto tag = QStringView(line).mid(start + 1, end - start - 1);
+        for (int i = m_tags.size() - 1; i > best; i--) {
+            if (m_tags[i].first == tag) {
+                best = i;
+                break;
+            }
+        }
+    }
+    return best == -1 ? level : m_tags[best].second;
+}
+
+bool LogLevelClassifier::isError(const QString& line) const
+{
+    if (m_error_patterns.isEmpty())
+        return false;
+    for (auto& hint : m_error_hints)
+        if (line.contains(hint))
+            return m_errors.match(line).hasMatch();
+    return false;
+}
+
+MessageLevel::Enum LogLevelClassifier::classify(const QString& line, MessageLevel::Enum level) const
+{
+    auto levelName = log4jLevel(line);
+    if (!levelName.isNull()) {
+        for (auto& [name, nameLevel] : m_level_names) {
+            if (name == levelName) {
+                level = nameLevel;
+                break;
+            }
+        }
+    } else {
+        level = tagLevel(line, level);
+    }
+
+    for (auto& text : m_fatal_texts)
+        if (line.contains(text))
+            return MessageLevel::Fatal;
+    if (isError(line))
+        return MessageLevel::Error;
+    return level;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QList>
+#include <QPair>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+#include "MessageLevel.h"
+
+/* Guesses the level of a line of game output that didn't come with one.
+ *
+ * Every line the game prints goes through this, so everything is prepared up front: the log4j header
+ * ("[12:34:56] [main/INFO]") is read by hand instead of with a regular expression, and the stack trace rules
+ * are compiled into a single pattern that only runs on lines containing one of their literal hints. */
+class LogLevelClassifier {
+   public:
+    // the rules for vanilla and the usual loaders, built once
+    static std::shared_ptr<const LogLevelClassifier> minecraft();
+
+    MessageLevel::Enum classify(const QString& line, MessageLevel::Enum level) const;
+
+   private:
+    LogLevelClassifier() = default;
+
+    // the level of a line with a log4j header carrying this level name
+    void addLevelName(const QString& name, MessageLevel::Enum level);
+    // a level written as [tag] in a line without a log4j header. when several match, the one added last wins
+    void addTag(const QString& tag, MessageLevel::Enum level);
+    // lines containing this are fatal, whatever their header says
+    void addFatalText(const QString& text);
+    // lines matching this are errors, whatever their header says. the pattern is only tried on lines containing one of hints
+    void addErrorPattern(const QString& pattern, const QStringList& hints);
+
+    // the level part of the first log4j header in line, or a null string
+    static QStringView log4jLevel(const QString& line);
+    MessageLevel::Enum tagLevel(const QString& line, MessageLevel::Enum level) const;
+    bool isError(const QString& line) const;
+
+    QList<QPair<QString, MessageLevel::Enum>> m_level_names;
+    QList<QPair<QString, MessageLevel::Enum>> m_tags;
+    QStringList m_fatal_texts;
+
+    QStringList m_error_patterns;
+    QStringList m_error_hints;
+    QRegularExpression m_errors;
+};
@@ -52,6 +52,7 @@
 #include "FileSystem.h"
 #include "MMCTime.h"
 #include "java/JavaVersion.h"
+#include "minecraft/LogLevelClassifier.h"
 #include "pathmatcher/MultiMatcher.h"
 #include "pathmatcher/RegexpMatcher.h"
 
@@ -65,6 +66,7 @@
 #include "launch/steps/TextPrint.h"
 
 #include "minecraft/launch/ClaimAccount.h"
+#include "minecraft/launch/CheckLaunchFingerprint.h"
 #include "minecraft/launch/LauncherPartLaunch.h"
 #include "minecraft/launch/ModMinecraftJar.h"
 #include "minecraft/launch/ReconstructAssets.h"
@@ -1013,44 +1015,8 @@ QMap<QString, QString> MinecraftInstance::createCensorFilterFromSession(AuthSess
 
 MessageLevel::Enum MinecraftInstance::guessLevel(const QString& line, MessageLevel::Enum level)
 {
-    QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
-    auto match = re.match(line);
-    if (match.hasMatch()) {
-        // New style logs from log4j
-        QString timestamp = match.captured("timestamp");
-        QString levelStr = match.captured("level");
-        if (levelStr == "INFO")
-            level = MessageLevel::Message;
-        if (levelStr == "WARN")
-            level = MessageLevel::Warning;
-        if (levelStr == "ERROR")
-            level = MessageLevel::Error;
-        if (levelStr == "FATAL")
-            level = MessageLevel::Fatal;
-        if (levelStr == "TRACE" || levelStr == "DEBUG")
-            level = MessageLevel::Debug;
-    } else {
-        // Old style forge logs
-        if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") || line.contains("[FINER]") ||
-            line.contains("[FINEST]"))
-            level = MessageLevel::Message;
-        if (line.contains("[SEVERE]") || line.contains("[STDERR]"))
-            level = MessageLevel::Error;
-        if (line.contains("[WARNING]"))
-            level = MessageLevel::Warning;
-        if (line.contains("[DEBUG]"))
-            level = MessageLevel::Debug;
-    }
-    if (line.contains("overwriting existing"))
-        return MessageLevel::Fatal;
-    // NOTE: this diverges from the real regexp. no unicode, the first section is + instead of *
-    static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
-    if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at " + javaSymbol)) ||
-        line.contains(QRegularExpression("Caused by: " + javaSymbol)) ||
-        line.contains(QRegularExpression("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)")) ||
-        line.contains(QRegularExpression("... \\d+ more$")))
-        return MessageLevel::Error;
-    return level;
+    static const auto classifier = LogLevelClassifier::minecraft();
+    return classifier->classify(line, level);
 }
 
 IPathMatcher::Ptr MinecraftInstance::getLogFileMatcher()
@@ -1158,10 +1124,28 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
         process->appendStep(step);
     }
 
+    // nothing to update if none of what the last launch used changed since. the metadata is then only read from disk
+    bool online = session->status != AuthSession::PlayableOffline;
+    std::function<bool()> upToDate;
+    if (online) {
+        auto check = makeShared<CheckLaunchFingerprint>(pptr, this);
+        process->appendStep(check);
+        upToDate = [check] { return check->upToDate(); };
+    }
+
+    // wrapped tasks don't know what they work on, it is declared for them so they can run next to the other steps
+    auto appendTask = [&](Task::Ptr task, LaunchStep::Resources reads, LaunchStep::Resources writes, std::function<bool()> skip = {}) {
+        auto step = makeShared<TaskStepWrapper>(pptr, task);
+        step->declare(reads, writes);
+        step->skipIf(skip);
+        process->appendStep(step);
+    };
+
     // load meta
     {
-        auto mode = session->status != AuthSession::PlayableOffline ? Net::Mode::Online : Net::Mode::Offline;
-        process->appendStep(makeShared<TaskStepWrapper>(pptr, makeShared<MinecraftLoadAndCheck>(this, mode)));
+        auto load = makeShared<MinecraftLoadAndCheck>(this, online ? Net::Mode::Online : Net::Mode::Offline);
+        load->offlineIf(upToDate);
+        appendTask(load, {}, LaunchStep::Components);
     }
 
     // check java
@@ -1178,13 +1162,15 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
     }
 
     // if we aren't in offline mode,.
-    if (session->status != AuthSession::PlayableOffline) {
+    if (online) {
         if (!session->demo) {
             process->appendStep(makeShared<ClaimAccount>(pptr, session));
         }
-        for (auto t : createUpdateTask()) {
-            process->appendStep(makeShared<TaskStepWrapper>(pptr, t));
-        }
+        // the same tasks as createUpdateTask()
+        appendTask(makeShared<FoldersTask>(this), {}, LaunchStep::GameFolder, upToDate);
+        appendTask(makeShared<LibrariesTask>(this), LaunchStep::Components | LaunchStep::Java, LaunchStep::Libraries, upToDate);
+        appendTask(makeShared<FMLLibrariesTask>(this), LaunchStep::Components, LaunchStep::Libraries, upToDate);
+        appendTask(makeShared<AssetUpdateTask>(this), LaunchStep::Components, LaunchStep::Assets, upToDate);
     }
 
     // if there are any jar mods
@@ -1223,6 +1209,8 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
         step->setWorkingDirectory(gameRoot());
         step->setAuthSession(session);
         step->setTargetToJoin(targetToJoin);
+        // only a launch that went through the update makes the fingerprint last another day
+        step->setUpdated([upToDate] { return upToDate && !upToDate(); });
         process->appendStep(step);
     }
 
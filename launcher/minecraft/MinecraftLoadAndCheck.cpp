@@ -8,7 +8,8 @@ void MinecraftLoadAndCheck::executeTask()
 {
     // add offline metadata load task
     auto components = m_inst->getPackProfile();
-    if (auto result = components->reload(m_netmode); !result) {
+    auto mode = m_offline && m_offline() ? Net::Mode::Offline : m_netmode;
+    if (auto result = components->reload(mode); !result) {
         emitFailed(result.error);
         return;
     }
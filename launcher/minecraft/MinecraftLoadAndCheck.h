@@ -18,6 +18,8 @@
 #include "net/Mode.h"
 #include "tasks/Task.h"
 
+#include <functional>
+
 class MinecraftInstance;
 
 class MinecraftLoadAndCheck : public Task {
@@ -28,6 +30,9 @@ class MinecraftLoadAndCheck : public Task {
     void executeTask() override;
 
     bool canAbort() const override;
+
+    // the metadata is only read from disk if this is true once the task starts
+    void offlineIf(std::function<bool()> offline) { m_offline = std::move(offline); }
    public slots:
     bool abort() override;
 
@@ -35,4 +40,5 @@ class MinecraftLoadAndCheck : public Task {
     MinecraftInstance* m_inst = nullptr;
     Task::Ptr m_task;
     Net::Mode m_netmode;
+    std::function<bool()> m_offline;
 };
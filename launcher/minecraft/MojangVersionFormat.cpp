@@ -44,10 +44,8 @@ using namespace Json;
 
 static const int CURRENT_MINIMUM_LAUNCHER_VERSION = 18;
 
-static MojangAssetIndexInfo::Ptr assetIndexFromJson(const QJsonObject& obj);
 static MojangDownloadInfo::Ptr downloadInfoFromJson(const QJsonObject& obj);
 static MojangLibraryDownloadInfo::Ptr libDownloadInfoFromJson(const QJsonObject& libObj);
-static QJsonObject assetIndexToJson(MojangAssetIndexInfo::Ptr assetidxinfo);
 static QJsonObject libDownloadInfoToJson(MojangLibraryDownloadInfo::Ptr libinfo);
 static QJsonObject downloadInfoToJson(MojangDownloadInfo::Ptr info);
 
@@ -84,7 +82,7 @@ MojangDownloadInfo::Ptr downloadInfoFromJson(const QJsonObject& obj)
     return out;
 }
 
-MojangAssetIndexInfo::Ptr assetIndexFromJson(const QJsonObject& obj)
+MojangAssetIndexInfo::Ptr MojangVersionFormat::assetIndexFromJson(const QJsonObject& obj)
 {
     auto out = std::make_shared<MojangAssetIndexInfo>();
     Bits::readDownloadInfo(out, obj);
@@ -138,7 +136,7 @@ QJsonObject libDownloadInfoToJson(MojangLibraryDownloadInfo::Ptr libinfo)
     return out;
 }
 
-QJsonObject assetIndexToJson(MojangAssetIndexInfo::Ptr info)
+QJsonObject MojangVersionFormat::assetIndexToJson(MojangAssetIndexInfo::Ptr info)
 {
     QJsonObject out;
     if (!info->path.isNull()) {
@@ -14,6 +14,9 @@ class MojangVersionFormat {
     // does not include libraries
     static void writeVersionProperties(const VersionFile* in, QJsonObject& out);
 
+    static MojangAssetIndexInfo::Ptr assetIndexFromJson(const QJsonObject& obj);
+    static QJsonObject assetIndexToJson(MojangAssetIndexInfo::Ptr info);
+
    public:
     // version files / profile patches
     static VersionFilePtr versionFileFromJson(const QJsonDocument& doc, const QString& filename);
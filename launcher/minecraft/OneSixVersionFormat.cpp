@@ -412,3 +412,110 @@ QJsonObject OneSixVersionFormat::modtoJson(Library* jarmod)
 {
     return libraryToJson(jarmod);
 }
+
+namespace {
+QJsonArray librariesToJson(const QList<LibraryPtr>& libraries)
+{
+    QJsonArray array;
+    for (auto& library : libraries) {
+        array.append(OneSixVersionFormat::libraryToJson(library.get()));
+    }
+    return array;
+}
+
+QStringList stringsFromJson(const QJsonObject& root, const QString& key)
+{
+    QStringList out;
+    for (auto value : ensureArray(root, key)) {
+        out.append(requireString(value));
+    }
+    return out;
+}
+
+QList<LibraryPtr> librariesFromJson(ProblemContainer& problems, const QJsonObject& root, const QString& key)
+{
+    QList<LibraryPtr> out;
+    for (auto libVal : ensureArray(root, key)) {
+        out.append(OneSixVersionFormat::libraryFromJson(problems, requireObject(libVal), "launch profile"));
+    }
+    return out;
+}
+}  // namespace
+
+std::shared_ptr<LaunchProfile> OneSixVersionFormat::launchProfileFromJson(const QJsonObject& root)
+{
+    auto out = std::make_shared<LaunchProfile>();
+    ProblemContainer problems;
+    readString(root, "minecraftVersion", out->m_minecraftVersion);
+    readString(root, "type", out->m_minecraftVersionType);
+    if (root.contains("assetIndex")) {
+        out->m_minecraftAssets = MojangVersionFormat::assetIndexFromJson(requireObject(root, "assetIndex"));
+    }
+    readString(root, "minecraftArguments", out->m_minecraftArguments);
+    out->m_addnJvmArguments = stringsFromJson(root, "jvmArgs");
+    out->m_tweakers = stringsFromJson(root, "tweakers");
+    readString(root, "mainClass", out->m_mainClass);
+    readString(root, "appletClass", out->m_appletClass);
+    out->m_libraries = librariesFromJson(problems, root, "libraries");
+    out->m_nativeLibraries = librariesFromJson(problems, root, "nativeLibraries");
+    out->m_mavenFiles = librariesFromJson(problems, root, "mavenFiles");
+    for (auto agentVal : ensureArray(root, "agents")) {
+        auto agentObj = requireObject(agentVal);
+        auto lib = libraryFromJson(problems, agentObj, "launch profile");
+        out->m_agents.append(std::make_shared<Agent>(lib, ensureString(agentObj, "argument", QString())));
+    }
+    if (root.contains("mainJar")) {
+        out->m_mainJar = libraryFromJson(problems, requireObject(root, "mainJar"), "launch profile");
+    }
+    for (auto& trait : stringsFromJson(root, "traits")) {
+        out->m_traits.insert(trait);
+    }
+    out->m_jarMods = librariesFromJson(problems, root, "jarMods");
+    out->m_mods = librariesFromJson(problems, root, "mods");
+    for (auto major : ensureArray(root, "compatibleJavaMajors")) {
+        out->m_compatibleJavaMajors.append(requireInteger(major));
+    }
+    readString(root, "compatibleJavaName", out->m_compatibleJavaName);
+    out->m_problemSeverity = static_cast<ProblemSeverity>(ensureInteger(root, "problemSeverity", 0));
+    return out;
+}
+
+QJsonObject OneSixVersionFormat::launchProfileToJson(const LaunchProfile* profile)
+{
+    QJsonObject root;
+    writeString(root, "minecraftVersion", profile->m_minecraftVersion);
+    writeString(root, "type", profile->m_minecraftVersionType);
+    if (profile->m_minecraftAssets) {
+        root.insert("assetIndex", MojangVersionFormat::assetIndexToJson(profile->m_minecraftAssets));
+    }
+    writeString(root, "minecraftArguments", profile->m_minecraftArguments);
+    writeStringList(root, "jvmArgs", profile->m_addnJvmArguments);
+    writeStringList(root, "tweakers", profile->m_tweakers);
+    writeString(root, "mainClass", profile->m_mainClass);
+    writeString(root, "appletClass", profile->m_appletClass);
+    root.insert("libraries", librariesToJson(profile->m_libraries));
+    root.insert("nativeLibraries", librariesToJson(profile->m_nativeLibraries));
+    root.insert("mavenFiles", librariesToJson(profile->m_mavenFiles));
+    QJsonArray agents;
+    for (auto& agent : profile->m_agents) {
+        QJsonObject agentOut = libraryToJson(agent->library().get());
+        if (!agent->argument().isEmpty())
+            agentOut.insert("argument", agent->argument());
+        agents.append(agentOut);
+    }
+    root.insert("agents", agents);
+    if (profile->m_mainJar) {
+        root.insert("mainJar", libraryToJson(profile->m_mainJar.get()));
+    }
+    writeStringList(root, "traits", profile->m_traits.values());
+    root.insert("jarMods", librariesToJson(profile->m_jarMods));
+    root.insert("mods", librariesToJson(profile->m_mods));
+    QJsonArray majors;
+    for (auto major : profile->m_compatibleJavaMajors) {
+        majors.append(major);
+    }
+    root.insert("compatibleJavaMajors", majors);
+    writeString(root, "compatibleJavaName", profile->m_compatibleJavaName);
+    root.insert("problemSeverity", static_cast<int>(profile->m_problemSeverity));
+    return root;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ProblemProvider.h>
+#include <minecraft/LaunchProfile.h>
 #include <minecraft/Library.h>
 #include <minecraft/PackProfile.h>
 #include <minecraft/VersionFile.h>
@@ -29,4 +30,8 @@ class OneSixVersionFormat {
     // mods, also derived from libraries
     static LibraryPtr modFromJson(ProblemContainer& problems, const QJsonObject& libObj, const QString& filename);
     static QJsonObject modtoJson(Library* jarmod);
+
+    // resolved launch profiles, as cached by PackProfile. the libraries in them already passed their rules
+    static std::shared_ptr<LaunchProfile> launchProfileFromJson(const QJsonObject& root);
+    static QJsonObject launchProfileToJson(const LaunchProfile* profile);
 };
@@ -43,6 +43,7 @@
 #include <QDebug>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QSaveFile>
@@ -57,6 +58,7 @@
 #include "Json.h"
 #include "meta/Index.h"
 #include "meta/JsonFormat.h"
+#include "meta/Version.h"
 #include "minecraft/Component.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/OneSixVersionFormat.h"
@@ -71,6 +73,36 @@
 
 #include "ui/dialogs/CustomMessageBox.h"
 
+namespace {
+// bumped when what goes into a profile, or the way it is written, changes
+const int profileCacheVersion = 1;
+
+std::shared_ptr<LaunchProfile> loadCachedProfile(const QString& file, const QString& key)
+{
+    if (!QFileInfo::exists(file))
+        return nullptr;
+    try {
+        auto root = Json::requireObject(Json::requireDocument(file, "launch profile cache"));
+        if (Json::ensureString(root, "key") != key)
+            return nullptr;
+        return OneSixVersionFormat::launchProfileFromJson(Json::requireObject(root, "profile"));
+    } catch (const Exception& e) {
+        qCWarning(instanceProfileC) << "Ignoring the cached launch profile" << file << ":" << e.cause();
+        return nullptr;
+    }
+}
+
+void saveCachedProfile(const QString& file, const QString& key, const LaunchProfile* profile)
+{
+    try {
+        FS::ensureFilePathExists(file);
+        Json::write(QJsonObject{ { "key", key }, { "profile", OneSixVersionFormat::launchProfileToJson(profile) } }, file);
+    } catch (const Exception& e) {
+        qCWarning(instanceProfileC) << "Could not write the launch profile cache" << file << ":" << e.cause();
+    }
+}
+}  // namespace
+
 PackProfile::PackProfile(MinecraftInstance* instance) : QAbstractListModel()
 {
     d.reset(new PackProfileData);
@@ -948,9 +980,50 @@ bool PackProfile::installAgents_internal(QStringList filepaths)
     return true;
 }
 
+QString PackProfile::profileCacheFilePath() const
+{
+    return QDir("cache/profiles").absoluteFilePath(d->m_instance->id() + ".json");
+}
+
+QString PackProfile::profileCacheKey() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto context = d->m_instance->runtimeContext();
+    hash.addData(QString("%1|%2|%3|%4\n")
+                     .arg(profileCacheVersion)
+                     .arg(context.javaArchitecture, context.javaRealArchitecture, context.system)
+                     .toUtf8());
+    for (auto component : d->components) {
+        // disabled components are not applied
+        if (!component->isEnabled())
+            continue;
+        QString path;
+        if (component->isCustom()) {
+            path = component->getFilename();
+        } else if (auto meta = component->getMeta(); meta && meta->isLoaded()) {
+            path = QDir("meta").absoluteFilePath(meta->localFilename());
+        }
+        QFile file(path);
+        if (path.isEmpty() || !file.open(QIODevice::ReadOnly))
+            return {};
+        hash.addData(QString("%1|%2\n").arg(component->getID(), component->getVersion()).toUtf8());
+        hash.addData(&file);
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
 std::shared_ptr<LaunchProfile> PackProfile::getProfile() const
 {
     if (!d->m_profile) {
+        // applying every component again is only needed when something they are made from changed
+        auto cacheFile = profileCacheFilePath();
+        auto key = profileCacheKey();
+        if (!key.isEmpty())
+            d->m_profile = loadCachedProfile(cacheFile, key);
+        if (d->m_profile) {
+            qCDebug(instanceProfileC) << d->m_instance->name() << "|" << "Using the cached launch profile";
+            return d->m_profile;
+        }
         try {
             auto profile = std::make_shared<LaunchProfile>();
             for (auto file : d->components) {
@@ -959,6 +1032,8 @@ std::shared_ptr<LaunchProfile> PackProfile::getProfile() const
                 file->applyTo(profile.get());
             }
             d->m_profile = profile;
+            if (!key.isEmpty())
+                saveCachedProfile(cacheFile, key, profile.get());
         } catch (const Exception& error) {
             qCWarning(instanceProfileC) << d->m_instance->name() << "|" << "Couldn't apply profile patches because: " << error.cause();
         }
@@ -174,6 +174,11 @@ class PackProfile : public QAbstractListModel {
     QString componentsFilePath() const;
     QString patchesPattern() const;
 
+    /// where the applied profile is kept between sessions
+    QString profileCacheFilePath() const;
+    /// identifies what the profile is made from. empty if some component can't be told apart, and the profile isn't cached
+    QString profileCacheKey() const;
+
    private slots:
     void save_internal();
     void updateSucceeded();
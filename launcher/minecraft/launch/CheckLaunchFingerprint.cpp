@@ -0,0 +1,22 @@
+#include "CheckLaunchFingerprint.h"
+
+#include <QtConcurrentRun>
+
+CheckLaunchFingerprint::CheckLaunchFingerprint(LaunchTask* parent, MinecraftInstance* instance)
+    : LaunchStep(parent), m_fingerprint(instance)
+{
+    // before everything that loads or updates what the fingerprint covers
+    declare(Components | GameFolder | Libraries | Assets, {});
+}
+
+void CheckLaunchFingerprint::executeTask()
+{
+    connect(&m_watcher, &QFutureWatcher<bool>::finished, this, [this] {
+        m_upToDate = m_watcher.result();
+        if (m_upToDate) {
+            emit logLine("Nothing changed since the last launch, skipping the update.\n", MessageLevel::Launcher);
+        }
+        emitSucceeded();
+    });
+    m_watcher.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [fingerprint = m_fingerprint] { return fingerprint.matches(); }));
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QFutureWatcher>
+
+#include <launch/LaunchStep.h>
+
+#include "minecraft/launch/LaunchFingerprint.h"
+
+// Finds out in the background whether anything the last launch used changed since, see LaunchFingerprint
+class CheckLaunchFingerprint : public LaunchStep {
+    Q_OBJECT
+   public:
+    explicit CheckLaunchFingerprint(LaunchTask* parent, MinecraftInstance* instance);
+    virtual ~CheckLaunchFingerprint() = default;
+
+    void executeTask() override;
+    bool canAbort() const override { return false; }
+
+    // whether the update can be skipped, once the step is done
+    bool upToDate() const { return m_upToDate; }
+
+   private:
+    LaunchFingerprint m_fingerprint;
+    bool m_upToDate = false;
+    QFutureWatcher<bool> m_watcher;
+};
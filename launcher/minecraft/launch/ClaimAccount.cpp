@@ -6,6 +6,7 @@
 
 ClaimAccount::ClaimAccount(LaunchTask* parent, AuthSessionPtr session) : LaunchStep(parent)
 {
+    declare({}, Account);
     if (session->status == AuthSession::Status::PlayableOnline && !session->demo) {
         auto accounts = APPLICATION->accounts();
         m_account = accounts->getAccountByProfileName(session->player_name);
@@ -3,7 +3,10 @@
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 
-CreateGameFolders::CreateGameFolders(LaunchTask* parent) : LaunchStep(parent) {}
+CreateGameFolders::CreateGameFolders(LaunchTask* parent) : LaunchStep(parent)
+{
+    declare({}, GameFolder);
+}
 
 void CreateGameFolders::executeTask()
 {
@@ -20,8 +20,12 @@
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTemporaryDir>
 #include "FileSystem.h"
 #include "MMCZip.h"
+#include "modplatform/helpers/HashUtils.h"
 
 #ifdef major
 #undef major
@@ -39,7 +43,7 @@ static QString replaceSuffix(QString target, const QString& suffix, const QStrin
     return target + replacement;
 }
 
-static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibHack)
+static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibHack, QStringList& extracted)
 {
     QuaZip zip(source);
     if (!zip.open(QuaZip::mdUnzip)) {
@@ -59,6 +63,8 @@ static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibH
         if (!JlCompress::extractFile(&zip, "", absFilePath)) {
             return false;
         }
+        if (!name.endsWith('/'))
+            extracted << name;
     } while (zip.goToNextFile());
     zip.close();
     if (zip.getZipError() != 0) {
@@ -67,6 +73,78 @@ static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibH
     return true;
 }
 
+static const QString s_manifestName = ".natives";
+
+// the files a cache entry should contain, as "size name" lines. written last, so only complete entries have one
+static bool checkEntry(const QString& entry, QStringList& files)
+{
+    QFile manifest(FS::PathCombine(entry, s_manifestName));
+    if (!manifest.open(QIODevice::ReadOnly))
+        return false;
+    files.clear();
+    for (auto line : QString::fromUtf8(manifest.readAll()).split('\n', Qt::SkipEmptyParts)) {
+        auto name = line.section(' ', 1);
+        QFileInfo info(FS::PathCombine(entry, name));
+        if (!info.isFile() || QString::number(info.size()) != line.section(' ', 0, 0))
+            return false;
+        files << name;
+    }
+    return true;
+}
+
+static bool fillEntry(const QString& source, const QString& entry, bool applyJnilibHack, QStringList& files)
+{
+    // extract next to the entry and move it in place when done, so a concurrent launch never sees half of it
+    FS::ensureFolderPathExists(QFileInfo(entry).path());
+    QTemporaryDir staging(entry + "-XXXXXX");
+    if (!staging.isValid())
+        return false;
+    QStringList extracted;
+    if (!unzipNatives(source, staging.path(), applyJnilibHack, extracted))
+        return false;
+
+    QByteArray manifest;
+    for (auto& name : extracted)
+        manifest += QByteArray::number(QFileInfo(FS::PathCombine(staging.path(), name)).size()) + ' ' + name.toUtf8() + '\n';
+    try {
+        FS::write(FS::PathCombine(staging.path(), s_manifestName), manifest);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Couldn't write natives manifest:" << e.cause();
+        return false;
+    }
+
+    FS::deletePath(entry);
+    if (!QDir().rename(staging.path(), entry)) {
+        // someone else may have just finished the same entry
+        return checkEntry(entry, files);
+    }
+    staging.setAutoRemove(false);
+    files = extracted;
+    return true;
+}
+
+// the extracted natives are shared by all instances, keyed by the jar's sha1 and whether the jnilib hack applies.
+// empty if the jar can't be hashed
+static QString cacheEntry(const QString& source, bool applyJnilibHack)
+{
+    auto sha1 = Hashing::cachedHash(source, Hashing::Algorithm::Sha1);
+    if (sha1.isEmpty())
+        return {};
+    return QDir("cache/natives").absoluteFilePath(sha1 + (applyJnilibHack ? "-jnilib" : ""));
+}
+
+// a reflink or a copy, never a hard link: the game could change the file, and with it the cache entry of every instance
+static bool placeFile(const QString& source, const QString& target, bool clone)
+{
+    if (!FS::ensureFilePathExists(target))
+        return false;
+    QFile::remove(target);
+    std::error_code ec;
+    if (clone && FS::clone_file(source, target, ec))
+        return true;
+    return QFile::copy(source, target);
+}
+
 void ExtractNatives::executeTask()
 {
     auto instance = m_parent->instance();
@@ -77,17 +155,50 @@ void ExtractNatives::executeTask()
     }
     auto settings = instance->settings();
 
+    QElapsedTimer timer;
+    timer.start();
     auto outputPath = instance->getNativePath();
+    // left behind by a launch that didn't get to finalize()
+    FS::deletePath(outputPath);
     FS::ensureFolderPathExists(outputPath);
     auto javaVersion = instance->getJavaVersion();
     bool jniHackEnabled = javaVersion.major() >= 8;
+    int extracted = 0;
+    bool clone = FS::canClone(QDir("cache/natives").absolutePath(), outputPath);
     for (const auto& source : toExtract) {
-        if (!unzipNatives(source, outputPath, jniHackEnabled)) {
-            const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
-            emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
-            emitFailed(tr(reason).arg(source, outputPath));
+        auto entry = cacheEntry(source, jniHackEnabled);
+        if (entry.isEmpty()) {
+            // without a hash there is no entry to share, so it goes where it used to
+            QStringList files;
+            if (!unzipNatives(source, outputPath, jniHackEnabled, files)) {
+                const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
+                emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
+                emitFailed(tr(reason).arg(source, outputPath));
+                return;
+            }
+            continue;
+        }
+        QStringList files;
+        if (!checkEntry(entry, files)) {
+            extracted++;
+            if (!fillEntry(source, entry, jniHackEnabled, files)) {
+                const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
+                emit logLine(QString(reason).arg(source, entry), MessageLevel::Fatal);
+                emitFailed(tr(reason).arg(source, entry));
+                return;
+            }
+        }
+        // later jars win, same as when they were all extracted into one folder
+        for (auto& name : files) {
+            if (!placeFile(FS::PathCombine(entry, name), FS::PathCombine(outputPath, name), clone)) {
+                const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
+                emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
+                emitFailed(tr(reason).arg(source, outputPath));
+                return;
+            }
         }
     }
+    qDebug() << "Natives ready in" << timer.elapsed() << "ms," << extracted << "of" << toExtract.size() << "jars extracted";
     emitSucceeded();
 }
 
@@ -21,7 +21,7 @@
 class ExtractNatives : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ExtractNatives(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ExtractNatives(LaunchTask* parent) : LaunchStep(parent) { declare(Components | Java | Libraries, Natives); };
     virtual ~ExtractNatives() {};
 
     void executeTask() override;
@@ -0,0 +1,205 @@
+#include "LaunchFingerprint.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QtConcurrentRun>
+
+#include "FileSystem.h"
+#include "Json.h"
+#include "meta/Version.h"
+#include "minecraft/AssetsUtils.h"
+#include "minecraft/Component.h"
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/PackProfile.h"
+
+namespace {
+const int fingerprintVersion = 1;
+const qint64 maxAge = 24 * 60 * 60 * 1000;
+
+QString contextOf(MinecraftInstance* instance)
+{
+    auto context = instance->runtimeContext();
+    return QString("%1|%2|%3").arg(context.javaArchitecture, context.javaRealArchitecture, context.system);
+}
+}  // namespace
+
+LaunchFingerprint::LaunchFingerprint(MinecraftInstance* instance)
+    : LaunchFingerprint(QDir("cache/launch").absoluteFilePath(instance->id() + ".json"), contextOf(instance), instance->name())
+{
+    m_instance = instance;
+}
+
+LaunchFingerprint::LaunchFingerprint(QString file, QString context, QString name)
+    : m_file(std::move(file)), m_context(std::move(context)), m_name(std::move(name))
+{}
+
+std::optional<LaunchFingerprint::Stamp> LaunchFingerprint::stamp(const QString& path)
+{
+    QFileInfo info(path);
+    if (!info.exists())
+        return {};
+    // the modification time of a folder is what tells that files were added or removed
+    return Stamp{ info.isDir() ? 0 : info.size(), info.lastModified().toMSecsSinceEpoch() };
+}
+
+bool LaunchFingerprint::matches() const
+{
+    if (!QFileInfo::exists(m_file))
+        return false;
+    try {
+        auto root = Json::requireObject(Json::requireDocument(m_file, "launch fingerprint"));
+        if (Json::ensureInteger(root, "version") != fingerprintVersion || Json::ensureString(root, "context") != m_context)
+            return false;
+        auto recorded = qint64(Json::ensureDouble(root, "recorded"));
+        if (QDateTime::currentMSecsSinceEpoch() - recorded > maxAge)
+            return false;
+
+        auto files = Json::ensureObject(root, "files");
+        if (files.isEmpty())
+            return false;
+        for (auto it = files.begin(); it != files.end(); ++it) {
+            auto values = it.value().toArray();
+            auto current = stamp(it.key());
+            if (!current || !(*current == Stamp{ qint64(values.at(0).toDouble()), qint64(values.at(1).toDouble()) })) {
+                qDebug() << m_name << "|" << it.key() << "changed since the last launch";
+                return false;
+            }
+        }
+        return true;
+    } catch (const Exception& e) {
+        qWarning() << "Ignoring the launch fingerprint" << m_file << ":" << e.cause();
+        return false;
+    }
+}
+
+qint64 LaunchFingerprint::recordedTime() const
+{
+    if (!QFileInfo::exists(m_file))
+        return 0;
+    try {
+        return qint64(Json::ensureDouble(Json::requireObject(Json::requireDocument(m_file, "launch fingerprint")), "recorded"));
+    } catch (const Exception&) {
+        return 0;
+    }
+}
+
+void LaunchFingerprint::record(bool updated)
+{
+    auto components = m_instance->getPackProfile();
+    auto profile = components->getProfile();
+    if (!profile) {
+        QFile::remove(m_file);
+        return;
+    }
+
+    // what the profile is made from
+    QStringList files{ FS::PathCombine(m_instance->instanceRoot(), "mmc-pack.json") };
+    for (int i = 0; i < components->rowCount(); i++) {
+        auto component = components->getComponent(i);
+        if (!component->isEnabled())
+            continue;
+        if (component->isCustom()) {
+            files.append(component->getFilename());
+        } else if (auto meta = component->getMeta()) {
+            files.append(QDir("meta").absoluteFilePath(meta->localFilename()));
+        }
+    }
+
+    // the same artifacts the libraries update looks at
+    auto context = m_instance->runtimeContext();
+    QList<LibraryPtr> libraries;
+    libraries.append(profile->getLibraries());
+    libraries.append(profile->getNativeLibraries());
+    libraries.append(profile->getMavenFiles());
+    for (auto agent : profile->getAgents()) {
+        libraries.append(agent->library());
+    }
+    libraries.append(profile->getMainJar());
+    QStringList jars, natives, natives32, natives64;
+    for (auto library : libraries) {
+        if (library)
+            library->getApplicableFiles(context, jars, natives, natives32, natives64, m_instance->getLocalLibraryPath());
+    }
+    for (auto jarMod : profile->getJarMods()) {
+        jarMod->getApplicableFiles(context, jars, natives, natives32, natives64, m_instance->jarModsDir());
+    }
+    files += jars + natives;
+    if (context.javaArchitecture == "32") {
+        files += natives32;
+    } else if (context.javaArchitecture == "64") {
+        files += natives64;
+    }
+
+    auto assets = profile->getMinecraftAssets();
+    auto assetsId = assets ? assets->id : QString();
+
+    QtConcurrent::run(QThreadPool::globalInstance(), [fingerprint = *this, files, libDir = m_instance->libDir(), assetsId, updated] {
+        fingerprint.recordFiles(files, libDir, assetsId, updated);
+    });
+}
+
+bool LaunchFingerprint::recordFiles(const QStringList& files, const QString& libDir, const QString& assetsId, bool updated) const
+{
+    auto drop = [this](const QString& missing) {
+        qDebug() << "Not keeping a launch fingerprint," << missing << "is missing";
+        QFile::remove(m_file);
+        return false;
+    };
+
+    Stamps stamps;
+    for (auto& path : files) {
+        auto current = stamp(path);
+        if (!current)
+            return drop(path);
+        stamps.insert(QFileInfo(path).absoluteFilePath(), *current);
+    }
+    // legacy FML libraries are put in the instance
+    if (!libDir.isEmpty()) {
+        for (auto& info : QDir(libDir).entryInfoList(QDir::Files)) {
+            stamps.insert(info.absoluteFilePath(), { info.size(), info.lastModified().toMSecsSinceEpoch() });
+        }
+    }
+    if (!assetsId.isEmpty()) {
+        auto indexPath = QDir("assets/indexes").absoluteFilePath(assetsId + ".json");
+        auto indexStamp = stamp(indexPath);
+        AssetsIndex index;
+        if (!indexStamp || !AssetsUtils::loadAssetsIndexJson(assetsId, indexPath, index))
+            return drop(indexPath);
+        stamps.insert(indexPath, *indexStamp);
+        QSet<QString> prefixes;
+        for (auto& object : index.objects) {
+            prefixes.insert(object.hash.left(2));
+        }
+        for (auto& prefix : prefixes) {
+            auto folder = QDir("assets/objects").absoluteFilePath(prefix);
+            auto current = stamp(folder);
+            if (!current)
+                return drop(folder);
+            stamps.insert(folder, *current);
+        }
+    }
+
+    QJsonObject filesOut;
+    for (auto it = stamps.cbegin(); it != stamps.cend(); ++it) {
+        filesOut.insert(it.key(), QJsonArray{ double(it->size), double(it->modified) });
+    }
+    // a launch that skipped the update doesn't make the metadata any newer
+    auto recorded = updated ? QDateTime::currentMSecsSinceEpoch() : recordedTime();
+    try {
+        FS::ensureFilePathExists(m_file);
+        Json::write(QJsonObject{ { "version", fingerprintVersion },
+                                 { "recorded", double(recorded) },
+                                 { "context", m_context },
+                                 { "files", filesOut } },
+                    m_file);
+    } catch (const Exception& e) {
+        qWarning() << "Could not write the launch fingerprint" << m_file << ":" << e.cause();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+class MinecraftInstance;
+
+/* What a launch of an instance was made from, as of the last time the game started: the component and metadata files,
+ * every library, native and jar mod, and the asset index with the objects folders it uses, each with its size and
+ * modification time, and the runtime context.
+ *
+ * While none of it changed, a launch can skip updating the instance, so no metadata is fetched and no library is looked
+ * at. A fingerprint is only good for a day after the last launch that did update, so the metadata still gets refreshed
+ * at least that often. Launches that skipped the update record the files again, but keep that time. */
+class LaunchFingerprint {
+   public:
+    explicit LaunchFingerprint(MinecraftInstance* instance);
+    // the fingerprint kept in file, for a launch in this runtime context
+    LaunchFingerprint(QString file, QString context, QString name = QString());
+
+    // whether the recorded fingerprint still matches what is on disk. looks at every file, so better not on the GUI thread
+    bool matches() const;
+
+    // records the fingerprint of the loaded profile of the instance, in the background. when something it uses is
+    // missing, the recorded one is dropped instead, so the next launch goes through the update. updated tells whether
+    // this launch ran the update, only then does the fingerprint start another day
+    void record(bool updated);
+    // records these files, the files in libDir and the objects folders used by the asset index, and returns whether it
+    // could. this is the part of record() done in the background
+    bool recordFiles(const QStringList& files,
+                     const QString& libDir = QString(),
+                     const QString& assetsId = QString(),
+                     bool updated = true) const;
+
+   private:
+    struct Stamp {
+        qint64 size;
+        qint64 modified;
+        bool operator==(const Stamp& other) const { return size == other.size && modified == other.modified; }
+    };
+    using Stamps = QHash<QString, Stamp>;
+
+    static std::optional<Stamp> stamp(const QString& path);
+    // when the recorded fingerprint was last made by a launch that updated, 0 if there is none
+    qint64 recordedTime() const;
+
+    QString m_file;
+    QString m_context;
+    // of the instance, for the log
+    QString m_name;
+    MinecraftInstance* m_instance = nullptr;
+};
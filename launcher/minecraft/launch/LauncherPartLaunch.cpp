@@ -43,6 +43,7 @@
 #include "FileSystem.h"
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
+#include "minecraft/launch/LaunchFingerprint.h"
 
 #ifdef Q_OS_LINUX
 #include "gamemode_client.h"
@@ -54,16 +55,20 @@ LauncherPartLaunch::LauncherPartLaunch(LaunchTask* parent)
 {
     if (parent->instance()->settings()->get("CloseAfterLaunch").toBool()) {
         std::shared_ptr<QMetaObject::Connection> connection{ new QMetaObject::Connection };
-        *connection = connect(
-            &m_process, &LoggedProcess::log, this, [connection](const QStringList& lines, [[maybe_unused]] MessageLevel::Enum level) {
-                qDebug() << lines;
-                if (lines.filter(QRegularExpression(".*Setting user.+", QRegularExpression::CaseInsensitiveOption)).length() != 0) {
+        *connection = connect(parent->logPipeline(), &LogPipeline::linesReady, this, [connection](const QVector<LogModel::Line>& lines) {
+            static const QRegularExpression settingUser(".*Setting user.+", QRegularExpression::CaseInsensitiveOption);
+            for (auto& line : lines) {
+                if (line.text.contains(settingUser)) {
                     APPLICATION->closeAllWindows();
                     disconnect(*connection);
+                    return;
                 }
-            });
+            }
+        });
     }
 
+    // the game's output is decoded, classified and censored off the GUI thread
+    m_process.setLogPipeline(parent->logPipeline());
     connect(&m_process, &LoggedProcess::log, this, &LauncherPartLaunch::logLines);
     connect(&m_process, &LoggedProcess::stateChanged, this, &LauncherPartLaunch::on_state);
 }
@@ -195,7 +200,10 @@ void LauncherPartLaunch::on_state(LoggedProcess::State state)
         }
         case LoggedProcess::Running:
             emit logLine(QString("Minecraft process ID: %1\n\n").arg(m_process.processId()), MessageLevel::Launcher);
+            qDebug() << "Started" << m_parent->instance()->name() << m_parent->elapsed() << "ms after the launch began";
             m_parent->setPid(m_process.processId());
+            // the next launch may skip the update if nothing this one used changes
+            LaunchFingerprint(m_parent->instance().get()).record(m_updated && m_updated());
             // send the launch script to the launcher part
             m_process.write(m_launchScript.toUtf8());
 
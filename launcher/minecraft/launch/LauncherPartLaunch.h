@@ -21,6 +21,8 @@
 
 #include "MinecraftTarget.h"
 
+#include <functional>
+
 class LauncherPartLaunch : public LaunchStep {
     Q_OBJECT
    public:
@@ -35,6 +37,8 @@ class LauncherPartLaunch : public LaunchStep {
     void setAuthSession(AuthSessionPtr session) { m_session = session; }
 
     void setTargetToJoin(MinecraftTarget::Ptr targetToJoin) { m_targetToJoin = std::move(targetToJoin); }
+    // whether this launch updated the instance, asked once the game started. see LaunchFingerprint::record()
+    void setUpdated(std::function<bool()> updated) { m_updated = std::move(updated); }
 
    private slots:
     void on_state(LoggedProcess::State state);
@@ -45,6 +49,7 @@ class LauncherPartLaunch : public LaunchStep {
     AuthSessionPtr m_session;
     QString m_launchScript;
     MinecraftTarget::Ptr m_targetToJoin;
+    std::function<bool()> m_updated;
 
     bool mayProceed = false;
 };
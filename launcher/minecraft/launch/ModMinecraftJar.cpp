@@ -39,6 +39,53 @@
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
+#include "modplatform/helpers/HashUtils.h"
+
+#include <QDateTime>
+
+// how many modded jars are kept around, for switching between a few sets of jar mods
+static const int s_cachedJars = 8;
+
+/* The modded jar only depends on the source jar and on the enabled jar mods in their order, so their hashes
+ * make up its name in the cache. Folder mods can't be hashed cheaply, so jars with them are never cached, and neither
+ * are jars with a part that couldn't be read. */
+static QString cacheKey(const QString& sourceJarPath, const QList<Mod*>& mods)
+{
+    auto sourceHash = Hashing::cachedHash(sourceJarPath, Hashing::Algorithm::Sha1);
+    if (sourceHash.isEmpty())
+        return {};
+    QStringList parts{ sourceHash };
+    for (auto mod : mods) {
+        if (!mod->enabled())
+            continue;
+        if (mod->type() != ResourceType::ZIPFILE && mod->type() != ResourceType::SINGLEFILE)
+            return {};
+        auto hash = Hashing::cachedHash(mod->fileinfo().absoluteFilePath(), Hashing::Algorithm::Sha1);
+        if (hash.isEmpty())
+            return {};
+        // single files go into the jar under their name
+        parts << mod->fileinfo().fileName() + ':' + hash;
+    }
+    return Hashing::hash(parts.join('\n').toUtf8(), Hashing::Algorithm::Sha1);
+}
+
+static void pruneCache(const QDir& cache)
+{
+    auto jars = cache.entryInfoList({ "*.jar" }, QDir::Files, QDir::Time);
+    for (int i = s_cachedJars; i < jars.size(); i++)
+        QFile::remove(jars[i].absoluteFilePath());
+}
+
+// never a hard link, anything writing to the instance's jar would change the cached one for every other instance
+static bool placeJar(const QString& source, const QString& target)
+{
+    std::error_code ec;
+    if (FS::canClone(source, QFileInfo(target).absolutePath()) && FS::clone_file(source, target, ec))
+        return true;
+    // a clone that failed halfway could have left something behind
+    QFile::remove(target);
+    return QFile::copy(source, target);
+}
 
 void ModMinecraftJar::executeTask()
 {
@@ -51,11 +98,13 @@ void ModMinecraftJar::executeTask()
     // nuke obsolete stripped jar(s) if needed
     if (!FS::ensureFolderPathExists(m_inst->binRoot())) {
         emitFailed(tr("Couldn't create the bin folder for Minecraft.jar"));
+        return;
     }
 
     auto finalJarPath = QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar");
     if (!removeJar()) {
         emitFailed(tr("Couldn't remove stale jar file: %1").arg(finalJarPath));
+        return;
     }
 
     // create temporary modded jar, if needed
@@ -67,7 +116,37 @@ void ModMinecraftJar::executeTask()
         QStringList jars, temp1, temp2, temp3, temp4;
         mainJar->getApplicableFiles(m_inst->runtimeContext(), jars, temp1, temp2, temp3, m_inst->getLocalLibraryPath());
         auto sourceJarPath = jars[0];
-        if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
+
+        auto key = cacheKey(sourceJarPath, jarMods);
+        if (key.isEmpty()) {
+            if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
+                emitFailed(tr("Failed to create the custom Minecraft jar file."));
+                return;
+            }
+            emitSucceeded();
+            return;
+        }
+
+        QDir cache("cache/jars");
+        auto cachedJarPath = cache.absoluteFilePath(key + ".jar");
+        if (QFile::exists(cachedJarPath)) {
+            emit logLine(tr("Using the cached custom Minecraft jar file."), MessageLevel::Launcher);
+            // the most recently used jars are the ones kept
+            QFile cached(cachedJarPath);
+            if (cached.open(QIODevice::ReadWrite))
+                cached.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        } else {
+            // build it under another name, so an interrupted launch doesn't leave a broken jar in the cache
+            auto partPath = cachedJarPath + ".part";
+            if (!FS::ensureFilePathExists(partPath) || !MMCZip::createModdedJar(sourceJarPath, partPath, jarMods) ||
+                !FS::move(partPath, cachedJarPath)) {
+                QFile::remove(partPath);
+                emitFailed(tr("Failed to create the custom Minecraft jar file."));
+                return;
+            }
+            pruneCache(cache);
+        }
+        if (!placeJar(cachedJarPath, finalJarPath)) {
             emitFailed(tr("Failed to create the custom Minecraft jar file."));
             return;
         }
@@ -21,7 +21,7 @@
 class ModMinecraftJar : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ModMinecraftJar(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ModMinecraftJar(LaunchTask* parent) : LaunchStep(parent) { declare(Components | Libraries, JarMods); };
     virtual ~ModMinecraftJar() {};
 
     virtual void executeTask() override;
@@ -24,7 +24,10 @@ class PrintInstanceInfo : public LaunchStep {
     Q_OBJECT
    public:
     explicit PrintInstanceInfo(LaunchTask* parent, AuthSessionPtr session, MinecraftTarget::Ptr targetToJoin)
-        : LaunchStep(parent), m_session(session), m_targetToJoin(targetToJoin) {};
+        : LaunchStep(parent), m_session(session), m_targetToJoin(targetToJoin)
+    {
+        declare(GameFolder | ServerAddress | Components | Java | Account | Libraries | JarMods | Mods, {});
+    };
     virtual ~PrintInstanceInfo() = default;
 
     virtual void executeTask();
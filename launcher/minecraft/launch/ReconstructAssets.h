@@ -21,7 +21,7 @@
 class ReconstructAssets : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ReconstructAssets(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ReconstructAssets(LaunchTask* parent) : LaunchStep(parent) { declare(Components, Assets); };
     virtual ~ReconstructAssets() {};
 
     void executeTask() override;
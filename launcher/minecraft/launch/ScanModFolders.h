@@ -21,7 +21,7 @@
 class ScanModFolders : public LaunchStep {
     Q_OBJECT
    public:
-    explicit ScanModFolders(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit ScanModFolders(LaunchTask* parent) : LaunchStep(parent) { declare(GameFolder, Mods); };
     virtual ~ScanModFolders() {};
 
     virtual void executeTask() override;
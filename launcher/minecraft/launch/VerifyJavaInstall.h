@@ -42,7 +42,7 @@ class VerifyJavaInstall : public LaunchStep {
     Q_OBJECT
 
    public:
-    explicit VerifyJavaInstall(LaunchTask* parent) : LaunchStep(parent) {};
+    explicit VerifyJavaInstall(LaunchTask* parent) : LaunchStep(parent) { declare(Java | Components, {}); };
     ~VerifyJavaInstall() override = default;
 
     void executeTask() override;
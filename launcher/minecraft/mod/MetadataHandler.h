@@ -29,6 +29,7 @@ class Mod;
 namespace Metadata {
 using ModStruct = Packwiz::V1::Mod;
 using ModSide = Packwiz::V1::Side;
+using Index = Packwiz::Index;
 
 inline auto create(const QDir& index_dir, ModPlatform::IndexedPack& mod_pack, ModPlatform::IndexedVersion& mod_version) -> ModStruct
 {
@@ -65,6 +66,11 @@ inline auto get(const QDir& index_dir, QVariant& mod_id) -> ModStruct
     return Packwiz::V1::getIndexForMod(index_dir, mod_id);
 }
 
+inline auto index(const QDir& index_dir) -> std::shared_ptr<Index>
+{
+    return Packwiz::Index::get(index_dir);
+}
+
 inline auto modSideToString(ModSide side) -> QString
 {
     return Packwiz::V1::sideToString(side);
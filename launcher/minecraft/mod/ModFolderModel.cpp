@@ -68,6 +68,15 @@ ModFolderModel::ModFolderModel(const QDir& dir, BaseInstance* instance, bool is_
                               QHeaderView::Interactive, QHeaderView::Interactive, QHeaderView::Interactive };
     m_columnsHideable = { false, true, false, true, true, true, true, true, true, true, true };
     m_columnsHiddenByDefault = { false, false, false, false, false, false, false, true, true, true, true };
+
+    if (m_instance) {
+        auto cache_file = QDir("cache/mods").absoluteFilePath(m_instance->id() + "-" + m_dir.dirName() + ".json");
+        m_parse_cache = std::make_shared<ModParseCache>(cache_file, m_dir.absolutePath());
+        connect(this, &ResourceFolderModel::parseFinished, this, [this] {
+            if (!hasPendingParseTasks())
+                m_parse_cache->save();
+        });
+    }
 }
 
 QVariant ModFolderModel::data(const QModelIndex& index, int role) const
@@ -215,7 +224,7 @@ int ModFolderModel::columnCount(const QModelIndex& parent) const
 
 Task* ModFolderModel::createParseTask(Resource& resource)
 {
-    return new LocalModParseTask(m_next_resolution_ticket, resource.type(), resource.fileinfo());
+    return new LocalModParseTask(m_next_resolution_ticket, resource.type(), resource.fileinfo(), m_parse_cache);
 }
 
 bool ModFolderModel::isValid()
@@ -45,6 +45,7 @@
 #include <QString>
 
 #include "Mod.h"
+#include "ModParseCache.h"
 #include "ResourceFolderModel.h"
 
 class BaseInstance;
@@ -89,4 +90,8 @@ class ModFolderModel : public ResourceFolderModel {
 
    private slots:
     void onParseSucceeded(int ticket, QString resource_id) override;
+
+   private:
+    // only for the folders of an instance
+    std::shared_ptr<ModParseCache> m_parse_cache;
 };
@@ -0,0 +1,134 @@
+#include "ModParseCache.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+#include "FileSystem.h"
+#include "Json.h"
+
+namespace {
+// bump this when what is read from mods changes, so older entries are read again
+const int cacheVersion = 1;
+
+QJsonObject detailsToJson(const ModDetails& details)
+{
+    QJsonObject obj;
+    obj.insert("mod_id", details.mod_id);
+    obj.insert("name", details.name);
+    obj.insert("version", details.version);
+    obj.insert("mcversion", details.mcversion);
+    obj.insert("homeurl", details.homeurl);
+    obj.insert("description", details.description);
+    obj.insert("authors", QJsonArray::fromStringList(details.authors));
+    obj.insert("issue_tracker", details.issue_tracker);
+    QJsonArray licenses;
+    for (auto& license : details.licenses) {
+        licenses.append(QJsonObject{ { "name", license.name }, { "id", license.id }, { "url", license.url }, { "description", license.description } });
+    }
+    obj.insert("licenses", licenses);
+    obj.insert("icon_file", details.icon_file);
+    return obj;
+}
+
+ModDetails detailsFromJson(const QJsonObject& obj)
+{
+    ModDetails details;
+    details.mod_id = Json::ensureString(obj, "mod_id");
+    details.name = Json::ensureString(obj, "name");
+    details.version = Json::ensureString(obj, "version");
+    details.mcversion = Json::ensureString(obj, "mcversion");
+    details.homeurl = Json::ensureString(obj, "homeurl");
+    details.description = Json::ensureString(obj, "description");
+    for (auto author : Json::ensureArray(obj, "authors")) {
+        details.authors.append(author.toString());
+    }
+    details.issue_tracker = Json::ensureString(obj, "issue_tracker");
+    for (auto value : Json::ensureArray(obj, "licenses")) {
+        auto license = value.toObject();
+        details.licenses.append(ModLicense(Json::ensureString(license, "name"), Json::ensureString(license, "id"),
+                                           Json::ensureString(license, "url"), Json::ensureString(license, "description")));
+    }
+    details.icon_file = Json::ensureString(obj, "icon_file");
+    return details;
+}
+}  // namespace
+
+ModParseCache::ModParseCache(QString cache_file, QString folder) : m_cache_file(std::move(cache_file)), m_folder(std::move(folder))
+{
+    load();
+}
+
+ModParseCache::Entry ModParseCache::key(const QFileInfo& file)
+{
+    return { file.size(), file.lastModified().toMSecsSinceEpoch(), FS::fileId(file.absoluteFilePath()), {} };
+}
+
+void ModParseCache::load()
+{
+    if (!QFileInfo::exists(m_cache_file))
+        return;
+    try {
+        auto root = Json::requireObject(Json::requireDocument(m_cache_file, "mod parse cache"));
+        if (Json::ensureInteger(root, "version") != cacheVersion)
+            return;
+        auto files = Json::ensureObject(root, "files");
+        for (auto it = files.begin(); it != files.end(); ++it) {
+            auto obj = it.value().toObject();
+            m_entries.insert(it.key(), { qint64(Json::ensureDouble(obj, "size")), qint64(Json::ensureDouble(obj, "modified")),
+                                         Json::ensureString(obj, "id").toULongLong(), detailsFromJson(Json::ensureObject(obj, "details")) });
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Ignoring the mod parse cache" << m_cache_file << ":" << e.cause();
+        m_entries.clear();
+    }
+}
+
+std::optional<ModDetails> ModParseCache::find(const QFileInfo& file) const
+{
+    auto current = key(file);
+    QMutexLocker locker(&m_lock);
+    auto it = m_entries.constFind(file.fileName());
+    if (it == m_entries.constEnd() || it->size != current.size || it->modified != current.modified || it->id != current.id)
+        return {};
+    return it->details;
+}
+
+void ModParseCache::insert(const QFileInfo& file, const ModDetails& details)
+{
+    auto entry = key(file);
+    entry.details = details;
+    QMutexLocker locker(&m_lock);
+    m_entries.insert(file.fileName(), entry);
+    m_dirty = true;
+}
+
+void ModParseCache::save()
+{
+    QJsonObject files;
+    {
+        QMutexLocker locker(&m_lock);
+        if (!m_dirty)
+            return;
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (!QFileInfo::exists(FS::PathCombine(m_folder, it.key()))) {
+                it = m_entries.erase(it);
+                continue;
+            }
+            files.insert(it.key(), QJsonObject{ { "size", double(it->size) },
+                                                { "modified", double(it->modified) },
+                                                { "id", QString::number(it->id) },
+                                                { "details", detailsToJson(it->details) } });
+            ++it;
+        }
+        m_dirty = false;
+    }
+    try {
+        FS::ensureFilePathExists(m_cache_file);
+        Json::write(QJsonObject{ { "version", cacheVersion }, { "files", files } }, m_cache_file);
+    } catch (const Exception& e) {
+        qWarning() << "Could not write the mod parse cache" << m_cache_file << ":" << e.cause();
+    }
+}
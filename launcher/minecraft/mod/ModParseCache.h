@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <optional>
+
+#include "minecraft/mod/ModDetails.h"
+
+/* Remembers what was read from the mod files of a folder, across launcher sessions.
+ *
+ * An entry is only used while the file's size, modification time and file id (FS::fileId) are the same as when it was
+ * read, so a replaced or edited mod is read again. Lookups and inserts may come from several parse tasks at once. */
+class ModParseCache {
+   public:
+    // cache_file is where the entries are kept, for the mods in folder
+    ModParseCache(QString cache_file, QString folder);
+
+    std::optional<ModDetails> find(const QFileInfo& file) const;
+    void insert(const QFileInfo& file, const ModDetails& details);
+
+    // writes the entries out if there are new ones, leaving out those of files that are gone
+    void save();
+
+   private:
+    struct Entry {
+        qint64 size;
+        qint64 modified;
+        quint64 id;
+        ModDetails details;
+    };
+    static Entry key(const QFileInfo& file);
+    void load();
+
+    QString m_cache_file;
+    QString m_folder;
+
+    mutable QMutex m_lock;
+    // by file name
+    QHash<QString, Entry> m_entries;
+    bool m_dirty = false;
+};
@@ -9,6 +9,7 @@
 #include <QMenu>
 #include <QMimeData>
 #include <QStyle>
+#include <QThread>
 #include <QThreadPool>
 #include <QUrl>
 #include <utility>
@@ -37,14 +38,21 @@ ResourceFolderModel::ResourceFolderModel(const QDir& dir, BaseInstance* instance
     m_dir.setSorting(QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
 
     connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ResourceFolderModel::directoryChanged);
-    connect(&m_helper_thread_task, &ConcurrentTask::finished, this, [this] { m_helper_thread_task.clear(); });
+    if (m_is_indexed) {
+        m_metadata_index = Metadata::index(indexDir());
+    }
+    // parsing is mostly reading and inflating, more threads than cores don't help
+    int max_parse_threads = QThread::idealThreadCount();
     if (APPLICATION_DYN) {  // in tests the application macro doesn't work
-        m_helper_thread_task.setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+        max_parse_threads = std::min(max_parse_threads, APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
     }
+    m_parse_pool.setMaxThreadCount(std::max(1, max_parse_threads));
 }
 
 ResourceFolderModel::~ResourceFolderModel()
 {
+    m_parse_pool.clear();
+    m_parse_pool.waitForDone();
     while (!QThreadPool::globalInstance()->waitForDone(100))
         QCoreApplication::processEvents();
 }
@@ -354,11 +362,7 @@ void ResourceFolderModel::resolveResource(Resource::Ptr res)
         },
         Qt::ConnectionType::QueuedConnection);
 
-    m_helper_thread_task.addTask(task);
-
-    if (!m_helper_thread_task.isRunning()) {
-        QThreadPool::globalInstance()->start(&m_helper_thread_task);
-    }
+    m_parse_pool.start(task.get());
 }
 
 void ResourceFolderModel::onUpdateSucceeded()
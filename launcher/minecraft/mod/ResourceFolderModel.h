@@ -8,6 +8,7 @@
 #include <QMutex>
 #include <QSet>
 #include <QSortFilterProxyModel>
+#include <QThreadPool>
 #include <QTreeView>
 
 #include "Resource.h"
@@ -251,6 +252,8 @@ class ResourceFolderModel : public QAbstractListModel {
     bool m_is_watching = false;
 
     bool m_is_indexed;
+    // kept here so what was read from the index folder is kept between loads
+    std::shared_ptr<Metadata::Index> m_metadata_index;
     bool m_first_folder_load = true;
 
     Task::Ptr m_current_update_task = nullptr;
@@ -261,7 +264,8 @@ class ResourceFolderModel : public QAbstractListModel {
     // Represents the relationship between a resource's internal ID and it's row position on the model.
     QMap<QString, int> m_resources_index;
 
-    ConcurrentTask m_helper_thread_task;
     QMap<int, Task::Ptr> m_active_parse_tasks;
+    // parse tasks run here, a few at a time
+    QThreadPool m_parse_pool;
     std::atomic<int> m_next_resolution_ticket = 0;
 };
@@ -1,8 +1,6 @@
 #include "LocalModParseTask.h"
 
 #include <qdcss.h>
-#include <quazip/quazip.h>
-#include <quazip/quazipfile.h>
 #include <toml++/toml.h>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -13,6 +11,7 @@
 
 #include "FileSystem.h"
 #include "Json.h"
+#include "ZipReader.h"
 #include "minecraft/mod/ModDetails.h"
 #include "settings/INIFile.h"
 
@@ -466,31 +465,30 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
 {
     ModDetails details;
 
-    QuaZip zip(mod.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(mod.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
+    auto read = [&zip](const QString& name, QByteArray& data) {
+        data = zip.read(name);
+        return !data.isNull();
+    };
+    QByteArray data;
 
-    if (zip.setCurrentFile("META-INF/mods.toml") || zip.setCurrentFile("META-INF/neoforge.mods.toml")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    if (zip.contains("META-INF/mods.toml") || zip.contains("META-INF/neoforge.mods.toml")) {
+        if (!read(zip.contains("META-INF/mods.toml") ? "META-INF/mods.toml" : "META-INF/neoforge.mods.toml", data))
             return false;
-        }
 
-        details = ReadMCModTOML(file.readAll());
-        file.close();
+        details = ReadMCModTOML(data);
 
         // to replace ${file.jarVersion} with the actual version, as needed
         if (details.version == "${file.jarVersion}") {
-            if (zip.setCurrentFile("META-INF/MANIFEST.MF")) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    zip.close();
+            if (zip.contains("META-INF/MANIFEST.MF")) {
+                if (!read("META-INF/MANIFEST.MF", data))
                     return false;
-                }
 
                 // quick and dirty line-by-line parser
-                auto manifestLines = QString(file.readAll()).split(newlineRegex);
+                auto manifestLines = QString(data).split(newlineRegex);
                 QString manifestVersion = "";
                 for (auto& line : manifestLines) {
                     if (line.startsWith("Implementation-Version: ", Qt::CaseInsensitive)) {
@@ -506,69 +504,50 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
                 }
 
                 details.version = manifestVersion;
-
-                file.close();
             }
         }
 
-        zip.close();
         mod.setDetails(details);
 
         return true;
-    } else if (zip.setCurrentFile("mcmod.info")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("mcmod.info")) {
+        if (!read("mcmod.info", data))
             return false;
-        }
 
-        details = ReadMCModInfo(file.readAll());
-        file.close();
-        zip.close();
+        details = ReadMCModInfo(data);
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("quilt.mod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("quilt.mod.json")) {
+        if (!read("quilt.mod.json", data))
             return false;
-        }
 
-        details = ReadQuiltModInfo(file.readAll());
-        file.close();
-        zip.close();
+        details = ReadQuiltModInfo(data);
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("fabric.mod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("fabric.mod.json")) {
+        if (!read("fabric.mod.json", data))
             return false;
-        }
 
-        details = ReadFabricModInfo(file.readAll());
-        file.close();
-        zip.close();
+        details = ReadFabricModInfo(data);
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("forgeversion.properties")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("forgeversion.properties")) {
+        if (!read("forgeversion.properties", data))
             return false;
-        }
 
-        details = ReadForgeInfo(file.readAll());
-        file.close();
-        zip.close();
+        details = ReadForgeInfo(data);
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("META-INF/nil/mappings.json")) {
+    } else if (zip.contains("META-INF/nil/mappings.json")) {
         // nilloader uses the filename of the metadata file for the modid, so we can't know the exact filename
         // thankfully, there is a good file to use as a canary so we don't look for nil meta all the time
 
         QString foundNilMeta;
-        for (auto& fname : zip.getFileNameList()) {
+        for (auto& fname : zip.fileNames()) {
             // nilmods can shade nilloader to be able to run as a standalone agent - which includes nilloader's own meta file
             if (fname.endsWith(".nilmod.css") && fname != "nilloader.nilmod.css") {
                 foundNilMeta = fname;
@@ -576,22 +555,17 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
             }
         }
 
-        if (zip.setCurrentFile(foundNilMeta)) {
-            if (!file.open(QIODevice::ReadOnly)) {
-                zip.close();
+        if (zip.contains(foundNilMeta)) {
+            if (!read(foundNilMeta, data))
                 return false;
-            }
 
-            details = ReadNilModInfo(file.readAll(), foundNilMeta);
-            file.close();
-            zip.close();
+            details = ReadNilModInfo(data, foundNilMeta);
 
             mod.setDetails(details);
             return true;
         }
     }
 
-    zip.close();
     return false;  // no valid mod found in archive
 }
 
@@ -620,25 +594,20 @@ bool processLitemod(Mod& mod, [[maybe_unused]] ProcessingLevel level)
 {
     ModDetails details;
 
-    QuaZip zip(mod.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(mod.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
-
-    if (zip.setCurrentFile("litemod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    if (zip.contains("litemod.json")) {
+        auto data = zip.read("litemod.json");
+        if (data.isNull())
             return false;
-        }
 
-        details = ReadLiteModInfo(file.readAll());
-        file.close();
+        details = ReadLiteModInfo(data);
 
         mod.setDetails(details);
         return true;
     }
-    zip.close();
 
     return false;  // no valid litemod.json found in archive
 }
@@ -696,24 +665,19 @@ bool loadIconFile(const Mod& mod, QPixmap* pixmap)
             return png_invalid("file '" + icon_info.filePath() + "' does not exists or is not a file");
         }
         case ResourceType::ZIPFILE: {
-            QuaZip zip(mod.fileinfo().filePath());
-            if (!zip.open(QuaZip::mdUnzip))
+            ZipReader zip(mod.fileinfo().filePath());
+            if (!zip.open())
                 return png_invalid("failed to open '" + mod.fileinfo().filePath() + "' as a zip archive");
 
-            QuaZipFile file(&zip);
-
-            if (zip.setCurrentFile(mod.iconPath())) {
-                if (!file.open(QIODevice::ReadOnly)) {
+            if (zip.contains(mod.iconPath())) {
+                auto data = zip.read(mod.iconPath());
+                if (data.isNull()) {
                     qCritical() << "Failed to open file in zip.";
-                    zip.close();
                     return png_invalid("Failed to open '" + mod.iconPath() + "' in zip archive");
                 }
 
-                auto data = file.readAll();
-
                 bool icon_result = ModUtils::processIconPNG(mod, std::move(data), pixmap);
 
-                file.close();
                 if (!icon_result) {
                     return png_invalid("invalid png image");  // icon png invalid
                 }
@@ -732,8 +696,8 @@ bool loadIconFile(const Mod& mod, QPixmap* pixmap)
 
 }  // namespace ModUtils
 
-LocalModParseTask::LocalModParseTask(int token, ResourceType type, const QFileInfo& modFile)
-    : Task(false), m_token(token), m_type(type), m_modFile(modFile), m_result(new Result())
+LocalModParseTask::LocalModParseTask(int token, ResourceType type, const QFileInfo& modFile, std::shared_ptr<ModParseCache> cache)
+    : Task(false), m_token(token), m_type(type), m_modFile(modFile), m_cache(std::move(cache)), m_result(new Result())
 {}
 
 bool LocalModParseTask::abort()
@@ -744,10 +708,25 @@ bool LocalModParseTask::abort()
 
 void LocalModParseTask::executeTask()
 {
+    // folders can change inside without their own size or time changing
+    auto use_cache = m_cache && m_type != ResourceType::FOLDER;
+    // the file may have changed since the folder was listed
+    m_modFile.refresh();
+    if (use_cache) {
+        if (auto details = m_cache->find(m_modFile)) {
+            m_result->details = *details;
+            emitSucceeded();
+            return;
+        }
+    }
+
     Mod mod{ m_modFile };
     ModUtils::process(mod, ModUtils::ProcessingLevel::Full);
 
     m_result->details = mod.details();
+    if (use_cache && !m_aborted) {
+        m_cache->insert(m_modFile, m_result->details);
+    }
 
     if (m_aborted)
         emitAborted();
@@ -5,6 +5,7 @@
 
 #include "minecraft/mod/Mod.h"
 #include "minecraft/mod/ModDetails.h"
+#include "minecraft/mod/ModParseCache.h"
 
 #include "tasks/Task.h"
 
@@ -42,7 +43,8 @@ class LocalModParseTask : public Task {
     [[nodiscard]] bool canAbort() const override { return true; }
     bool abort() override;
 
-    LocalModParseTask(int token, ResourceType type, const QFileInfo& modFile);
+    // with a cache, mods that were read before and didn't change since aren't read again
+    LocalModParseTask(int token, ResourceType type, const QFileInfo& modFile, std::shared_ptr<ModParseCache> cache = nullptr);
     void executeTask() override;
 
     [[nodiscard]] int token() const { return m_token; }
@@ -51,6 +53,7 @@ class LocalModParseTask : public Task {
     int m_token;
     ResourceType m_type;
     QFileInfo m_modFile;
+    std::shared_ptr<ModParseCache> m_cache;
     ResultPtr m_result;
 
     std::atomic<bool> m_aborted = false;
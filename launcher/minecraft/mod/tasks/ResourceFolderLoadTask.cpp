@@ -38,6 +38,7 @@
 
 #include "Application.h"
 #include "FileSystem.h"
+#include "net/FileSink.h"
 #include "minecraft/mod/MetadataHandler.h"
 
 #include <QThread>
@@ -74,6 +75,10 @@ void ResourceFolderLoadTask::executeTask()
         if (auto app = APPLICATION_DYN; app && app->checkQSavePath(filePath)) {
             continue;
         }
+        // interrupted downloads kept around to be resumed
+        if (Net::FileSink::isPartialFile(filePath)) {
+            continue;
+        }
         auto newFilePath = FS::getUniqueResourceName(filePath);
         if (newFilePath != filePath) {
             FS::move(filePath, newFilePath);
@@ -134,13 +139,10 @@ void ResourceFolderLoadTask::executeTask()
 
 void ResourceFolderLoadTask::getFromMetadata()
 {
-    m_index_dir.refresh();
-    for (auto entry : m_index_dir.entryList(QDir::Files)) {
-        auto metadata = Metadata::get(m_index_dir, entry);
-
-        if (!metadata.isValid())
-            continue;
-
+    // only reads the files that changed since the last load
+    auto index = Metadata::index(m_index_dir);
+    index->refresh();
+    for (auto& metadata : index->mods()) {
         auto* resource = m_create_func(QFileInfo(m_resource_dir.filePath(metadata.filename)));
         resource->setMetadata(metadata);
         resource->setStatus(ResourceStatus::NOT_INSTALLED);
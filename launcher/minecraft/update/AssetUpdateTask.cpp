@@ -18,15 +18,26 @@ AssetUpdateTask::AssetUpdateTask(MinecraftInstance* inst)
 void AssetUpdateTask::executeTask()
 {
     setStatus(tr("Updating assets index..."));
+    auto components = m_inst->getPackProfile();
+    auto profile = components->getProfile();
+    auto assets = profile->getMinecraftAssets();
+    // the index can be large, so checking what is cached of it is left to the thread pool
+    APPLICATION->metacache()->resolveEntries("asset_indexes", { assets->id + ".json" }, this, [this](QList<MetaEntryPtr> entries) {
+        // aborted meanwhile
+        if (!isRunning())
+            return;
+        downloadIndex(entries.first());
+    });
+}
+
+void AssetUpdateTask::downloadIndex(MetaEntryPtr entry)
+{
     auto components = m_inst->getPackProfile();
     auto profile = components->getProfile();
     auto assets = profile->getMinecraftAssets();
     QUrl indexUrl = assets->url;
-    QString localPath = assets->id + ".json";
     auto job = makeShared<NetJob>(tr("Asset index for %1").arg(m_inst->name()), APPLICATION->network());
 
-    auto metacache = APPLICATION->metacache();
-    auto entry = metacache->resolveEntry("asset_indexes", localPath);
     entry->setStale(true);
     auto hexSha1 = assets->sha1.toLatin1();
     qDebug() << "Asset index SHA1:" << hexSha1;
@@ -63,9 +74,9 @@ void AssetUpdateTask::assetIndexFinished()
     QString asset_fname = "assets/indexes/" + assets->id + ".json";
     // FIXME: this looks like a job for a generic validator based on json schema?
     if (!AssetsUtils::loadAssetsIndexJson(assets->id, asset_fname, index)) {
+        // the entry only has to go, there is no need to check the file first
         auto metacache = APPLICATION->metacache();
-        auto entry = metacache->resolveEntry("asset_indexes", assets->id + ".json");
-        metacache->evictEntry(entry);
+        metacache->evictEntry(metacache->getEntry("asset_indexes", assets->id + ".json"));
         emitFailed(tr("Failed to read the assets index!"));
     }
 
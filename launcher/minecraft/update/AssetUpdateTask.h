@@ -1,4 +1,5 @@
 #pragma once
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 #include "tasks/Task.h"
 class MinecraftInstance;
@@ -22,6 +23,8 @@ class AssetUpdateTask : public Task {
     bool abort() override;
 
    private:
+    void downloadIndex(MetaEntryPtr entry);
+
     MinecraftInstance* m_inst;
     NetJob::Ptr downloadJob;
 };
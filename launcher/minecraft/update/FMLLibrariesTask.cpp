@@ -58,11 +58,25 @@ void FMLLibrariesTask::executeTask()
 
     // download missing libs to our place
     setStatus(tr("Downloading FML libraries..."));
+    QStringList filenames;
+    for (auto& lib : fmlLibsToProcess) {
+        filenames.append(lib.filename);
+    }
+    APPLICATION->metacache()->resolveEntries("fmllibs", filenames, this, [this](QList<MetaEntryPtr> entries) {
+        // aborted meanwhile
+        if (!isRunning())
+            return;
+        startDownloads(entries);
+    });
+}
+
+void FMLLibrariesTask::startDownloads(const QList<MetaEntryPtr>& entries)
+{
     NetJob::Ptr dljob{ new NetJob("FML libraries", APPLICATION->network()) };
-    auto metacache = APPLICATION->metacache();
     Net::Download::Options options = Net::Download::Option::MakeEternal;
-    for (auto& lib : fmlLibsToProcess) {
-        auto entry = metacache->resolveEntry("fmllibs", lib.filename);
+    for (int i = 0; i < fmlLibsToProcess.size(); i++) {
+        auto& lib = fmlLibsToProcess[i];
+        auto entry = entries[i];
         QString urlString = BuildConfig.FMLLIBS_BASE_URL + lib.filename;
         dljob->addNetAction(Net::ApiDownload::makeCached(QUrl(urlString), entry, options));
     }
@@ -118,8 +132,7 @@ bool FMLLibrariesTask::abort()
 {
     if (downloadJob) {
         return downloadJob->abort();
-    } else {
-        qWarning() << "Prematurely aborted FMLLibrariesTask";
     }
-    return true;
+    // still resolving the cache entries, nothing to stop but the task itself
+    return !isRunning() || Task::abort();
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "minecraft/VersionFilterData.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 #include "tasks/Task.h"
 
@@ -23,6 +24,8 @@ class FMLLibrariesTask : public Task {
     bool abort() override;
 
    private:
+    void startDownloads(const QList<MetaEntryPtr>& entries);
+
     MinecraftInstance* m_inst;
     NetJob::Ptr downloadJob;
     QList<FMLlib> fmlLibsToProcess;
@@ -20,18 +20,52 @@ void LibrariesTask::executeTask()
     auto components = inst->getPackProfile();
     auto profile = components->getProfile();
 
+    QList<LibraryPtr> libArtifactPool;
+    libArtifactPool.append(profile->getLibraries());
+    libArtifactPool.append(profile->getNativeLibraries());
+    libArtifactPool.append(profile->getMavenFiles());
+    for (auto agent : profile->getAgents()) {
+        libArtifactPool.append(agent->library());
+    }
+    libArtifactPool.append(profile->getMainJar());
+
+    // verify all cached libraries in one batch, changed files are hashed in parallel and not on this thread
+    QStringList cachedStorages;
+    for (auto lib : libArtifactPool) {
+        if (lib)
+            cachedStorages.append(lib->getCacheStorages(inst->runtimeContext()));
+    }
+    APPLICATION->metacache()->resolveEntries("libraries", cachedStorages, this,
+                                             [this, profile, libArtifactPool, cachedStorages](QList<MetaEntryPtr> entries) {
+                                                 // aborted meanwhile
+                                                 if (!isRunning())
+                                                     return;
+                                                 QHash<QString, MetaEntryPtr> resolved;
+                                                 for (int i = 0; i < cachedStorages.size(); i++) {
+                                                     resolved.insert(cachedStorages[i], entries[i]);
+                                                 }
+                                                 startDownloads(profile, libArtifactPool, resolved);
+                                             });
+}
+
+void LibrariesTask::startDownloads(std::shared_ptr<LaunchProfile> profile,
+                                   const QList<LibraryPtr>& libArtifactPool,
+                                   const QHash<QString, MetaEntryPtr>& resolved)
+{
+    MinecraftInstance* inst = (MinecraftInstance*)m_inst;
     NetJob::Ptr job{ new NetJob(tr("Libraries for instance %1").arg(inst->name()), APPLICATION->network()) };
     downloadJob.reset(job);
 
     auto metacache = APPLICATION->metacache();
 
-    auto processArtifactPool = [this, inst, metacache](const QList<LibraryPtr>& pool, QStringList& errors, const QString& localPath) {
+    auto processArtifactPool = [this, inst, metacache, &resolved](const QList<LibraryPtr>& pool, QStringList& errors,
+                                                                  const QString& localPath) {
         for (auto lib : pool) {
             if (!lib) {
                 emitFailed(tr("Null jar is specified in the metadata, aborting."));
                 return false;
             }
-            auto dls = lib->getDownloads(inst->runtimeContext(), metacache.get(), errors, localPath);
+            auto dls = lib->getDownloads(inst->runtimeContext(), metacache.get(), errors, localPath, resolved);
             for (auto dl : dls) {
                 downloadJob->addNetAction(dl);
             }
@@ -40,18 +74,14 @@ void LibrariesTask::executeTask()
     };
 
     QStringList failedLocalLibraries;
-    QList<LibraryPtr> libArtifactPool;
-    libArtifactPool.append(profile->getLibraries());
-    libArtifactPool.append(profile->getNativeLibraries());
-    libArtifactPool.append(profile->getMavenFiles());
-    for (auto agent : profile->getAgents()) {
-        libArtifactPool.append(agent->library());
+    if (!processArtifactPool(libArtifactPool, failedLocalLibraries, inst->getLocalLibraryPath())) {
+        return;
     }
-    libArtifactPool.append(profile->getMainJar());
-    processArtifactPool(libArtifactPool, failedLocalLibraries, inst->getLocalLibraryPath());
 
     QStringList failedLocalJarMods;
-    processArtifactPool(profile->getJarMods(), failedLocalJarMods, inst->jarModsDir());
+    if (!processArtifactPool(profile->getJarMods(), failedLocalJarMods, inst->jarModsDir())) {
+        return;
+    }
 
     if (!failedLocalJarMods.empty() || !failedLocalLibraries.empty()) {
         downloadJob.reset();
@@ -85,8 +115,7 @@ bool LibrariesTask::abort()
 {
     if (downloadJob) {
         return downloadJob->abort();
-    } else {
-        qWarning() << "Prematurely aborted LibrariesTask";
     }
-    return true;
+    // still resolving the cache entries, nothing to stop but the task itself
+    return !isRunning() || Task::abort();
 }
@@ -1,6 +1,9 @@
 #pragma once
+#include "minecraft/Library.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 #include "tasks/Task.h"
+class LaunchProfile;
 class MinecraftInstance;
 
 class LibrariesTask : public Task {
@@ -20,6 +23,10 @@ class LibrariesTask : public Task {
     bool abort() override;
 
    private:
+    void startDownloads(std::shared_ptr<LaunchProfile> profile,
+                        const QList<LibraryPtr>& libArtifactPool,
+                        const QHash<QString, MetaEntryPtr>& resolved);
+
     MinecraftInstance* m_inst;
     NetJob::Ptr downloadJob;
 };
@@ -51,6 +51,7 @@
 #include "minecraft/PackProfile.h"
 
 #include "modplatform/helpers/OverrideUtils.h"
+#include "modplatform/helpers/ResourceStore.h"
 
 #include "settings/INISettingsObject.h"
 
@@ -65,6 +66,7 @@
 #include "minecraft/World.h"
 #include "minecraft/mod/tasks/LocalResourceParse.h"
 #include "net/ApiDownload.h"
+#include "net/ChecksumValidator.h"
 #include "ui/pages/modplatform/OptionalModDialog.h"
 
 static const FlameAPI api;
@@ -539,6 +541,7 @@ void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
 
         selectedOptionalMods = optionalModDialog.getResult();
     }
+    auto store = APPLICATION->resourceStore();
     for (const auto& result : results) {
         auto fileName = result.version.fileName;
         fileName = FS::RemoveInvalidPathChars(fileName);
@@ -552,8 +555,18 @@ void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
         auto path = FS::PathCombine(m_stagingPath, relpath);
 
         if (!result.version.downloadUrl.isEmpty()) {
+            auto algorithm = Hashing::algorithmFromString(result.version.hash_type);
+            auto hash = result.version.hash;
+            if (store->deploy(algorithm, hash, path))
+                continue;
             qDebug() << "Will download" << result.version.downloadUrl << "to" << path;
             auto dl = Net::ApiDownload::makeFile(result.version.downloadUrl, path);
+            // only a file that matched its hash may be handed to other instances
+            if (ResourceStore::supports(algorithm) && !hash.isEmpty()) {
+                dl->addValidator(new Net::ChecksumValidator(
+                    algorithm == Hashing::Algorithm::Sha1 ? QCryptographicHash::Sha1 : QCryptographicHash::Sha512, hash));
+                connect(dl.get(), &Task::succeeded, [store, path, algorithm, hash] { store->add(path, algorithm, hash); });
+            }
             m_filesJob->addNetAction(dl);
         }
     }
@@ -1,8 +1,13 @@
 #include "HashUtils.h"
 
 #include <QBuffer>
+#include <QDateTime>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
 #include <QtConcurrentRun>
 
 #include <MurmurHash2.h>
@@ -129,6 +134,32 @@ QString hash(QString fileName, Algorithm type)
     return hash(&file, type);
 }
 
+QString cachedHash(QString fileName, Algorithm type)
+{
+    struct Known {
+        qint64 size;
+        QDateTime modified;
+        QString hash;
+    };
+    static QMutex mutex;
+    static QHash<QPair<QString, int>, Known> known;
+
+    QFileInfo info(fileName);
+    QPair<QString, int> key{ info.absoluteFilePath(), static_cast<int>(type) };
+    {
+        QMutexLocker locker(&mutex);
+        auto it = known.constFind(key);
+        if (it != known.constEnd() && it->size == info.size() && it->modified == info.lastModified())
+            return it->hash;
+    }
+    auto result = hash(fileName, type);
+    if (!result.isEmpty()) {
+        QMutexLocker locker(&mutex);
+        known.insert(key, { info.size(), info.lastModified(), result });
+    }
+    return result;
+}
+
 QString hash(QByteArray data, Algorithm type)
 {
     QBuffer buff(&data);
@@ -16,6 +16,8 @@ QString algorithmToString(Algorithm type);
 Algorithm algorithmFromString(QString type);
 QString hash(QIODevice* device, Algorithm type);
 QString hash(QString fileName, Algorithm type);
+// like hash(fileName, type), but remembered for as long as the file keeps its size and modification time
+QString cachedHash(QString fileName, Algorithm type);
 QString hash(QByteArray data, Algorithm type);
 
 class Hasher : public Task {
@@ -0,0 +1,186 @@
+#include "ResourceStore.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QtConcurrentRun>
+
+#include "FileSystem.h"
+
+bool ResourceStore::supports(Hashing::Algorithm algorithm)
+{
+    return algorithm == Hashing::Algorithm::Sha1 || algorithm == Hashing::Algorithm::Sha512;
+}
+
+QString ResourceStore::blobPath(Hashing::Algorithm algorithm, const QString& hash) const
+{
+    auto name = hash.toLower();
+    return FS::PathCombine(m_root, Hashing::algorithmToString(algorithm), name.left(2), name);
+}
+
+bool ResourceStore::deploy(Hashing::Algorithm algorithm, const QString& hash, const QString& target) const
+{
+    if (!supports(algorithm) || hash.isEmpty())
+        return false;
+    auto blob = blobPath(algorithm, hash);
+    if (!QFile::exists(blob))
+        return false;
+
+    if (!place(blob, target)) {
+        qWarning() << "Failed to place" << blob << "at" << target;
+        return false;
+    }
+    // the copy belongs to the instance, unlike the blob
+    QFile::setPermissions(target, QFile::permissions(target) | QFile::WriteOwner);
+    qDebug() << "Placed" << target << "from the resource store";
+    return true;
+}
+
+bool ResourceStore::add(const QString& file, Hashing::Algorithm algorithm, const QString& hash) const
+{
+    if (!supports(algorithm) || hash.isEmpty())
+        return false;
+    auto blob = blobPath(algorithm, hash);
+    if (QFile::exists(blob))
+        return true;
+
+    // place it next to the blob first, so a blob is never seen half written
+    auto temp = blob + ".tmp";
+    QFile::remove(temp);
+    if (!place(file, temp) || !QFile::setPermissions(temp, QFile::ReadOwner | QFile::ReadGroup | QFile::ReadOther) ||
+        !FS::move(temp, blob)) {
+        qWarning() << "Failed to add" << file << "to the resource store";
+        QFile::remove(temp);
+        return false;
+    }
+    return true;
+}
+
+bool ResourceStore::place(const QString& source, const QString& target)
+{
+    if (!FS::ensureFilePathExists(target))
+        return false;
+    if (QFile::exists(target) && !QFile::remove(target))
+        return false;
+
+    std::error_code ec;
+    if (FS::canClone(source, target) && FS::clone_file(source, target, ec))
+        return true;
+    return QFile::copy(source, target);
+}
+
+ResourceStore::Report ResourceStore::collectGarbage(const QStringList& roots, const Progress& progress) const
+{
+    struct Blob {
+        QString path;
+        Hashing::Algorithm algorithm;
+        QString hash;
+        qint64 size;
+        int references = 0;
+        int shared = 0;
+    };
+
+    Report report;
+
+    // the files in the instances are matched by size first, so only a few of them ever get hashed
+    QList<Blob> blobs;
+    QHash<qint64, QList<int>> by_size;
+    for (auto algorithm : { Hashing::Algorithm::Sha1, Hashing::Algorithm::Sha512 }) {
+        QDirIterator it(FS::PathCombine(m_root, Hashing::algorithmToString(algorithm)), QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            auto info = it.fileInfo();
+            if (info.suffix() == "tmp")
+                continue;
+            by_size[info.size()].append(blobs.size());
+            blobs.append({ info.absoluteFilePath(), algorithm, info.fileName(), info.size() });
+            report.blobs++;
+            report.blob_bytes += info.size();
+        }
+    }
+
+    struct Candidate {
+        QString path;
+        qint64 size;
+        bool clones;
+    };
+    QList<Candidate> candidates;
+    for (auto& root : roots) {
+        bool clones = FS::canClone(m_root, root);
+        QDirIterator it(root, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            auto info = it.fileInfo();
+            if (by_size.contains(info.size()))
+                candidates.append({ info.absoluteFilePath(), info.size(), clones });
+        }
+    }
+
+    qint64 done = 0;
+    for (auto& candidate : candidates) {
+        if (progress)
+            progress(done++, candidates.size());
+
+        QHash<int, QString> hashes;
+        for (auto index : by_size.value(candidate.size)) {
+            auto& blob = blobs[index];
+            auto key = static_cast<int>(blob.algorithm);
+            if (!hashes.contains(key))
+                hashes.insert(key, Hashing::hash(candidate.path, blob.algorithm));
+            if (hashes[key] != blob.hash)
+                continue;
+            blob.references++;
+            // copies don't save anything, clones do
+            if (candidate.clones)
+                blob.shared++;
+            break;
+        }
+    }
+    if (progress)
+        progress(candidates.size(), candidates.size());
+
+    for (auto& blob : blobs) {
+        report.shared_files += blob.shared;
+        if (blob.shared > 1)
+            report.saved_bytes += blob.size * (blob.shared - 1);
+        if (blob.references > 0)
+            continue;
+        report.unreferenced.append(blob.path);
+        report.unreferenced_bytes += blob.size;
+    }
+
+    qDebug() << "Resource store:" << report.blobs << "blobs," << report.blob_bytes << "bytes," << report.unreferenced.size()
+             << "unreferenced (" << report.unreferenced_bytes << "bytes)," << report.saved_bytes << "bytes saved by sharing";
+    return report;
+}
+
+int ResourceStore::remove(const QStringList& blobs) const
+{
+    int removed = 0;
+    for (auto& blob : blobs) {
+        // a blob is read-only, which stops removing it on Windows
+        QFile::setPermissions(blob, QFile::permissions(blob) | QFile::WriteOwner);
+        if (QFile::remove(blob))
+            removed++;
+        else
+            qWarning() << "Failed to remove" << blob << "from the resource store";
+    }
+    return removed;
+}
+
+void ResourceStoreScan::executeTask()
+{
+    setStatus(tr("Looking for shared mod files that are no longer used"));
+    auto progress = [this](qint64 done, qint64 total) {
+        QMetaObject::invokeMethod(this, [this, done, total] { setProgress(done, total); }, Qt::QueuedConnection);
+    };
+    m_future = QtConcurrent::run(QThreadPool::globalInstance(), [this, progress] { return m_store->collectGarbage(m_roots, progress); });
+    connect(&m_watcher, &QFutureWatcher<ResourceStore::Report>::finished, this, [this] {
+        m_report = m_future.result();
+        emitSucceeded();
+    });
+    m_watcher.setFuture(m_future);
+}
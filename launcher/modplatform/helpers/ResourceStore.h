@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+#include "modplatform/helpers/HashUtils.h"
+#include "tasks/Task.h"
+
+/* Downloaded resource files, shared by all instances and addressed by their hash.
+ *
+ * Blobs live at <root>/<algorithm>/<first two hex digits>/<hash>. A freshly downloaded file that passed its checksum
+ * is copied into the store, and later installs of the same file get it from there instead of downloading it again.
+ * Files are placed as a reflink where the filesystem supports it and copied otherwise. They are never hard linked, so
+ * changing a file in an instance can't change the blob. Blobs are kept read-only, which makes deploying them cheap:
+ * they are trusted without hashing them again.
+ *
+ * Nothing keeps track of which instances use a blob. collectGarbage() finds that out by looking at them. */
+class ResourceStore {
+   public:
+    struct Report {
+        int blobs = 0;
+        qint64 blob_bytes = 0;
+        // blobs no instance uses anymore, and the space they take
+        QStringList unreferenced;
+        qint64 unreferenced_bytes = 0;
+        // files in the instances that share their data with a blob, and the space that saves over separate copies
+        int shared_files = 0;
+        qint64 saved_bytes = 0;
+    };
+    // how many of the files that could be using a blob were checked so far, out of how many
+    using Progress = std::function<void(qint64 done, qint64 total)>;
+
+    explicit ResourceStore(QString root) : m_root(root) {}
+
+    // only strong hashes identify a file well enough to hand it to another instance
+    static bool supports(Hashing::Algorithm algorithm);
+    QString blobPath(Hashing::Algorithm algorithm, const QString& hash) const;
+
+    // puts the file with this hash at target, if the store has it
+    bool deploy(Hashing::Algorithm algorithm, const QString& hash, const QString& target) const;
+    // shares a downloaded file through the store. only for files whose hash was checked while downloading them
+    bool add(const QString& file, Hashing::Algorithm algorithm, const QString& hash) const;
+
+    // finds the blobs no file under roots uses anymore. hashes files, so better not on the GUI thread
+    Report collectGarbage(const QStringList& roots, const Progress& progress = {}) const;
+    // removes blobs found by collectGarbage(), returns how many of them are gone
+    int remove(const QStringList& blobs) const;
+
+   private:
+    static bool place(const QString& source, const QString& target);
+
+    QString m_root;
+};
+
+/* Runs ResourceStore::collectGarbage() on the thread pool. */
+class ResourceStoreScan : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<ResourceStoreScan>;
+
+    ResourceStoreScan(const ResourceStore* store, QStringList roots) : m_store(store), m_roots(roots) {}
+
+    ResourceStore::Report report() const { return m_report; }
+
+   protected:
+    void executeTask() override;
+
+   private:
+    const ResourceStore* m_store;
+    QStringList m_roots;
+    ResourceStore::Report m_report;
+
+    QFuture<ResourceStore::Report> m_future;
+    QFutureWatcher<ResourceStore::Report> m_watcher;
+};
@@ -71,27 +71,30 @@ void PackInstallTask::downloadPack()
     setAbortable(false);
 
     auto path = QString("%1/%2/%3").arg(m_pack.dir, m_version.replace(".", "_"), m_pack.file);
-    auto entry = APPLICATION->metacache()->resolveEntry("FTBPacks", path);
-    entry->setStale(true);
-    archivePath = entry->getFullPath();
-    netJobContainer.reset(new NetJob("Download FTB Pack", m_network));
-    QString url;
-    if (m_pack.type == PackType::Private) {
-        url = QString(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "privatepacks/%1").arg(path);
-    } else {
-        url = QString(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "modpacks/%1").arg(path);
-    }
-    netJobContainer->addNetAction(Net::ApiDownload::makeCached(url, entry));
+    // a cached pack can be large, so checking it is left to the thread pool
+    APPLICATION->metacache()->resolveEntries("FTBPacks", { path }, this, [this, path](QList<MetaEntryPtr> entries) {
+        auto entry = entries.first();
+        entry->setStale(true);
+        archivePath = entry->getFullPath();
+        netJobContainer.reset(new NetJob("Download FTB Pack", m_network));
+        QString url;
+        if (m_pack.type == PackType::Private) {
+            url = QString(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "privatepacks/%1").arg(path);
+        } else {
+            url = QString(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "modpacks/%1").arg(path);
+        }
+        netJobContainer->addNetAction(Net::ApiDownload::makeCached(url, entry));
 
-    connect(netJobContainer.get(), &NetJob::succeeded, this, &PackInstallTask::unzip);
-    connect(netJobContainer.get(), &NetJob::failed, this, &PackInstallTask::emitFailed);
-    connect(netJobContainer.get(), &NetJob::stepProgress, this, &PackInstallTask::propagateStepProgress);
-    connect(netJobContainer.get(), &NetJob::aborted, this, &PackInstallTask::emitAborted);
+        connect(netJobContainer.get(), &NetJob::succeeded, this, &PackInstallTask::unzip);
+        connect(netJobContainer.get(), &NetJob::failed, this, &PackInstallTask::emitFailed);
+        connect(netJobContainer.get(), &NetJob::stepProgress, this, &PackInstallTask::propagateStepProgress);
+        connect(netJobContainer.get(), &NetJob::aborted, this, &PackInstallTask::emitAborted);
 
-    netJobContainer->start();
+        netJobContainer->start();
 
-    setAbortable(true);
-    progress(1, 4);
+        setAbortable(true);
+        progress(1, 4);
+    });
 }
 
 void PackInstallTask::unzip()
@@ -12,6 +12,7 @@
 #include "minecraft/mod/Mod.h"
 #include "modplatform/EnsureMetadataTask.h"
 #include "modplatform/helpers/OverrideUtils.h"
+#include "modplatform/helpers/ResourceStore.h"
 
 #include "modplatform/modrinth/ModrinthPackManifest.h"
 #include "net/ChecksumValidator.h"
@@ -240,6 +241,7 @@ bool ModrinthCreationTask::createInstance()
     instance.saveNow();
 
     auto downloadMods = makeShared<NetJob>(tr("Mod Download Modrinth"), APPLICATION->network());
+    auto store = APPLICATION->resourceStore();
 
     auto root_modpack_path = FS::PathCombine(m_stagingPath, m_root_path);
     auto root_modpack_url = QUrl::fromLocalFile(root_modpack_path);
@@ -266,17 +268,28 @@ bool ModrinthCreationTask::createInstance()
             setError(tr("The file '%1' is missing a download link. This is invalid in the pack format.").arg(fileName));
             return false;
         }
+        // the index only ever gives sha512 hashes
+        auto hash = QString::fromLatin1(file.hash.toHex());
+        if (file.hashAlgorithm == QCryptographicHash::Sha512 && store->deploy(Hashing::Algorithm::Sha512, hash, file_path))
+            continue;
         qDebug() << "Will try to download" << file.downloads.front() << "to" << file_path;
+        // a failed download also emits succeeded() below, so only one that really went through is shared
+        auto addToStore = [store, file_path, hash, shared = file.hashAlgorithm == QCryptographicHash::Sha512](Task* download) {
+            if (shared && download->wasSuccessful())
+                store->add(file_path, Hashing::Algorithm::Sha512, hash);
+        };
         auto dl = Net::ApiDownload::makeFile(file.downloads.dequeue(), file_path);
         dl->addValidator(new Net::ChecksumValidator(file.hashAlgorithm, file.hash));
+        connect(dl.get(), &Task::succeeded, [addToStore, download = dl.get()] { addToStore(download); });
         downloadMods->addNetAction(dl);
         if (!file.downloads.empty()) {
             // FIXME: This really needs to be put into a ConcurrentTask of
             // MultipleOptionsTask's , once those exist :)
             auto param = dl.toWeakRef();
-            connect(dl.get(), &Task::failed, [&file, file_path, param, downloadMods] {
+            connect(dl.get(), &Task::failed, [&file, file_path, param, downloadMods, addToStore] {
                 auto ndl = Net::ApiDownload::makeFile(file.downloads.dequeue(), file_path);
                 ndl->addValidator(new Net::ChecksumValidator(file.hashAlgorithm, file.hash));
+                connect(ndl.get(), &Task::succeeded, [addToStore, download = ndl.get()] { addToStore(download); });
                 downloadMods->addNetAction(ndl);
                 if (auto shared = param.lock())
                     shared->succeeded();
@@ -19,10 +19,16 @@
 
 #include "Packwiz.h"
 
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QFuture>
+#include <QMutexLocker>
 #include <QObject>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <sstream>
+#include <vector>
 #include <string>
 
 #include "FileSystem.h"
@@ -251,46 +257,46 @@ void V1::deleteModIndex(const QDir& index_dir, QString& mod_slug)
 
 void V1::deleteModIndex(const QDir& index_dir, QVariant& mod_id)
 {
-    for (auto& file_name : index_dir.entryList(QDir::Filter::Files)) {
-        auto mod = getIndexForMod(index_dir, file_name);
-
-        if (mod.mod_id() == mod_id) {
-            deleteModIndex(index_dir, mod.name);
-            break;
-        }
-    }
+    auto index = Index::get(index_dir);
+    index->refresh();
+    auto mod = index->byModId(mod_id);
+    if (mod.isValid())
+        deleteModIndex(index_dir, mod.slug);
 }
 
 auto V1::getIndexForMod(const QDir& index_dir, QString slug) -> Mod
 {
-    Mod mod;
-
     auto normalized_fname = indexFileName(slug);
     auto real_fname = getRealIndexName(index_dir, normalized_fname, true);
     if (real_fname.isEmpty())
         return {};
 
+    return readIndexFile(index_dir.absoluteFilePath(real_fname), slug);
+}
+
+auto V1::readIndexFile(const QString& file_path, QString slug) -> Mod
+{
+    Mod mod;
+
     toml::table table;
 #if TOML_EXCEPTIONS
     try {
-        table = toml::parse_file(StringUtils::toStdString(index_dir.absoluteFilePath(real_fname)));
+        table = toml::parse_file(StringUtils::toStdString(file_path));
     } catch (const toml::parse_error& err) {
-        qWarning() << QString("Could not open file %1!").arg(normalized_fname);
+        qWarning() << QString("Could not open file %1!").arg(file_path);
         qWarning() << "Reason: " << QString(err.what());
         return {};
     }
 #else
-    toml::parse_result result = toml::parse_file(StringUtils::toStdString(index_dir.absoluteFilePath(real_fname)));
+    toml::parse_result result = toml::parse_file(StringUtils::toStdString(file_path));
     if (!result) {
-        qWarning() << QString("Could not open file %1!").arg(normalized_fname);
+        qWarning() << QString("Could not open file %1!").arg(file_path);
         qWarning() << "Reason: " << result.error().description();
         return {};
     }
     table = result.table();
 #endif
 
-    // index_file.close();
-
     mod.slug = slug;
 
     {  // Basic info
@@ -361,14 +367,9 @@ auto V1::getIndexForMod(const QDir& index_dir, QString slug) -> Mod
 
 auto V1::getIndexForMod(const QDir& index_dir, QVariant& mod_id) -> Mod
 {
-    for (auto& file_name : index_dir.entryList(QDir::Filter::Files)) {
-        auto mod = getIndexForMod(index_dir, file_name);
-
-        if (mod.mod_id() == mod_id)
-            return mod;
-    }
-
-    return {};
+    auto index = Index::get(index_dir);
+    index->refresh();
+    return index->byModId(mod_id);
 }
 
 auto V1::sideToString(Side side) -> QString
@@ -395,4 +396,123 @@ auto V1::stringToSide(QString side) -> Side
     return Side::UniversalSide;
 }
 
+Index::Index(const QDir& index_dir) : m_dir(index_dir.absolutePath()) {}
+
+auto Index::get(const QDir& index_dir) -> std::shared_ptr<Index>
+{
+    static QMutex s_lock;
+    static QHash<QString, std::weak_ptr<Index>> s_indexes;
+
+    QMutexLocker locker(&s_lock);
+    auto path = index_dir.absolutePath();
+    auto index = s_indexes.value(path).lock();
+    if (!index) {
+        index = std::make_shared<Index>(index_dir);
+        s_indexes.insert(path, index);
+    }
+    return index;
+}
+
+void Index::refresh()
+{
+    QMutexLocker locker(&m_lock);
+
+    struct Pending {
+        QString file_name;
+        Entry entry;
+    };
+    std::vector<Pending> pending;
+    QMap<QString, Entry> entries;
+    for (auto& info : QDir(m_dir.absolutePath()).entryInfoList(QDir::Files)) {
+        auto modified = info.lastModified().toMSecsSinceEpoch();
+        auto it = m_entries.constFind(info.fileName());
+        if (it != m_entries.constEnd() && it->size == info.size() && it->modified == modified) {
+            entries.insert(info.fileName(), *it);
+        } else {
+            pending.push_back({ info.fileName(), { info.size(), modified, {} } });
+        }
+    }
+
+    // reading a file doesn't touch the index, so they can be spread over the pool
+    QList<QFuture<void>> reading;
+    for (auto& file : pending) {
+        reading.append(QtConcurrent::run(QThreadPool::globalInstance(), [this, &file] {
+            file.entry.mod = V1::readIndexFile(m_dir.absoluteFilePath(file.file_name), file.file_name);
+        }));
+    }
+    for (auto& future : reading)
+        future.waitForFinished();
+    for (auto& file : pending)
+        entries.insert(file.file_name, file.entry);
+
+    if (pending.empty() && entries.size() == m_entries.size())
+        return;
+
+    m_entries = entries;
+    m_by_lower_file.clear();
+    m_by_mod_id.clear();
+    m_by_filename.clear();
+    m_by_hash.clear();
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        auto& mod = it->mod;
+        m_by_lower_file.insert(it.key().toLower(), it.key());
+        if (!mod.isValid())
+            continue;
+        m_by_mod_id.insert(mod.project_id.toString(), it.key());
+        m_by_filename.insert(mod.filename, it.key());
+        if (!mod.hash.isEmpty())
+            m_by_hash.insert(mod.hash, it.key());
+    }
+}
+
+auto Index::byFile(const QString& file_name) const -> Mod
+{
+    auto it = m_entries.constFind(file_name);
+    if (it == m_entries.constEnd() || !it->mod.isValid())
+        return {};
+    return it->mod;
+}
+
+auto Index::mods() const -> QList<Mod>
+{
+    QMutexLocker locker(&m_lock);
+    QList<Mod> mods;
+    for (auto& entry : m_entries) {
+        if (entry.mod.isValid())
+            mods.append(entry.mod);
+    }
+    return mods;
+}
+
+auto Index::bySlug(const QString& slug) const -> Mod
+{
+    QMutexLocker locker(&m_lock);
+    // the same file getRealIndexName would find
+    auto file_name = indexFileName(slug);
+    if (!m_entries.contains(file_name))
+        file_name = m_by_lower_file.value(file_name.toLower());
+    auto mod = byFile(file_name);
+    if (mod.isValid())
+        mod.slug = slug;
+    return mod;
+}
+
+auto Index::byModId(const QVariant& mod_id) const -> Mod
+{
+    QMutexLocker locker(&m_lock);
+    return byFile(m_by_mod_id.value(mod_id.toString()));
+}
+
+auto Index::byFilename(const QString& filename) const -> Mod
+{
+    QMutexLocker locker(&m_lock);
+    return byFile(m_by_filename.value(filename));
+}
+
+auto Index::byHash(const QString& hash) const -> Mod
+{
+    QMutexLocker locker(&m_lock);
+    return byFile(m_by_hash.value(hash));
+}
+
 }  // namespace Packwiz
@@ -21,11 +21,15 @@
 
 #include "modplatform/ModIndex.h"
 
+#include <QDir>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
 #include <QString>
 #include <QUrl>
 #include <QVariant>
 
-class QDir;
+#include <memory>
 
 // Mod from launcher/minecraft/mod/Mod.h
 class Mod;
@@ -103,6 +107,55 @@ class V1 {
 
     static auto sideToString(Side side) -> QString;
     static auto stringToSide(QString side) -> Side;
+
+    /* Reads the mod.pw.toml file at file_path, giving it the provided slug.
+     * If the file isn't a valid metadata file, it returns an empty Mod object.
+     * */
+    static auto readIndexFile(const QString& file_path, QString slug) -> Mod;
+};
+
+/* What is in the metadata files of an index folder, read once and kept in memory.
+ *
+ * refresh() only reads the files that were added or changed since it last ran, several at a time, so it can be
+ * called whenever the folder may have changed. The lookups don't touch the disk. Everything looking into the same
+ * folder shares the same index, see get(). */
+class Index {
+   public:
+    using Mod = V1::Mod;
+
+    explicit Index(const QDir& index_dir);
+
+    // the index of the folder, created if nothing holds one at the moment. it may need a refresh()
+    static auto get(const QDir& index_dir) -> std::shared_ptr<Index>;
+
+    void refresh();
+
+    // the valid ones, by file name. the slug of each is its file name
+    auto mods() const -> QList<Mod>;
+
+    // like V1::getIndexForMod, an empty Mod object if there is none
+    auto bySlug(const QString& slug) const -> Mod;
+    auto byModId(const QVariant& mod_id) const -> Mod;
+    auto byFilename(const QString& filename) const -> Mod;
+    auto byHash(const QString& hash) const -> Mod;
+
+   private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 modified = 0;
+        Mod mod;
+    };
+    auto byFile(const QString& file_name) const -> Mod;
+
+    QDir m_dir;
+    mutable QMutex m_lock;
+    // by the file name in the index folder, invalid ones too so they aren't read again
+    QMap<QString, Entry> m_entries;
+    // to the file name
+    QHash<QString, QString> m_by_lower_file;
+    QHash<QString, QString> m_by_mod_id;
+    QHash<QString, QString> m_by_filename;
+    QHash<QString, QString> m_by_hash;
 };
 
 }  // namespace Packwiz
@@ -44,17 +44,23 @@ void Technic::SingleZipPackInstallTask::executeTask()
     setStatus(tr("Downloading modpack:\n%1").arg(m_sourceUrl.toString()));
 
     const QString path = m_sourceUrl.host() + '/' + m_sourceUrl.path();
-    auto entry = APPLICATION->metacache()->resolveEntry("general", path);
-    entry->setStale(true);
-    m_filesNetJob.reset(new NetJob(tr("Modpack download"), APPLICATION->network()));
-    m_filesNetJob->addNetAction(Net::ApiDownload::makeCached(m_sourceUrl, entry));
-    m_archivePath = entry->getFullPath();
-    auto job = m_filesNetJob.get();
-    connect(job, &NetJob::succeeded, this, &Technic::SingleZipPackInstallTask::downloadSucceeded);
-    connect(job, &NetJob::progress, this, &Technic::SingleZipPackInstallTask::downloadProgressChanged);
-    connect(job, &NetJob::stepProgress, this, &Technic::SingleZipPackInstallTask::propagateStepProgress);
-    connect(job, &NetJob::failed, this, &Technic::SingleZipPackInstallTask::downloadFailed);
-    m_filesNetJob->start();
+    // a cached modpack can be large, so checking it is left to the thread pool
+    APPLICATION->metacache()->resolveEntries("general", { path }, this, [this](QList<MetaEntryPtr> entries) {
+        // aborted meanwhile
+        if (!isRunning())
+            return;
+        auto entry = entries.first();
+        entry->setStale(true);
+        m_filesNetJob.reset(new NetJob(tr("Modpack download"), APPLICATION->network()));
+        m_filesNetJob->addNetAction(Net::ApiDownload::makeCached(m_sourceUrl, entry));
+        m_archivePath = entry->getFullPath();
+        auto job = m_filesNetJob.get();
+        connect(job, &NetJob::succeeded, this, &Technic::SingleZipPackInstallTask::downloadSucceeded);
+        connect(job, &NetJob::progress, this, &Technic::SingleZipPackInstallTask::downloadProgressChanged);
+        connect(job, &NetJob::stepProgress, this, &Technic::SingleZipPackInstallTask::propagateStepProgress);
+        connect(job, &NetJob::failed, this, &Technic::SingleZipPackInstallTask::downloadFailed);
+        m_filesNetJob->start();
+    });
 }
 
 void Technic::SingleZipPackInstallTask::downloadSucceeded()
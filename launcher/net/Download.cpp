@@ -41,14 +41,21 @@
 
 #include <QDateTime>
 #include <QFileInfo>
+#include <algorithm>
 #include <memory>
 
 #include "ByteArraySink.h"
 #include "ChecksumValidator.h"
 #include "MetaCacheSink.h"
+#include "StringUtils.h"
 
 namespace Net {
 
+// smallest range worth a connection of its own
+static constexpr qint64 s_min_segment_size = 4 * 1024 * 1024;
+static constexpr int s_max_segments = 4;
+static constexpr int s_max_segment_tries = 3;
+
 #if defined(LAUNCHER_APPLICATION)
 auto Download::makeCached(QUrl url, MetaEntryPtr entry, Options options) -> Download::Ptr
 {
@@ -87,4 +94,249 @@ QNetworkReply* Download::getReply(QNetworkRequest& request)
 {
     return m_network->get(request);
 }
+
+FileSink* Download::segmentedSink()
+{
+    if (!m_options.testFlag(Option::Segmented) || m_segments_unsupported)
+        return nullptr;
+    auto file_sink = dynamic_cast<FileSink*>(m_sink.get());
+    // an earlier single stream attempt left something to resume, which is cheaper than starting over
+    if (!file_sink || file_sink->hasResumableData())
+        return nullptr;
+    return file_sink;
+}
+
+void Download::executeTask()
+{
+    auto file_sink = segmentedSink();
+    if (!file_sink || getState() == Task::State::AbortedByUser || m_url.isLocalFile()) {
+        NetRequest::executeTask();
+        return;
+    }
+
+    setStatus(tr("Requesting %1").arg(StringUtils::truncateUrlHumanFriendly(m_url, 80)));
+
+    QNetworkRequest request(m_url);
+    m_state = file_sink->initSegmented(request);
+    switch (m_state) {
+        case State::Succeeded:
+            qCDebug(logCat) << getUid().toString() << "Request cache hit " << m_url.toString();
+            emit succeeded();
+            emit finished();
+            return;
+        case State::Running:
+            break;
+        case State::Inactive:
+        case State::Failed:
+            emit failed("Failed to initialize sink");
+            emit finished();
+            return;
+        case State::AbortedByUser:
+            emit aborted();
+            emit finished();
+            return;
+    }
+
+    prepareRequest(request);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+
+    qCDebug(logCat) << getUid().toString() << "Probing for range support" << m_url.toString();
+    m_request_start = m_clock.now();
+    m_time_to_first_byte = -1;
+    m_probe.reset(m_network->head(request));
+    connect(m_probe.get(), &QNetworkReply::finished, this, &Download::probeFinished);
+}
+
+void Download::probeFinished()
+{
+    auto file_sink = static_cast<FileSink*>(m_sink.get());
+    m_time_to_first_byte = std::chrono::duration_cast<std::chrono::milliseconds>(m_clock.now() - m_request_start).count();
+    auto status = m_probe->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (m_probe->error() == QNetworkReply::NoError && status == 304) {
+        // still the same as what we have in the cache
+        m_state = file_sink->finalize(*m_probe);
+        m_probe.reset();
+        if (m_state != State::Succeeded) {
+            emit failed("failed to finalize the request");
+        } else {
+            emit succeeded();
+        }
+        emit finished();
+        return;
+    }
+
+    auto size = m_probe->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+    auto etag = m_probe->rawHeader("ETag");
+    // the segments are tied together with If-Range, which needs a strong validator
+    bool has_validator = (!etag.isEmpty() && !etag.startsWith("W/")) || m_probe->hasRawHeader("Last-Modified");
+    bool accepts_ranges = m_probe->rawHeader("Accept-Ranges").trimmed().toLower() == "bytes";
+
+    if (m_probe->error() != QNetworkReply::NoError || status != 200 || !accepts_ranges || !has_validator ||
+        size < 2 * s_min_segment_size || !file_sink->preallocate(size)) {
+        qCDebug(logCat) << getUid().toString() << "Not splitting" << m_url.toString() << "- status" << status << "size" << size
+                        << "ranges" << accepts_ranges;
+        fallBackToSingleStream();
+        return;
+    }
+
+    int count = static_cast<int>(std::min<qint64>(s_max_segments, size / s_min_segment_size));
+    qCDebug(logCat) << getUid().toString() << "Downloading" << m_url.toString() << "in" << count << "segments";
+
+    m_segmented_size = size;
+    m_last_progress_time = m_clock.now();
+    m_last_progress_bytes = 0;
+    m_segments.assign(count, Segment{});
+    auto segment_size = size / count;
+    for (int i = 0; i < count; i++) {
+        m_segments[i].offset = i * segment_size;
+        m_segments[i].length = i == count - 1 ? size - m_segments[i].offset : segment_size;
+    }
+    for (int i = 0; i < count; i++)
+        startSegment(i);
+}
+
+void Download::startSegment(int index)
+{
+    auto& segment = m_segments[index];
+    segment.tries++;
+
+    // ask for the probed URL directly, the redirects were already followed
+    QNetworkRequest request(m_probe->url());
+    prepareRequest(request);
+    auto first = segment.offset + segment.received;
+    auto last = segment.offset + segment.length - 1;
+    request.setRawHeader("Range", "bytes=" + QByteArray::number(first) + "-" + QByteArray::number(last));
+    auto etag = m_probe->rawHeader("ETag");
+    request.setRawHeader("If-Range", !etag.isEmpty() && !etag.startsWith("W/") ? etag : m_probe->rawHeader("Last-Modified"));
+
+    segment.reply.reset(m_network->get(request));
+    connect(segment.reply.get(), &QNetworkReply::readyRead, this, [this, index] { segmentReadyRead(index); });
+    connect(segment.reply.get(), &QNetworkReply::finished, this, [this, index] { segmentFinished(index); });
+}
+
+void Download::segmentReadyRead(int index)
+{
+    if (m_state != State::Running)
+        return;
+
+    auto& segment = m_segments[index];
+    auto data = segment.reply->readAll();
+    countReceived(data.size());
+    // anything but a 206 is handled once the reply finishes
+    if (segment.reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
+        return;
+    if (data.size() > segment.length - segment.received) {
+        failSegmented(tr("Server sent more data than requested"));
+        return;
+    }
+
+    m_state = static_cast<FileSink*>(m_sink.get())->writeAt(segment.offset + segment.received, data);
+    if (m_state != State::Running) {
+        failSegmented(tr("failed to write in sink"));
+        return;
+    }
+    segment.received += data.size();
+
+    qint64 received = 0;
+    for (auto& s : m_segments)
+        received += s.received;
+    onProgress(received, m_segmented_size);
+}
+
+void Download::segmentFinished(int index)
+{
+    if (m_state != State::Running)
+        return;
+
+    auto& segment = m_segments[index];
+    auto status = segment.reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (segment.reply->error() == QNetworkReply::NoError && status == 206 && segment.received == segment.length) {
+        bool done = std::all_of(m_segments.begin(), m_segments.end(), [](const Segment& s) { return s.received == s.length; });
+        if (done)
+            finishSegmented();
+        return;
+    }
+
+    if (status == 200) {
+        // the file changed since the probe, or the server ignored the range after all
+        qCWarning(logCat) << getUid().toString() << "Server sent the whole file for a segment of" << m_url.toString();
+        fallBackToSingleStream();
+        return;
+    }
+
+    if (segment.tries < s_max_segment_tries) {
+        qCWarning(logCat) << getUid().toString() << "Segment" << index << "of" << m_url.toString() << "failed at"
+                          << segment.received << "/" << segment.length << "bytes, retrying:" << segment.reply->errorString();
+        startSegment(index);
+        return;
+    }
+
+    failSegmented(segment.reply->errorString());
+}
+
+void Download::finishSegmented()
+{
+    m_state = static_cast<FileSink*>(m_sink.get())->finalizeSegmented(*m_probe);
+    m_probe.reset();
+    m_segments.clear();
+    if (m_state != State::Succeeded) {
+        qCDebug(logCat) << getUid().toString() << "Request failed to finalize:" << m_url.toString();
+        m_sink->abort();
+        emit failed("failed to finalize the request");
+        emit finished();
+        return;
+    }
+
+    qCDebug(logCat) << getUid().toString() << "Request succeeded:" << m_url.toString();
+    emit succeeded();
+    emit finished();
+}
+
+void Download::failSegmented(const QString& reason)
+{
+    qCCritical(logCat) << getUid().toString() << "Segmented download of" << m_url.toString() << "failed:" << reason;
+    m_state = State::Failed;
+    abortSegments();
+    m_sink->abort();
+    emit failed(reason);
+    emit finished();
+}
+
+void Download::fallBackToSingleStream()
+{
+    abortSegments();
+    m_segments_unsupported = true;
+    m_state = State::Inactive;
+    NetRequest::executeTask();
+}
+
+void Download::abortSegments()
+{
+    for (auto& segment : m_segments) {
+        if (segment.reply) {
+            disconnect(segment.reply.get(), nullptr, this, nullptr);
+            segment.reply->abort();
+        }
+    }
+    m_segments.clear();
+    if (m_probe) {
+        disconnect(m_probe.get(), nullptr, this, nullptr);
+        m_probe->abort();
+        m_probe.reset();
+    }
+}
+
+auto Download::abort() -> bool
+{
+    if (!m_probe && m_segments.empty())
+        return NetRequest::abort();
+
+    m_state = State::AbortedByUser;
+    abortSegments();
+    m_sink->abort();
+    emit aborted();
+    emit finished();
+    return true;
+}
 }  // namespace Net
@@ -41,6 +41,7 @@
 #include "HttpMetaCache.h"
 
 #include "QObjectPtr.h"
+#include "net/FileSink.h"
 #include "net/NetRequest.h"
 
 namespace Net {
@@ -57,7 +58,40 @@ class Download : public NetRequest {
     static auto makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, Options options = Option::NoOptions) -> Download::Ptr;
     static auto makeFile(QUrl url, QString path, Options options = Option::NoOptions) -> Download::Ptr;
 
+    auto abort() -> bool override;
+
    protected:
     virtual QNetworkReply* getReply(QNetworkRequest&) override;
+
+   protected slots:
+    void executeTask() override;
+
+   private:
+    /* One byte range of a segmented download. Each one has its own reply and is retried on its own. */
+    struct Segment {
+        qint64 offset = 0;
+        qint64 length = 0;
+        qint64 received = 0;
+        int tries = 0;
+        shared_qobject_ptr<QNetworkReply> reply;
+    };
+
+    auto segmentedSink() -> FileSink*;
+    void probeFinished();
+    void startSegment(int index);
+    void segmentReadyRead(int index);
+    void segmentFinished(int index);
+    void finishSegmented();
+    void failSegmented(const QString& reason);
+    void fallBackToSingleStream();
+    void abortSegments();
+
+   private:
+    // HEAD request checking whether the server can serve ranges
+    shared_qobject_ptr<QNetworkReply> m_probe;
+    std::vector<Segment> m_segments;
+    qint64 m_segmented_size = 0;
+    // set once the server turned out not to support segments, so retries don't probe again
+    bool m_segments_unsupported = false;
 };
 }  // namespace Net
@@ -35,12 +35,29 @@
 
 #include "FileSink.h"
 
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QSet>
+
+#include <algorithm>
+
 #include "FileSystem.h"
+#include "Json.h"
 
 #include "net/Logging.h"
 
 namespace Net {
 
+namespace {
+// the partial files being written right now
+QMutex s_active_lock;
+QSet<QString> s_active_partials;
+}  // namespace
+
 Task::State FileSink::init(QNetworkRequest& request)
 {
     auto result = initCache(request);
@@ -55,9 +72,40 @@ Task::State FileSink::init(QNetworkRequest& request)
     }
 
     wroteAnyData = false;
-    m_output_file.reset(new PSaveFile(m_filename));
-    if (!m_output_file->open(QIODevice::WriteOnly)) {
-        qCCritical(taskNetLogC) << "Could not open " + m_filename + " for writing";
+    m_resumable = false;
+    m_resume_offset = 0;
+    m_headers_handled = false;
+    m_ignore_body = false;
+    m_output_file.reset(new QFile(partialPath()));
+    setActive(true);
+
+    // pick up where a previous attempt left off, if it left enough information to do that safely
+    QByteArray resume_validator;
+    qint64 total_size = -1;
+    if (m_output_file->exists() && QFile::exists(partialInfoPath())) {
+        try {
+            auto info = Json::requireObject(Json::requireDocument(partialInfoPath()));
+            resume_validator = Json::ensureString(info, "validator").toLatin1();
+            total_size = Json::ensureDouble(info, "size", -1);
+        } catch (const Exception& e) {
+            qCWarning(taskNetLogC) << "Ignoring unreadable partial download info for" << m_filename << ":" << e.cause();
+        }
+    }
+    auto partial_size = m_output_file->size();
+    if (!resume_validator.isEmpty() && partial_size > 0 && (total_size < 0 || partial_size < total_size)) {
+        qCDebug(taskNetLogC) << "Resuming download of" << m_filename << "at" << partial_size << "bytes";
+        m_resume_offset = partial_size;
+        // still worth keeping if this attempt fails before the server answers
+        m_resumable = true;
+        m_resume_validator = resume_validator;
+        m_total_size = total_size;
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(partial_size) + "-");
+        request.setRawHeader("If-Range", resume_validator);
+    }
+
+    auto mode = m_resume_offset > 0 ? QIODevice::WriteOnly | QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate;
+    if (!m_output_file->open(mode)) {
+        qCCritical(taskNetLogC) << "Could not open " + partialPath() + " for writing";
         return Task::State::Failed;
     }
 
@@ -66,12 +114,63 @@ Task::State FileSink::init(QNetworkRequest& request)
     return Task::State::Failed;
 }
 
+Task::State FileSink::receivedHeaders(QNetworkReply& reply)
+{
+    if (!m_output_file)
+        return Task::State::Running;
+
+    auto statusCode = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    bool handled = m_headers_handled;
+    if (statusCode == 206 || statusCode == 200 || statusCode == 203 || statusCode == 416)
+        m_headers_handled = true;
+    if (handled)
+        return Task::State::Running;
+
+    if (statusCode == 206) {
+        // Content-Range: bytes <first>-<last>/<total or *>
+        auto content_range = QString::fromLatin1(reply.rawHeader("Content-Range"));
+        static const QRegularExpression s_content_range("^bytes (\\d+)-\\d+/(\\d+|\\*)$");
+        auto match = s_content_range.match(content_range.trimmed());
+        if (!match.hasMatch() || match.captured(1).toLongLong() != m_resume_offset) {
+            qCWarning(taskNetLogC) << "Server sent an unexpected range" << content_range << "for" << m_filename;
+            discardPartial();
+            return Task::State::Failed;
+        }
+
+        // the validators have to see the whole file, including what we already had
+        if (!feedPartialToValidators()) {
+            discardPartial();
+            return Task::State::Failed;
+        }
+        wroteAnyData = true;
+        checkResumable(reply, match.captured(2) == "*" ? -1 : match.captured(2).toLongLong());
+    } else if (statusCode == 200 || statusCode == 203) {
+        if (m_resume_offset > 0) {
+            // the server ignored the range, or the file changed since. start over.
+            qCDebug(taskNetLogC) << "Server sent the whole file, restarting download of" << m_filename;
+            m_output_file->resize(0);
+            m_resume_offset = 0;
+        }
+        checkResumable(reply, reply.header(QNetworkRequest::ContentLengthHeader).toLongLong());
+    } else if (statusCode == 416) {
+        // what we have doesn't fit the file on the server anymore
+        discardPartial();
+    } else {
+        // an error page or a redirect is not part of the file, and must not end up in what a later attempt resumes from
+        m_resumable = false;
+        m_ignore_body = true;
+    }
+
+    return Task::State::Running;
+}
+
 Task::State FileSink::write(QByteArray& data)
 {
+    if (m_ignore_body)
+        return Task::State::Running;
     if (!writeAllValidators(data) || m_output_file->write(data) != data.size()) {
         qCCritical(taskNetLogC) << "Failed writing into " + m_filename;
-        m_output_file->cancelWriting();
-        m_output_file.reset();
+        discardPartial();
         wroteAnyData = false;
         return Task::State::Failed;
     }
@@ -82,7 +181,18 @@ Task::State FileSink::write(QByteArray& data)
 
 Task::State FileSink::abort()
 {
-    m_output_file->cancelWriting();
+    if (m_output_file) {
+        m_output_file->close();
+        // keep what we got if the next attempt can continue from it
+        if (m_resumable && m_output_file->size() > 0) {
+            qCDebug(taskNetLogC) << "Keeping" << m_output_file->size() << "bytes of" << m_filename << "to resume later";
+            writePartialInfo();
+        } else {
+            discardPartial();
+        }
+        m_output_file.reset();
+    }
+    setActive(false);
     failAllValidators();
     return Task::State::Failed;
 }
@@ -95,7 +205,7 @@ Task::State FileSink::finalize(QNetworkReply& reply)
     int statusCode = statusCodeV.toInt(&validStatus);
     if (validStatus) {
         // this leaves out 304 Not Modified
-        gotFile = statusCode == 200 || statusCode == 203;
+        gotFile = statusCode == 200 || statusCode == 203 || statusCode == 206;
     }
 
     // if we wrote any data to the save file, we try to commit the data to the real file.
@@ -103,23 +213,196 @@ Task::State FileSink::finalize(QNetworkReply& reply)
     if (gotFile || wroteAnyData) {
         // ask validators for data consistency
         // we only do this for actual downloads, not 'your data is still the same' cache hits
-        if (!finalizeAllValidators(reply))
+        if (!finalizeAllValidators(reply)) {
+            // there is no point in resuming a download that turned out to be bad
+            discardPartial();
             return Task::State::Failed;
+        }
 
         // nothing went wrong...
-        if (!m_output_file->commit()) {
+        m_output_file->close();
+        if (!FS::move(partialPath(), m_filename)) {
             qCCritical(taskNetLogC) << "Failed to commit changes to " << m_filename;
-            m_output_file->cancelWriting();
+            discardPartial();
             return Task::State::Failed;
         }
+        QFile::remove(partialInfoPath());
+    } else {
+        discardPartial();
     }
 
     // then get rid of the save file
     m_output_file.reset();
+    setActive(false);
 
     return finalizeCache(reply);
 }
 
+void FileSink::checkResumable(QNetworkReply& reply, qint64 total_size)
+{
+    // If-Range needs a strong validator, so weak ETags can't be used
+    auto etag = reply.rawHeader("ETag");
+    auto validator = etag.startsWith("W/") ? QByteArray() : etag;
+    if (validator.isEmpty())
+        validator = reply.rawHeader("Last-Modified");
+
+    auto statusCode = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    bool accepts_ranges = statusCode == 206 || reply.rawHeader("Accept-Ranges").trimmed().toLower() == "bytes";
+
+    m_resumable = accepts_ranges && !validator.isEmpty();
+    m_resume_validator = validator;
+    m_total_size = total_size;
+}
+
+void FileSink::writePartialInfo()
+{
+    QJsonObject info;
+    Json::writeString(info, "validator", QString::fromLatin1(m_resume_validator));
+    info.insert("size", double(m_total_size));
+    try {
+        Json::write(info, partialInfoPath());
+    } catch (const Exception& e) {
+        qCWarning(taskNetLogC) << "Failed to save partial download info for" << m_filename << ":" << e.cause();
+        discardPartial();
+    }
+}
+
+bool FileSink::feedPartialToValidators()
+{
+    QFile partial(partialPath());
+    if (!partial.open(QIODevice::ReadOnly)) {
+        qCWarning(taskNetLogC) << "Failed to read partial download" << partialPath();
+        return false;
+    }
+
+    // only what we asked the server to skip, in case more was written after that
+    qint64 remaining = m_resume_offset;
+    while (remaining > 0) {
+        auto chunk = partial.read(std::min<qint64>(remaining, 1024 * 1024));
+        if (chunk.isEmpty())
+            return false;
+        if (!writeAllValidators(chunk))
+            return false;
+        remaining -= chunk.size();
+    }
+    return true;
+}
+
+void FileSink::discardPartial()
+{
+    m_resumable = false;
+    m_resume_offset = 0;
+    if (m_output_file)
+        m_output_file->close();
+    QFile::remove(partialPath());
+    QFile::remove(partialInfoPath());
+    setActive(false);
+}
+
+bool FileSink::hasResumableData() const
+{
+    return QFile::exists(partialPath()) && QFile::exists(partialInfoPath());
+}
+
+Task::State FileSink::initSegmented(QNetworkRequest& request)
+{
+    auto result = initCache(request);
+    if (result != Task::State::Running) {
+        return result;
+    }
+
+    if (!FS::ensureFilePathExists(m_filename)) {
+        qCCritical(taskNetLogC) << "Could not create folder for " + m_filename;
+        return Task::State::Failed;
+    }
+
+    wroteAnyData = false;
+    m_resumable = false;
+    m_resume_offset = 0;
+    m_headers_handled = false;
+    m_ignore_body = false;
+    setActive(true);
+    // the ranges arrive out of order, so what is left after a failure can't be resumed
+    QFile::remove(partialInfoPath());
+    m_output_file.reset(new QFile(partialPath()));
+    if (!m_output_file->open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qCCritical(taskNetLogC) << "Could not open " + partialPath() + " for writing";
+        return Task::State::Failed;
+    }
+
+    if (initAllValidators(request))
+        return Task::State::Running;
+    return Task::State::Failed;
+}
+
+bool FileSink::preallocate(qint64 size)
+{
+    if (!m_output_file || !m_output_file->resize(size)) {
+        qCWarning(taskNetLogC) << "Failed to allocate" << size << "bytes for" << m_filename;
+        return false;
+    }
+    return true;
+}
+
+Task::State FileSink::writeAt(qint64 offset, const QByteArray& data)
+{
+    if (!m_output_file || !m_output_file->seek(offset) || m_output_file->write(data) != data.size()) {
+        qCCritical(taskNetLogC) << "Failed writing into " + m_filename;
+        discardPartial();
+        wroteAnyData = false;
+        return Task::State::Failed;
+    }
+
+    wroteAnyData = true;
+    return Task::State::Running;
+}
+
+Task::State FileSink::finalizeSegmented(QNetworkReply& reply)
+{
+    // the validators only ever see the file in order, so they get it in one go now that it is complete
+    if (!m_output_file || !m_output_file->flush() || !m_output_file->seek(0)) {
+        discardPartial();
+        return Task::State::Failed;
+    }
+    while (!m_output_file->atEnd()) {
+        auto chunk = m_output_file->read(1024 * 1024);
+        if (chunk.isEmpty() || !writeAllValidators(chunk)) {
+            qCWarning(taskNetLogC) << "Failed to read back" << partialPath();
+            discardPartial();
+            return Task::State::Failed;
+        }
+    }
+
+    wroteAnyData = true;
+    return finalize(reply);
+}
+
+void FileSink::setActive(bool active)
+{
+    if (active == m_active)
+        return;
+    m_active = active;
+    QMutexLocker locker(&s_active_lock);
+    if (active) {
+        s_active_partials.insert(QFileInfo(partialPath()).absoluteFilePath());
+    } else {
+        s_active_partials.remove(QFileInfo(partialPath()).absoluteFilePath());
+    }
+}
+
+bool FileSink::isPartialFile(const QString& path)
+{
+    // a file of the user's that merely ends in .part isn't one of ours, ours come in pairs or are being written
+    if (path.endsWith(".part.json"))
+        return QFile::exists(path.chopped(5));
+    if (!path.endsWith(".part"))
+        return false;
+    if (QFile::exists(path + ".json"))
+        return true;
+    QMutexLocker locker(&s_active_lock);
+    return s_active_partials.contains(QFileInfo(path).absoluteFilePath());
+}
+
 Task::State FileSink::initCache(QNetworkRequest&)
 {
     return Task::State::Running;
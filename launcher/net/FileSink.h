@@ -35,30 +35,71 @@
 
 #pragma once
 
-#include "PSaveFile.h"
+#include <QFile>
+
 #include "Sink.h"
 
 namespace Net {
+/* Writes the download into <filename>.part and moves it into place once it is complete and validated.
+ *
+ * If the server supports range requests and identifies the file with an ETag or Last-Modified,
+ * the partial file is kept after a failure, and only then <filename>.part.json describing it is written.
+ * The next attempt then asks only for the missing bytes.
+ *
+ * Segmented downloads (see Download) write ranges out of order through writeAt() instead,
+ * and only hand the assembled file to the validators at the end. */
 class FileSink : public Sink {
    public:
     FileSink(QString filename) : m_filename(filename) {};
-    virtual ~FileSink() = default;
+    virtual ~FileSink() { setActive(false); }
 
    public:
     auto init(QNetworkRequest& request) -> Task::State override;
+    auto receivedHeaders(QNetworkReply& reply) -> Task::State override;
     auto write(QByteArray& data) -> Task::State override;
     auto abort() -> Task::State override;
     auto finalize(QNetworkReply& reply) -> Task::State override;
 
     auto hasLocalData() -> bool override;
 
+    // whether the file is the partial file of a download in progress, or one kept to be resumed, or the info about it
+    static auto isPartialFile(const QString& path) -> bool;
+
+    auto hasResumableData() const -> bool;
+    auto initSegmented(QNetworkRequest& request) -> Task::State;
+    auto preallocate(qint64 size) -> bool;
+    auto writeAt(qint64 offset, const QByteArray& data) -> Task::State;
+    auto finalizeSegmented(QNetworkReply& reply) -> Task::State;
+
    protected:
     virtual auto initCache(QNetworkRequest&) -> Task::State;
     virtual auto finalizeCache(QNetworkReply& reply) -> Task::State;
 
+   private:
+    auto partialPath() const -> QString { return m_filename + ".part"; }
+    auto partialInfoPath() const -> QString { return m_filename + ".part.json"; }
+    void checkResumable(QNetworkReply& reply, qint64 total_size);
+    void writePartialInfo();
+    auto feedPartialToValidators() -> bool;
+    void discardPartial();
+    void setActive(bool active);
+
    protected:
     QString m_filename;
     bool wroteAnyData = false;
-    std::unique_ptr<PSaveFile> m_output_file;
+    std::unique_ptr<QFile> m_output_file;
+
+   private:
+    // how much of the file we asked the server to skip
+    qint64 m_resume_offset = 0;
+    // whether the partial file is worth keeping if this attempt fails, and what identifies the file on the server then
+    bool m_resumable = false;
+    QByteArray m_resume_validator;
+    qint64 m_total_size = -1;
+    // the headers of a reply can be reported more than once, they are only acted on the first time
+    bool m_headers_handled = false;
+    // the reply is not the file, so its body is dropped
+    bool m_ignore_body = false;
+    bool m_active = false;
 };
 }  // namespace Net
@@ -0,0 +1,141 @@
+#include "HostScheduler.h"
+
+#include <algorithm>
+
+#include "net/Logging.h"
+
+namespace Net {
+
+HostScheduler::HostScheduler(int initial_limit, int max_limit, int total_limit)
+    : m_initial_limit(std::max(1, initial_limit)), m_max_limit(std::max(m_initial_limit, max_limit)), m_total_limit(std::max(1, total_limit))
+{}
+
+void HostScheduler::add(Task::Ptr task, const QString& host, qint64 expected_size)
+{
+    if (!m_hosts.contains(host)) {
+        m_order.append(host);
+        m_hosts[host].limit = m_initial_limit;
+    }
+    auto& entry = m_hosts[host];
+    bool small = expected_size > 0 && expected_size < s_small_request_size;
+    (small ? entry.small : entry.bulk).enqueue(task);
+    m_pending++;
+}
+
+Task::Ptr HostScheduler::next()
+{
+    if (m_pending == 0 || m_running.size() >= m_total_limit)
+        return nullptr;
+    if (auto task = take(true))
+        return task;
+    return take(false);
+}
+
+Task::Ptr HostScheduler::take(bool small)
+{
+    for (int i = 0; i < m_order.size(); i++) {
+        auto index = (m_turn + i) % m_order.size();
+        auto& host = m_hosts[m_order[index]];
+        auto& queue = small ? host.small : host.bulk;
+        if (queue.isEmpty() || host.in_flight >= host.limit)
+            continue;
+
+        if (host.in_flight == 0 && host.round_done == 0)
+            startRound(host);
+        auto task = queue.dequeue();
+        host.in_flight++;
+        m_running.insert(task.get(), { m_order[index], host.epoch });
+        m_pending--;
+        m_turn = (index + 1) % m_order.size();
+        return task;
+    }
+    return nullptr;
+}
+
+void HostScheduler::finished(Task* task, bool congested, qint64 bytes, qint64 latency_ms)
+{
+    auto it = m_running.find(task);
+    if (it == m_running.end())
+        return;
+    auto running = it.value();
+    m_running.erase(it);
+
+    auto& host = m_hosts[running.host];
+    host.in_flight--;
+
+    if (latency_ms >= 0) {
+        // a response much slower than the fastest one means requests are piling up somewhere
+        if (host.min_latency >= 0 && latency_ms > std::max<qint64>(4 * host.min_latency, host.min_latency + 250))
+            congested = true;
+        if (host.min_latency < 0 || latency_ms < host.min_latency)
+            host.min_latency = latency_ms;
+    }
+
+    if (congested) {
+        if (running.epoch == host.epoch) {
+            decrease(host);
+            qCDebug(taskNetLogC) << "Congestion on" << running.host << "- limiting it to" << host.limit << "requests";
+        }
+        return;
+    }
+
+    host.round_done++;
+    host.round_bytes += std::max<qint64>(0, bytes);
+    if (host.round_done < host.limit)
+        return;
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - host.round_start).count();
+    auto throughput = host.round_bytes / std::max(elapsed, 0.001);
+    if (throughput >= host.last_throughput * 0.9 && host.limit < m_max_limit) {
+        host.limit++;
+        qCDebug(taskNetLogC) << "Allowing" << host.limit << "requests to" << running.host;
+    }
+    host.last_throughput = throughput;
+    startRound(host);
+}
+
+void HostScheduler::release(Task* task)
+{
+    auto it = m_running.find(task);
+    if (it == m_running.end())
+        return;
+    m_hosts[it->host].in_flight--;
+    m_running.erase(it);
+}
+
+void HostScheduler::decrease(Host& host)
+{
+    host.limit = std::max(1, host.limit / 2);
+    host.epoch++;
+    host.last_throughput = 0;
+    startRound(host);
+}
+
+void HostScheduler::startRound(Host& host)
+{
+    host.round_done = 0;
+    host.round_bytes = 0;
+    host.round_start = std::chrono::steady_clock::now();
+}
+
+void HostScheduler::clear()
+{
+    m_hosts.clear();
+    m_order.clear();
+    m_running.clear();
+    m_turn = 0;
+    m_pending = 0;
+}
+
+int HostScheduler::limit(const QString& host) const
+{
+    auto it = m_hosts.constFind(host);
+    return it == m_hosts.constEnd() ? m_initial_limit : it->limit;
+}
+
+int HostScheduler::inFlight(const QString& host) const
+{
+    auto it = m_hosts.constFind(host);
+    return it == m_hosts.constEnd() ? 0 : it->in_flight;
+}
+}  // namespace Net
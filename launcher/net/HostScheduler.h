@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QHash>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+
+#include <chrono>
+
+#include "tasks/Task.h"
+
+namespace Net {
+/* Decides which of the queued requests of a NetJob go out next.
+ *
+ * Every host gets its own limit on requests in flight. The limit adapts AIMD style: it grows by one after
+ * each round of requests that kept up the throughput of the round before, and is halved when a request
+ * reports congestion (a timeout, a 429 or 503, a reset connection, or a response that took far longer than
+ * the fastest one seen). Hosts take turns, and requests known to be small go ahead of everything else,
+ * so a few large jars on one host don't hold up thousands of tiny assets on another.
+ *
+ * The limits of the hosts all work within the total limit, which no number of hosts can go past. */
+class HostScheduler {
+   public:
+    // requests announcing less than this many bytes are served first
+    static constexpr qint64 s_small_request_size = 1024 * 1024;
+
+    HostScheduler(int initial_limit, int max_limit, int total_limit);
+
+    void add(Task::Ptr task, const QString& host, qint64 expected_size);
+    // the next task that may start right now, or nullptr if every host with queued work is at its limit, or all of them together are
+    auto next() -> Task::Ptr;
+    // bytes: how much the request transferred. latency_ms: time to the response headers, -1 if unknown
+    void finished(Task* task, bool congested, qint64 bytes, qint64 latency_ms);
+    // give back a task from next() that didn't start after all
+    void release(Task* task);
+    void clear();
+
+    auto isEmpty() const -> bool { return m_pending == 0; }
+    auto limit(const QString& host) const -> int;
+    auto inFlight(const QString& host) const -> int;
+
+   private:
+    struct Host {
+        QQueue<Task::Ptr> small;
+        QQueue<Task::Ptr> bulk;
+        int in_flight = 0;
+        int limit = 1;
+
+        // bumped on every decrease, so the requests that were already out don't halve the limit again
+        int epoch = 0;
+        qint64 min_latency = -1;
+        double last_throughput = 0;
+
+        // the round in progress
+        int round_done = 0;
+        qint64 round_bytes = 0;
+        std::chrono::steady_clock::time_point round_start;
+    };
+    struct Running {
+        QString host;
+        int epoch;
+    };
+
+    auto take(bool small) -> Task::Ptr;
+    void decrease(Host& host);
+    void startRound(Host& host);
+
+    QHash<QString, Host> m_hosts;
+    // the hosts in the order they take turns
+    QStringList m_order;
+    int m_turn = 0;
+    QHash<Task*, Running> m_running;
+    int m_pending = 0;
+
+    int m_initial_limit;
+    int m_max_limit;
+    int m_total_limit;
+};
+}  // namespace Net
@@ -36,16 +36,41 @@
 #include "HttpMetaCache.h"
 #include "FileSystem.h"
 #include "Json.h"
+#include "PSaveFile.h"
 
 #include <QCryptographicHash>
 #include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QtConcurrentMap>
 
 #include <QDebug>
 
+#include <algorithm>
+#include <vector>
+
+#if defined(Q_OS_UNIX)
+#include <sys/stat.h>
+#endif
+
 #include "net/Logging.h"
 
+namespace {
+// "PMCI" and "PMCJ" in big endian, so the files are recognizable in a hex dump
+constexpr quint32 s_index_magic = 0x504D4349;
+constexpr quint32 s_journal_magic = 0x504D434A;
+// version 1 was the JSON format, version 2 a single binary index for all bases. both are migrated on load.
+constexpr quint32 s_legacy_index_version = 2;
+constexpr quint32 s_index_version = 3;
+constexpr auto s_stream_version = QDataStream::Qt_5_12;
+// a journal is compacted into its snapshot once it outgrows this, or a quarter of the snapshot, whichever is larger
+constexpr int s_min_compaction_records = 4096;
+// magic + version
+constexpr qint64 s_header_size = 2 * sizeof(quint32);
+}  // namespace
+
 auto MetaEntry::getFullPath() -> QString
 {
     // FIXME: make local?
@@ -63,65 +88,145 @@ HttpMetaCache::HttpMetaCache(QString path) : QObject(), m_index_file(path)
 HttpMetaCache::~HttpMetaCache()
 {
     saveBatchingTimer.stop();
-    SaveNow();
+    // a save may have been scheduled and not run yet, so everything pending is written out now
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->dirty || it->journal_records > 0)
+            saveShard(it.key(), *it);
+    }
 }
 
 auto HttpMetaCache::getEntry(QString base, QString resource_path) -> MetaEntryPtr
 {
     // no base. no base path. can't store
-    if (!m_entries.contains(base)) {
+    auto map = selectBase(base);
+    if (!map) {
         // TODO: log problem
         return {};
     }
 
-    EntryMap& map = m_entries[base];
-    if (map.entry_list.contains(resource_path)) {
-        return map.entry_list[resource_path];
+    return map->entry_list.value(resource_path);
+}
+
+auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString expected_etag) -> MetaEntryPtr
+{
+    PendingResolve pending;
+    pending.base = base;
+    pending.resource_path = FS::RemoveInvalidPathChars(resource_path);
+
+    beginResolve(pending, expected_etag);
+    if (pending.needs_hash)
+        pending.md5sum = hashFile(pending.real_path);
+    return finishResolve(pending);
+}
+
+void HttpMetaCache::resolveEntries(QString base,
+                                   QStringList resource_paths,
+                                   QObject* context,
+                                   std::function<void(QList<MetaEntryPtr>)> done)
+{
+    auto batch = std::make_shared<std::vector<PendingResolve>>(resource_paths.size());
+    for (int i = 0; i < resource_paths.size(); i++) {
+        auto& pending = (*batch)[i];
+        pending.base = base;
+        pending.resource_path = FS::RemoveInvalidPathChars(resource_paths[i]);
+        beginResolve(pending, {});
     }
 
-    return {};
+    auto finish = [this, batch, done] {
+        QList<MetaEntryPtr> out;
+        out.reserve(batch->size());
+        for (auto& pending : *batch)
+            out.append(finishResolve(pending));
+        done(out);
+    };
+    if (std::none_of(batch->cbegin(), batch->cend(), [](const PendingResolve& pending) { return pending.needs_hash; })) {
+        finish();
+        return;
+    }
+
+    QPointer<HttpMetaCache> self(this);
+    auto watcher = new QFutureWatcher<void>(context);
+    connect(watcher, &QFutureWatcher<void>::finished, context, [watcher, self, finish] {
+        watcher->deleteLater();
+        if (self)
+            finish();
+    });
+    // hashing doesn't touch the cache, so it can be spread over the pool. the functor keeps the batch alive until it is done
+    watcher->setFuture(QtConcurrent::map(*batch, [batch](PendingResolve& pending) {
+        if (pending.needs_hash)
+            pending.md5sum = hashFile(pending.real_path);
+    }));
 }
 
-auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString expected_etag) -> MetaEntryPtr
+void HttpMetaCache::beginResolve(PendingResolve& pending, const QString& expected_etag)
 {
-    resource_path = FS::RemoveInvalidPathChars(resource_path);
-    auto entry = getEntry(base, resource_path);
+    auto entry = getEntry(pending.base, pending.resource_path);
     // it's not present? generate a default stale entry
     if (!entry) {
-        return staleEntry(base, resource_path);
+        pending.entry = staleEntry(pending.base, pending.resource_path);
+        pending.resolved = true;
+        return;
     }
 
-    auto& selected_base = m_entries[base];
-    QString real_path = FS::PathCombine(selected_base.base_path, resource_path);
-    QFileInfo finfo(real_path);
+    auto& selected_base = m_entries[pending.base];
+    pending.real_path = FS::PathCombine(selected_base.base_path, pending.resource_path);
+    QFileInfo finfo(pending.real_path);
 
     // is the file really there? if not -> stale
     if (!finfo.isFile() || !finfo.isReadable()) {
         // if the file doesn't exist, we disown the entry
-        selected_base.entry_list.remove(resource_path);
-        return staleEntry(base, resource_path);
+        disownEntry(selected_base, pending.resource_path);
+        pending.entry = staleEntry(pending.base, pending.resource_path);
+        pending.resolved = true;
+        return;
     }
 
     if (!expected_etag.isEmpty() && expected_etag != entry->m_etag) {
         // if the etag doesn't match expected, we disown the entry
-        selected_base.entry_list.remove(resource_path);
-        return staleEntry(base, resource_path);
+        disownEntry(selected_base, pending.resource_path);
+        pending.entry = staleEntry(pending.base, pending.resource_path);
+        pending.resolved = true;
+        return;
     }
 
-    // if the file changed, check md5sum
-    qint64 file_last_changed = finfo.lastModified().toUTC().toMSecsSinceEpoch();
+    pending.entry = entry;
+    pending.identity = fileIdentity(finfo);
+
+    // if the file changed, its md5sum has to be checked
+    if (pending.identity.last_changed != entry->m_local_changed_timestamp) {
+        auto verified = m_verified_files.constFind(pending.real_path);
+        if (verified != m_verified_files.constEnd() && verified->identity == pending.identity) {
+            pending.md5sum = verified->md5sum;
+        } else {
+            pending.needs_hash = true;
+        }
+    }
+}
+
+auto HttpMetaCache::finishResolve(PendingResolve& pending) -> MetaEntryPtr
+{
+    if (pending.resolved)
+        return pending.entry;
+
+    auto& selected_base = m_entries[pending.base];
+    auto entry = pending.entry;
+    // changed while the file was being hashed, so what was found out is about an entry that is gone
+    if (selected_base.entry_list.value(pending.resource_path) != entry)
+        return resolveEntry(pending.base, pending.resource_path);
+
+    qint64 file_last_changed = pending.identity.last_changed;
     if (file_last_changed != entry->m_local_changed_timestamp) {
-        QFile input(real_path);
-        input.open(QIODevice::ReadOnly);
-        QString md5sum = QCryptographicHash::hash(input.readAll(), QCryptographicHash::Md5).toHex().constData();
-        if (entry->m_md5sum != md5sum) {
-            selected_base.entry_list.remove(resource_path);
-            return staleEntry(base, resource_path);
+        if (pending.needs_hash)
+            m_verified_files.insert(pending.real_path, { pending.identity, pending.md5sum });
+
+        if (entry->m_md5sum != pending.md5sum) {
+            disownEntry(selected_base, pending.resource_path);
+            return staleEntry(pending.base, pending.resource_path);
         }
 
         // md5sums matched... keep entry and save the new state to file
         entry->m_local_changed_timestamp = file_last_changed;
-        SaveEventually();
+        appendToJournal(selected_base, JournalOp::Update, *entry);
     }
 
     // Get rid of old entries, to prevent cache problems
@@ -129,18 +234,46 @@ auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString ex
     if (entry->isExpired(current_time - (file_last_changed / 1000))) {
         qCWarning(taskNetLogC) << "[HttpMetaCache]"
                                << "Removing cache entry because of old age!";
-        selected_base.entry_list.remove(resource_path);
-        return staleEntry(base, resource_path);
+        disownEntry(selected_base, pending.resource_path);
+        return staleEntry(pending.base, pending.resource_path);
     }
 
     // entry passed all the checks we cared about.
-    entry->m_basePath = getBasePath(base);
+    entry->m_basePath = getBasePath(pending.base);
     return entry;
 }
 
+auto HttpMetaCache::fileIdentity(const QFileInfo& finfo) -> FileIdentity
+{
+    FileIdentity identity;
+    identity.size = finfo.size();
+    identity.last_changed = finfo.lastModified().toUTC().toMSecsSinceEpoch();
+#if defined(Q_OS_UNIX)
+    // catches files that were replaced by a different one with the same size and timestamp
+    struct stat buf;
+    if (::stat(QFile::encodeName(finfo.filePath()).constData(), &buf) == 0)
+        identity.inode = buf.st_ino;
+#endif
+    return identity;
+}
+
+auto HttpMetaCache::hashFile(const QString& path) -> QString
+{
+    QFile input(path);
+    if (!input.open(QIODevice::ReadOnly))
+        return {};
+
+    // addData(QIODevice*) reads the file in small chunks instead of loading all of it
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    if (!hash.addData(&input))
+        return {};
+    return QString::fromLatin1(hash.result().toHex());
+}
+
 auto HttpMetaCache::updateEntry(MetaEntryPtr stale_entry) -> bool
 {
-    if (!m_entries.contains(stale_entry->m_baseId)) {
+    auto map = selectBase(stale_entry->m_baseId);
+    if (!map) {
         qCCritical(taskHttpMetaCacheLogC) << "Cannot add entry with unknown base: " << stale_entry->m_baseId.toLocal8Bit();
         return false;
     }
@@ -150,8 +283,8 @@ auto HttpMetaCache::updateEntry(MetaEntryPtr stale_entry) -> bool
         return false;
     }
 
-    m_entries[stale_entry->m_baseId].entry_list[stale_entry->m_relativePath] = stale_entry;
-    SaveEventually();
+    map->entry_list[stale_entry->m_relativePath] = stale_entry;
+    appendToJournal(*map, JournalOp::Update, *stale_entry);
 
     return true;
 }
@@ -162,22 +295,26 @@ auto HttpMetaCache::evictEntry(MetaEntryPtr entry) -> bool
         return false;
 
     entry->m_stale = true;
-    SaveEventually();
+    if (auto map = selectBase(entry->m_baseId))
+        appendToJournal(*map, JournalOp::Evict, *entry);
     return true;
 }
 
 void HttpMetaCache::evictAll()
 {
-    for (QString& base : m_entries.keys()) {
-        EntryMap& map = m_entries[base];
-        qCDebug(taskHttpMetaCacheLogC) << "Evicting base" << base;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        EntryMap& map = *it;
+        qCDebug(taskHttpMetaCacheLogC) << "Evicting base" << it.key();
+        // no need to journal every single entry, the whole shard gets rewritten
         for (MetaEntryPtr entry : map.entry_list) {
-            if (!evictEntry(entry))
-                qCWarning(taskHttpMetaCacheLogC) << "Unexpected missing cache entry" << entry->m_basePath;
+            entry->m_stale = true;
         }
         map.entry_list.clear();
+        map.loaded = true;
+        map.dirty = true;
         FS::deletePath(map.base_path);
     }
+    SaveEventually();
 }
 
 auto HttpMetaCache::staleEntry(QString base, QString resource_path) -> MetaEntryPtr
@@ -191,6 +328,24 @@ auto HttpMetaCache::staleEntry(QString base, QString resource_path) -> MetaEntry
     return MetaEntryPtr(foo);
 }
 
+auto HttpMetaCache::selectBase(const QString& base) -> EntryMap*
+{
+    auto it = m_entries.find(base);
+    if (it == m_entries.end())
+        return nullptr;
+
+    if (!it->loaded)
+        loadShard(base, *it);
+    return &it.value();
+}
+
+void HttpMetaCache::disownEntry(EntryMap& map, const QString& resource_path)
+{
+    auto entry = map.entry_list.take(resource_path);
+    if (entry)
+        appendToJournal(map, JournalOp::Evict, *entry);
+}
+
 void HttpMetaCache::addBase(QString base, QString base_root)
 {
     // TODO: report error
@@ -200,6 +355,8 @@ void HttpMetaCache::addBase(QString base, QString base_root)
     // TODO: check if the base path is valid
     EntryMap foo;
     foo.base_path = base_root;
+    // without an index file there is nothing to load
+    foo.loaded = m_index_file.isNull();
     m_entries[base] = foo;
 }
 
@@ -217,12 +374,173 @@ void HttpMetaCache::Load()
     if (m_index_file.isNull())
         return;
 
-    QFile index(m_index_file);
-    if (!index.open(QIODevice::ReadOnly))
+    if (QFile::exists(m_index_file))
+        migrateLegacyIndex();
+}
+
+auto HttpMetaCache::shardPath(const QString& base) const -> QString
+{
+    return FS::PathCombine(m_index_file + ".d", base);
+}
+
+void HttpMetaCache::loadShard(const QString& base, EntryMap& map)
+{
+    map.loaded = true;
+
+    auto apply = [&map](JournalOp op, MetaEntryPtr entry) {
+        if (op == JournalOp::Update) {
+            map.entry_list[entry->m_relativePath] = entry;
+        } else {
+            map.entry_list.remove(entry->m_relativePath);
+        }
+    };
+
+    auto path = shardPath(base);
+    readRecords(path, s_index_magic, false, [&map, &apply](JournalOp op, MetaEntryPtr entry) {
+        apply(op, entry);
+        map.snapshot_entries++;
+    });
+    readRecords(path + ".journal", s_journal_magic, true, [&map, &apply](JournalOp op, MetaEntryPtr entry) {
+        apply(op, entry);
+        map.journal_records++;
+    });
+
+    qCDebug(taskHttpMetaCacheLogC) << "Loaded metacache base" << base << "with" << map.entry_list.size() << "entries";
+
+    if (shouldCompact(map))
+        SaveEventually();
+}
+
+auto HttpMetaCache::saveShard(const QString& base, EntryMap& map) -> bool
+{
+    auto path = shardPath(base);
+    if (!FS::ensureFilePathExists(path)) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache: could not create" << path;
+        return false;
+    }
+
+    PSaveFile index(path);
+    if (!index.open(QIODevice::WriteOnly)) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << index.errorString();
+        return false;
+    }
+
+    QDataStream stream(&index);
+    stream.setVersion(s_stream_version);
+    // the entry count is patched in once it is known
+    stream << s_index_magic << s_index_version << quint32(0);
+
+    quint32 count = 0;
+    for (auto entry : map.entry_list) {
+        // do not save stale entries. they are dead.
+        if (entry->m_stale) {
+            continue;
+        }
+
+        writeEntry(stream, *entry);
+        count++;
+    }
+
+    index.seek(s_header_size);
+    stream << count;
+
+    if (stream.status() != QDataStream::Ok || !index.commit()) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << index.errorString();
+        return false;
+    }
+
+    // the snapshot now contains everything the journal did
+    if (map.journal)
+        map.journal->close();
+    QFile::remove(path + ".journal");
+    map.dirty = false;
+    map.journal_records = 0;
+    map.snapshot_entries = count;
+    return true;
+}
+
+void HttpMetaCache::appendToJournal(EntryMap& map, JournalOp op, const MetaEntry& entry)
+{
+    if (m_index_file.isNull())
         return;
 
+    if (!map.journal) {
+        map.journal = std::make_shared<QFile>(shardPath(entry.m_baseId) + ".journal");
+    }
+    if (!map.journal->isOpen()) {
+        if (!FS::ensureFilePathExists(map.journal->fileName()) || !map.journal->open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qCWarning(taskHttpMetaCacheLogC) << "Could not open metacache journal:" << map.journal->errorString();
+            // fall back to rewriting the whole shard later
+            map.dirty = true;
+            SaveEventually();
+            return;
+        }
+    }
+
+    QDataStream stream(map.journal.get());
+    stream.setVersion(s_stream_version);
+    if (map.journal->size() == 0)
+        stream << s_journal_magic << s_index_version;
+    stream << static_cast<quint8>(op);
+    writeEntry(stream, entry);
+    map.journal->flush();
+
+    map.journal_records++;
+    if (shouldCompact(map))
+        SaveEventually();
+}
+
+auto HttpMetaCache::shouldCompact(const EntryMap& map) -> bool
+{
+    return map.journal_records > std::max(s_min_compaction_records, map.snapshot_entries / 4);
+}
+
+void HttpMetaCache::migrateLegacyIndex()
+{
+    qCDebug(taskHttpMetaCacheLogC) << "Migrating metacache index to per-base shards";
+
+    // the old index is authoritative, so start from empty shards
+    for (auto& map : m_entries) {
+        map.entry_list.clear();
+        map.loaded = true;
+        map.dirty = true;
+    }
+
+    auto apply = [this](JournalOp op, MetaEntryPtr entry) {
+        if (!m_entries.contains(entry->m_baseId))
+            return;
+        auto& entry_list = m_entries[entry->m_baseId].entry_list;
+        if (op == JournalOp::Update) {
+            entry_list[entry->m_relativePath] = entry;
+        } else {
+            entry_list.remove(entry->m_relativePath);
+        }
+    };
+
+    if (readRecords(m_index_file, s_index_magic, false, apply)) {
+        readRecords(m_index_file + ".journal", s_journal_magic, true, apply);
+    } else {
+        // not a binary index, so it should be the old JSON format
+        try {
+            loadLegacyJsonIndex(FS::read(m_index_file));
+        } catch (const Exception& e) {
+            qCWarning(taskHttpMetaCacheLogC) << "Error reading cache:" << e.what();
+        }
+    }
+
+    // the old index stays until all of it is in the shards, it is migrated again next time otherwise
+    if (!SaveNow()) {
+        qCWarning(taskHttpMetaCacheLogC) << "Could not migrate the metacache index, keeping" << m_index_file;
+        return;
+    }
+    QFile::remove(m_index_file);
+    QFile::remove(m_index_file + ".journal");
+}
+
+void HttpMetaCache::loadLegacyJsonIndex(const QByteArray& data)
+{
     QJsonParseError parseError;
-    QJsonDocument json = QJsonDocument::fromJson(index.readAll(), &parseError);
+    QJsonDocument json = QJsonDocument::fromJson(data, &parseError);
 
     // Fail if the JSON is invalid.
     if (parseError.error != QJsonParseError::NoError) {
@@ -276,6 +594,86 @@ void HttpMetaCache::Load()
     }
 }
 
+auto HttpMetaCache::readRecords(const QString& path, quint32 expected_magic, bool with_ops, const RecordHandler& handler) -> bool
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    auto size = file.size();
+    if (size < s_header_size)
+        return false;
+
+    // map the file instead of reading it, the strings are copied out of it anyway
+    auto mapped = file.map(0, size);
+    QByteArray data;
+    if (mapped) {
+        data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), size);
+    } else {
+        data = file.readAll();
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(s_stream_version);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != expected_magic) {
+        if (mapped)
+            file.unmap(mapped);
+        return false;
+    }
+
+    // the record layout did not change when the index was split into shards
+    if (version != s_index_version && version != s_legacy_index_version) {
+        qCWarning(taskHttpMetaCacheLogC) << "Ignoring metacache file" << path << "with unknown version" << version;
+    } else if (with_ops) {
+        while (!stream.atEnd()) {
+            quint8 op = 0;
+            stream >> op;
+            auto entry = readEntry(stream);
+            // a record cut short by a crash is simply dropped
+            if (stream.status() != QDataStream::Ok)
+                break;
+            handler(static_cast<JournalOp>(op), entry);
+        }
+    } else {
+        quint32 count = 0;
+        stream >> count;
+        for (quint32 i = 0; i < count; i++) {
+            auto entry = readEntry(stream);
+            if (stream.status() != QDataStream::Ok) {
+                qCWarning(taskHttpMetaCacheLogC) << "Metacache file" << path << "is truncated, read" << i << "of" << count << "entries";
+                break;
+            }
+            handler(JournalOp::Update, entry);
+        }
+    }
+
+    if (mapped)
+        file.unmap(mapped);
+    return true;
+}
+
+void HttpMetaCache::writeEntry(QDataStream& stream, const MetaEntry& entry)
+{
+    stream << entry.m_baseId << entry.m_relativePath << entry.m_md5sum << entry.m_etag << entry.m_local_changed_timestamp
+           << entry.m_remote_changed_timestamp << entry.m_is_eternal << entry.m_current_age << entry.m_max_age;
+}
+
+auto HttpMetaCache::readEntry(QDataStream& stream) -> MetaEntryPtr
+{
+    auto foo = new MetaEntry();
+    stream >> foo->m_baseId >> foo->m_relativePath >> foo->m_md5sum >> foo->m_etag >> foo->m_local_changed_timestamp >>
+        foo->m_remote_changed_timestamp >> foo->m_is_eternal >> foo->m_current_age >> foo->m_max_age;
+
+    // presumed innocent until closer examination
+    foo->m_stale = false;
+
+    return MetaEntryPtr(foo);
+}
+
 void HttpMetaCache::SaveEventually()
 {
     // reset the save timer
@@ -283,46 +681,19 @@ void HttpMetaCache::SaveEventually()
     saveBatchingTimer.start(30000);
 }
 
-void HttpMetaCache::SaveNow()
+bool HttpMetaCache::SaveNow()
 {
     if (m_index_file.isNull())
-        return;
-
-    qCDebug(taskHttpMetaCacheLogC) << "Saving metacache with" << m_entries.size() << "entries";
-
-    QJsonObject toplevel;
-    Json::writeString(toplevel, "version", "1");
-
-    QJsonArray entriesArr;
-    for (auto group : m_entries) {
-        for (auto entry : group.entry_list) {
-            // do not save stale entries. they are dead.
-            if (entry->m_stale) {
-                continue;
-            }
+        return true;
 
-            QJsonObject entryObj;
-            Json::writeString(entryObj, "base", entry->m_baseId);
-            Json::writeString(entryObj, "path", entry->m_relativePath);
-            Json::writeString(entryObj, "md5sum", entry->m_md5sum);
-            Json::writeString(entryObj, "etag", entry->m_etag);
-            entryObj.insert("last_changed_timestamp", QJsonValue(double(entry->m_local_changed_timestamp)));
-            if (!entry->m_remote_changed_timestamp.isEmpty())
-                entryObj.insert("remote_changed_timestamp", QJsonValue(entry->m_remote_changed_timestamp));
-            if (entry->isEternal()) {
-                entryObj.insert("eternal", true);
-            } else {
-                entryObj.insert("current_age", QJsonValue(double(entry->m_current_age)));
-                entryObj.insert("max_age", QJsonValue(double(entry->m_max_age)));
-            }
-            entriesArr.append(entryObj);
-        }
-    }
-    toplevel.insert("entries", entriesArr);
+    // what is in a journal is already saved, the other shards are left alone until theirs gets large
+    bool saved = true;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (!it->dirty && !shouldCompact(*it))
+            continue;
 
-    try {
-        Json::write(toplevel, m_index_file);
-    } catch (const Exception& e) {
-        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << e.what();
+        qCDebug(taskHttpMetaCacheLogC) << "Saving metacache base" << it.key() << "with" << it->entry_list.size() << "entries";
+        saved = saveShard(it.key(), *it) && saved;
     }
+    return saved;
 }
@@ -35,9 +35,14 @@
 
 #pragma once
 
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QMap>
 #include <QString>
 #include <QTimer>
+#include <functional>
 #include <memory>
 
 class HttpMetaCache;
@@ -108,6 +113,14 @@ class HttpMetaCache : public QObject {
     // get the entry from cache and verify that it isn't stale (within reason)
     auto resolveEntry(QString base, QString resource_path, QString expected_etag = QString()) -> MetaEntryPtr;
 
+    /* Same as resolveEntry, for many entries of one base at once. Files that need to be hashed are hashed on the thread pool,
+     * then `done` gets the entries in the same order on this thread, unless `context` is gone by then.
+     * When nothing needs to be hashed, `done` is called before this returns. */
+    void resolveEntries(QString base,
+                        QStringList resource_paths,
+                        QObject* context,
+                        std::function<void(QList<MetaEntryPtr>)> done);
+
     // add a previously resolved stale entry
     auto updateEntry(MetaEntryPtr stale_entry) -> bool;
 
@@ -119,23 +132,98 @@ class HttpMetaCache : public QObject {
 
     // (re)start a timer that calls SaveNow later.
     void SaveEventually();
+    // bases are loaded lazily on first use, this only migrates indexes written by older versions
     void Load();
 
     auto getBasePath(QString base) -> QString;
 
    public slots:
-    void SaveNow();
+    // compact the bases that need it: rewrite their snapshot and drop their journal. returns false if one couldn't be written
+    bool SaveNow();
 
    private:
-    // create a new stale entry, given the parameters
-    auto staleEntry(QString base, QString resource_path) -> MetaEntryPtr;
+    /* Each base is stored in its own shard under m_index_file + ".d": a binary snapshot (<base>) plus an
+     * append-only journal (<base>.journal). Changes are appended to the journal as they happen, and the
+     * snapshot is only rewritten when that base is compacted. */
+    enum class JournalOp : quint8 { Update = 1, Evict = 2 };
 
     struct EntryMap {
         QString base_path;
         QMap<QString, MetaEntryPtr> entry_list;
+
+        bool loaded = false;
+        // the snapshot has to be rewritten even if the journal is empty
+        bool dirty = false;
+        int journal_records = 0;
+        int snapshot_entries = 0;
+        std::shared_ptr<QFile> journal;
+    };
+
+    // create a new stale entry, given the parameters
+    auto staleEntry(QString base, QString resource_path) -> MetaEntryPtr;
+
+    // what identifies the contents of a file on disk without reading it
+    struct FileIdentity {
+        quint64 inode = 0;
+        qint64 size = 0;
+        qint64 last_changed = 0;
+
+        bool operator==(const FileIdentity& other) const
+        {
+            return inode == other.inode && size == other.size && last_changed == other.last_changed;
+        }
     };
+    static auto fileIdentity(const QFileInfo& finfo) -> FileIdentity;
+
+    struct VerifiedFile {
+        FileIdentity identity;
+        QString md5sum;
+    };
+
+    /* Resolving is split in two so the expensive part (hashing a file whose timestamp changed)
+     * can run on a thread pool for a batch of entries, while everything touching the cache stays on the caller's thread. */
+    struct PendingResolve {
+        QString base;
+        QString resource_path;
+        // the cached entry, or the final result if `resolved` is set
+        MetaEntryPtr entry;
+        bool resolved = false;
+
+        QString real_path;
+        FileIdentity identity;
+        bool needs_hash = false;
+        QString md5sum;
+    };
+    void beginResolve(PendingResolve& pending, const QString& expected_etag);
+    auto finishResolve(PendingResolve& pending) -> MetaEntryPtr;
+    // md5 of a file, read in chunks
+    static auto hashFile(const QString& path) -> QString;
+
+    // look up a base, loading its shard if it wasn't used before. nullptr for unknown bases.
+    auto selectBase(const QString& base) -> EntryMap*;
+
+    // remove an entry from its base and record that in the journal
+    void disownEntry(EntryMap& map, const QString& resource_path);
+
+    auto shardPath(const QString& base) const -> QString;
+    void loadShard(const QString& base, EntryMap& map);
+    auto saveShard(const QString& base, EntryMap& map) -> bool;
+    void appendToJournal(EntryMap& map, JournalOp op, const MetaEntry& entry);
+    static auto shouldCompact(const EntryMap& map) -> bool;
+
+    void migrateLegacyIndex();
+    void loadLegacyJsonIndex(const QByteArray& data);
+
+    using RecordHandler = std::function<void(JournalOp, MetaEntryPtr)>;
+    // read a snapshot (with_ops == false) or a journal (with_ops == true). returns false if the file isn't one.
+    static auto readRecords(const QString& path, quint32 expected_magic, bool with_ops, const RecordHandler& handler) -> bool;
+
+    static void writeEntry(QDataStream& stream, const MetaEntry& entry);
+    static auto readEntry(QDataStream& stream) -> MetaEntryPtr;
 
     QMap<QString, EntryMap> m_entries;
+    // files hashed during this session, so a file touched without changes is only hashed once
+    QHash<QString, VerifiedFile> m_verified_files;
     QString m_index_file;
     QTimer saveBatchingTimer;
 };
@@ -37,6 +37,12 @@
 
 #include "NetJob.h"
 #include <QNetworkReply>
+#include <QTimer>
+
+#include <algorithm>
+#include <climits>
+
+#include "net/Logging.h"
 #include "net/NetRequest.h"
 #include "tasks/ConcurrentTask.h"
 #if defined(LAUNCHER_APPLICATION)
@@ -44,9 +50,27 @@
 #include "ui/dialogs/CustomMessageBox.h"
 #endif
 
+// whether a failed request suggests the host is overloaded, rather than the request being bad
+static bool isCongestion(const Net::NetRequest& request)
+{
+    auto status = request.replyStatusCode();
+    if (status == 429 || status == 503 || request.timedOut())
+        return true;
+    switch (request.error()) {
+        case QNetworkReply::TimeoutError:
+        case QNetworkReply::ProxyTimeoutError:
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::TemporaryNetworkFailureError:
+            return true;
+        default:
+            return false;
+    }
+}
+
 NetJob::NetJob(QString job_name, shared_qobject_ptr<QNetworkAccessManager> network, int max_concurrent)
     : ConcurrentTask(job_name), m_network(network)
 {
+    m_per_host = max_concurrent <= 0;
 #if defined(LAUNCHER_APPLICATION)
     if (APPLICATION_DYN && max_concurrent < 0)
         max_concurrent = APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt();
@@ -64,23 +88,150 @@ auto NetJob::addNetAction(Net::NetRequest::Ptr action) -> bool
     return true;
 }
 
+void NetJob::executeTask()
+{
+    m_failures.clear();
+    m_order.clear();
+    for (auto& task : m_queue)
+        m_order.insert(task.get(), m_order.size());
+    m_scheduler.reset();
+    if (m_per_host) {
+        // the setting stays the most that runs at once, a single host can use all of it while it keeps up
+        m_scheduler = std::make_unique<Net::HostScheduler>(m_total_max_size, m_total_max_size, m_total_max_size);
+        for (auto& task : m_queue)
+            schedule(task);
+    }
+    ConcurrentTask::executeTask();
+}
+
+static QString hostOf(const Net::NetRequest* request)
+{
+    return request ? request->url().authority(QUrl::RemoveUserInfo) : QString();
+}
+
+void NetJob::schedule(Task::Ptr task)
+{
+    auto request = dynamic_cast<Net::NetRequest*>(task.get());
+    m_scheduler->add(task, hostOf(request), request ? request->expectedSize() : -1);
+}
+
+auto NetJob::takeNext() -> Task::Ptr
+{
+    if (m_scheduler) {
+        auto next = m_scheduler->next();
+        if (next)
+            m_queue.removeOne(next);
+        return next;
+    }
+    if (m_queue.isEmpty() || m_doing.count() >= m_total_max_size)
+        return nullptr;
+    return m_queue.dequeue();
+}
+
 void NetJob::executeNextSubTask()
 {
-    // We're finished, check for failures and retry if we can (up to 3 times)
-    if (isRunning() && m_queue.isEmpty() && m_doing.isEmpty() && !m_failed.isEmpty() && m_try < 3) {
-        m_try += 1;
-        while (!m_failed.isEmpty()) {
-            auto task = m_failed.take(*m_failed.keyBegin());
-            m_done.remove(task.get());
-            m_queue.enqueue(task);
+    if (!isRunning())
+        return;
+
+    while (auto next = takeNext()) {
+        // don't bother hosts that keep failing until their circuit closes again
+        auto host = hostOf(dynamic_cast<Net::NetRequest*>(next.get()));
+        auto blocked = m_retry_policy->blockedFor(host);
+        if (blocked > 0) {
+            if (m_scheduler)
+                m_scheduler->release(next.get());
+            // waiting isn't an attempt, but a host that failed every request let through to it fails the job instead of stalling it
+            if (m_retry_policy->isDown(host)) {
+                m_failed.insert(next.get(), next);
+                m_done.insert(next.get(), next);
+                updateState();
+            } else {
+                retryLater(next, blocked);
+            }
+            continue;
         }
+        startSubTask(next);
+    }
+
+    // requests waiting for a retry keep the job alive
+    if (m_queue.isEmpty() && m_doing.isEmpty() && m_waiting.isEmpty())
+        ConcurrentTask::executeNextSubTask();
+}
+
+void NetJob::retryLater(Task::Ptr task, qint64 delay_ms)
+{
+    m_waiting.insert(task.get(), task);
+    QTimer::singleShot(delay_ms, this, [this, task] {
+        // gone if the job was aborted in the meantime
+        if (!m_waiting.remove(task.get()))
+            return;
+        requeue(task);
+        executeNextSubTask();
+    });
+}
+
+void NetJob::requeue(Task::Ptr task)
+{
+    if (m_scheduler) {
+        m_queue.enqueue(task);
+        schedule(task);
+        return;
+    }
+    // a fixed number of parallel requests keeps them in order, so it goes back to where it was
+    auto order = m_order.value(task.get(), INT_MAX);
+    auto after = std::find_if(m_queue.begin(), m_queue.end(),
+                              [this, order](const Task::Ptr& queued) { return m_order.value(queued.get(), INT_MAX) > order; });
+    m_queue.insert(after, task);
+}
+
+void NetJob::subTaskFinished(Task::Ptr task, TaskStepState state)
+{
+    auto request = dynamic_cast<Net::NetRequest*>(task.get());
+    if (m_scheduler) {
+        bool congested = state == TaskStepState::Failed && request && isCongestion(*request);
+        m_scheduler->finished(task.get(), congested, request ? request->getProgress() : 0, request ? request->timeToFirstByte() : -1);
+    }
+    ConcurrentTask::subTaskFinished(task, state);
+
+    if (!request)
+        return;
+    if (state == TaskStepState::Succeeded) {
+        m_retry_policy->recordSuccess(hostOf(request));
+        return;
+    }
+    // an aborted request says nothing about the host
+    if (request->getState() == State::AbortedByUser)
+        return;
+    // a bad checksum or a full disk is no reason to stop asking the host, for this job or any other
+    if (request->timedOut() || m_retry_policy->isHostFailure(request->replyStatusCode(), request->error()))
+        m_retry_policy->recordFailure(hostOf(request));
+    if (!isRunning())
+        return;
+
+    auto failures = ++m_failures[task.get()];
+    auto delay = m_retry_policy->retryDelay(*request, failures);
+    if (delay < 0)
+        return;
+
+    qCDebug(taskNetLogC) << "Retrying" << request->url().toString() << "in" << delay << "ms, after" << failures << "failed attempt(s)";
+    m_failed.remove(task.get());
+    m_done.remove(task.get());
+    retryLater(task, delay);
+}
+
+void NetJob::requeueFailed()
+{
+    m_failures.clear();
+    while (!m_failed.isEmpty()) {
+        auto task = m_failed.take(*m_failed.keyBegin());
+        m_done.remove(task.get());
+        requeue(task);
     }
-    ConcurrentTask::executeNextSubTask();
 }
 
 auto NetJob::size() const -> int
 {
-    return m_queue.size() + m_doing.size() + m_done.size();
+    return m_queue.size() + m_doing.size() + m_done.size() + m_waiting.size();
 }
 
 auto NetJob::canAbort() const -> bool
@@ -106,6 +257,11 @@ auto NetJob::abort() -> bool
     for (auto task : m_queue)
         m_failed.insert(task.get(), task);
     m_queue.clear();
+    for (auto task : m_waiting)
+        m_failed.insert(task.get(), task);
+    m_waiting.clear();
+    if (m_scheduler)
+        m_scheduler->clear();
 
     // abort active downloads
     auto toKill = m_doing.values();
@@ -175,7 +331,7 @@ void NetJob::emitFailed(QString reason)
                             ->exec();
 
         if (response == QMessageBox::Yes) {
-            m_try = 0;
+            requeueFailed();
             executeNextSubTask();
             return;
         }
@@ -44,8 +44,19 @@
 
 // Those are included so that they are also included by anyone using NetJob
 #include "net/Download.h"
+#include "net/HostScheduler.h"
 #include "net/HttpMetaCache.h"
+#include "net/RetryPolicy.h"
 
+#include <memory>
+
+/* Runs a set of requests in parallel.
+ *
+ * The NumberOfConcurrentDownloads setting limits how many requests run at once. Unless the job was given
+ * a fixed number of parallel requests, every host also gets its own adaptive limit within that (see
+ * Net::HostScheduler). A fixed number keeps the requests in order, which some jobs depend on.
+ *
+ * Failed requests are tried again after a delay chosen by the Net::RetryPolicy, while the rest of the queue keeps going. */
 class NetJob : public ConcurrentTask {
     Q_OBJECT
 
@@ -63,6 +74,7 @@ class NetJob : public ConcurrentTask {
     auto getFailedActions() -> QList<Net::NetRequest*>;
     auto getFailedFiles() -> QList<QString>;
     void setAskRetry(bool askRetry);
+    void setRetryPolicy(Net::RetryPolicy::Ptr policy) { m_retry_policy = policy; }
 
    public slots:
     // Qt can't handle auto at the start for some reason?
@@ -70,16 +82,35 @@ class NetJob : public ConcurrentTask {
     void emitFailed(QString reason) override;
 
    protected slots:
+    void executeTask() override;
     void executeNextSubTask() override;
+    void subTaskFinished(Task::Ptr task, TaskStepState state) override;
 
    protected:
     void updateState() override;
     bool isOnline();
 
+   private:
+    void schedule(Task::Ptr task);
+    auto takeNext() -> Task::Ptr;
+    void retryLater(Task::Ptr task, qint64 delay_ms);
+    void requeue(Task::Ptr task);
+    void requeueFailed();
+
    private:
     shared_qobject_ptr<QNetworkAccessManager> m_network;
 
-    int m_try = 1;
+    bool m_per_host = false;
+    std::unique_ptr<Net::HostScheduler> m_scheduler;
+
+    Net::RetryPolicy::Ptr m_retry_policy = std::make_shared<Net::RetryPolicy>();
+    // failed attempts of each request so far
+    QHash<Task*, int> m_failures;
+    // where each request was in the queue when the job started
+    QHash<Task*, int> m_order;
+    // failed requests waiting to be tried again
+    QHash<Task*, Task::Ptr> m_waiting;
+
     bool m_ask_retry = true;
     int m_manual_try = 0;
 };
@@ -43,6 +43,7 @@
 #include <QFileInfo>
 #include <QNetworkReply>
 #include <QUrl>
+#include <atomic>
 #include <memory>
 
 #if defined(LAUNCHER_APPLICATION)
@@ -55,6 +56,26 @@
 
 namespace Net {
 
+namespace {
+std::atomic<int> s_sent_requests{ 0 };
+std::atomic<qint64> s_received_bytes{ 0 };
+}  // namespace
+
+int NetRequest::sentRequests()
+{
+    return s_sent_requests;
+}
+
+qint64 NetRequest::receivedBytes()
+{
+    return s_received_bytes;
+}
+
+void NetRequest::countReceived(qint64 bytes)
+{
+    s_received_bytes += bytes;
+}
+
 void NetRequest::addValidator(Validator* v)
 {
     m_sink->addValidator(v);
@@ -71,6 +92,7 @@ void NetRequest::executeTask()
         return;
     }
 
+    m_timed_out = false;
     QNetworkRequest request(m_url);
     m_state = m_sink->init(request);
     switch (m_state) {
@@ -93,27 +115,12 @@ void NetRequest::executeTask()
             return;
     }
 
-#if defined(LAUNCHER_APPLICATION)
-    auto user_agent = APPLICATION->getUserAgent();
-#else
-    auto user_agent = BuildConfig.USER_AGENT;
-#endif
-
-    request.setHeader(QNetworkRequest::UserAgentHeader, user_agent.toUtf8());
-    for (auto& header_proxy : m_headerProxies) {
-        header_proxy->writeHeaders(request);
-    }
-
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-#if defined(LAUNCHER_APPLICATION)
-    request.setTransferTimeout(APPLICATION->settings()->get("RequestTimeout").toInt() * 1000);
-#else
-    request.setTransferTimeout();
-#endif
-#endif
+    prepareRequest(request);
 
     m_last_progress_time = m_clock.now();
     m_last_progress_bytes = 0;
+    m_request_start = m_clock.now();
+    m_time_to_first_byte = -1;
 
     auto rep = getReply(request);
     if (rep == nullptr)  // it failed
@@ -121,6 +128,7 @@ void NetRequest::executeTask()
     m_reply.reset(rep);
     connect(rep, &QNetworkReply::uploadProgress, this, &NetRequest::onProgress);
     connect(rep, &QNetworkReply::downloadProgress, this, &NetRequest::onProgress);
+    connect(rep, &QNetworkReply::metaDataChanged, this, &NetRequest::downloadMetaDataChanged);
     connect(rep, &QNetworkReply::finished, this, &NetRequest::downloadFinished);
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)  // QNetworkReply::errorOccurred added in 5.15
     connect(rep, &QNetworkReply::errorOccurred, this, &NetRequest::downloadError);
@@ -131,6 +139,32 @@ void NetRequest::executeTask()
     connect(rep, &QNetworkReply::readyRead, this, &NetRequest::downloadReadyRead);
 }
 
+void NetRequest::prepareRequest(QNetworkRequest& request)
+{
+    s_sent_requests++;
+    auto user_agent = BuildConfig.USER_AGENT;
+#if defined(LAUNCHER_APPLICATION)
+    if (APPLICATION_DYN)
+        user_agent = APPLICATION->getUserAgent();
+#endif
+
+    request.setHeader(QNetworkRequest::UserAgentHeader, user_agent.toUtf8());
+    for (auto& header_proxy : m_headerProxies) {
+        header_proxy->writeHeaders(request);
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+#if defined(LAUNCHER_APPLICATION)
+    if (APPLICATION_DYN)
+        request.setTransferTimeout(APPLICATION->settings()->get("RequestTimeout").toInt() * 1000);
+    else
+        request.setTransferTimeout();
+#else
+    request.setTransferTimeout();
+#endif
+#endif
+}
+
 void NetRequest::onProgress(qint64 bytesReceived, qint64 bytesTotal)
 {
     auto now = m_clock.now();
@@ -165,6 +199,8 @@ void NetRequest::downloadError(QNetworkReply::NetworkError error)
 {
     if (error == QNetworkReply::OperationCanceledError) {
         qCCritical(logCat) << getUid().toString() << "Aborted " << m_url.toString();
+        // user aborts don't get here, and a rejected response has already failed, so this is the transfer timeout
+        m_timed_out = m_state == State::Running;
         m_state = State::Failed;
     } else {
         if (m_options & Option::AcceptLocalFiles) {
@@ -278,6 +314,7 @@ void NetRequest::downloadFinished()
 
     // make sure we got all the remaining data, if any
     auto data = m_reply->readAll();
+    countReceived(data.size());
     if (data.size()) {
         qCDebug(logCat) << getUid().toString() << "Writing extra" << data.size() << "bytes";
         m_state = m_sink->write(data);
@@ -305,10 +342,27 @@ void NetRequest::downloadFinished()
     emit finished();
 }
 
+void NetRequest::downloadMetaDataChanged()
+{
+    if (m_state != State::Running)
+        return;
+
+    if (m_time_to_first_byte < 0)
+        m_time_to_first_byte = std::chrono::duration_cast<std::chrono::milliseconds>(m_clock.now() - m_request_start).count();
+
+    m_state = m_sink->receivedHeaders(*m_reply.get());
+    if (m_state == State::Failed) {
+        qCCritical(logCat) << getUid().toString() << "Sink rejected the response headers";
+        // no point in downloading the body
+        m_reply->abort();
+    }
+}
+
 void NetRequest::downloadReadyRead()
 {
     if (m_state == State::Running) {
         auto data = m_reply->readAll();
+        countReceived(data.size());
         m_state = m_sink->write(data);
         if (m_state == State::Failed) {
             qCCritical(logCat) << getUid().toString() << "Failed to process response chunk";
@@ -352,4 +406,9 @@ QString NetRequest::errorString() const
 {
     return m_reply ? m_reply->errorString() : "";
 }
+
+QByteArray NetRequest::replyHeader(const QByteArray& name) const
+{
+    return m_reply ? m_reply->rawHeader(name) : QByteArray();
+}
 }  // namespace Net
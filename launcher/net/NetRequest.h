@@ -60,7 +60,8 @@ class NetRequest : public Task {
 
    public:
     using Ptr = shared_qobject_ptr<class NetRequest>;
-    enum class Option { NoOptions = 0, AcceptLocalFiles = 1, MakeEternal = 2 };
+    // Segmented: split large files into ranges that are fetched in parallel, if the server allows it. Only for downloads to files.
+    enum class Option { NoOptions = 0, AcceptLocalFiles = 1, MakeEternal = 2, Segmented = 4 };
     Q_DECLARE_FLAGS(Options, Option)
 
    public:
@@ -74,9 +75,26 @@ class NetRequest : public Task {
 
     QUrl url() const;
     void setUrl(QUrl url) { m_url = url; }
+    // how large the response is expected to be, -1 if unknown. NetJob sends small requests first.
+    void setExpectedSize(qint64 size) { m_expected_size = size; }
+    qint64 expectedSize() const { return m_expected_size; }
     int replyStatusCode() const;
     QNetworkReply::NetworkError error() const;
     QString errorString() const;
+    QByteArray replyHeader(const QByteArray& name) const;
+    // milliseconds between sending the request and receiving the response headers, -1 if there was no response
+    qint64 timeToFirstByte() const { return m_time_to_first_byte; }
+    // whether the request was cancelled because the transfer timeout ran out, not by an abort
+    bool timedOut() const { return m_timed_out; }
+
+    // what all the requests of this session sent and received so far, for the launch trace
+    static int sentRequests();
+    static qint64 receivedBytes();
+
+   protected:
+    // set the headers and timeouts every request shares
+    void prepareRequest(QNetworkRequest& request);
+    static void countReceived(qint64 bytes);
 
    private:
     auto handleRedirect() -> bool;
@@ -87,6 +105,7 @@ class NetRequest : public Task {
     void downloadError(QNetworkReply::NetworkError error);
     void sslErrors(const QList<QSslError>& errors);
     void downloadFinished();
+    void downloadMetaDataChanged();
     void downloadReadyRead();
     void executeTask() override;
 
@@ -100,6 +119,9 @@ class NetRequest : public Task {
     std::chrono::steady_clock m_clock;
     std::chrono::time_point<std::chrono::steady_clock> m_last_progress_time;
     qint64 m_last_progress_bytes;
+    std::chrono::time_point<std::chrono::steady_clock> m_request_start;
+    qint64 m_time_to_first_byte = -1;
+    bool m_timed_out = false;
 
     shared_qobject_ptr<QNetworkAccessManager> m_network;
 
@@ -108,6 +130,7 @@ class NetRequest : public Task {
 
     /// source URL
     QUrl m_url;
+    qint64 m_expected_size = -1;
     std::vector<std::shared_ptr<Net::HeaderProxy>> m_headerProxies;
 };
 }  // namespace Net
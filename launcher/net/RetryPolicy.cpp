@@ -0,0 +1,175 @@
+#include "RetryPolicy.h"
+
+#include <QHash>
+#include <QLocale>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRandomGenerator>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <chrono>
+
+#include "net/Logging.h"
+#include "net/NetRequest.h"
+
+namespace Net {
+
+namespace {
+struct Breaker {
+    int failures = 0;
+    std::chrono::steady_clock::time_point open_until;
+};
+
+// shared by every job, so one job backing off from a host protects the others too
+QHash<QString, Breaker> s_breakers;
+QMutex s_breakers_lock;
+}  // namespace
+
+bool RetryPolicy::isRetryable(int status, QNetworkReply::NetworkError error) const
+{
+    switch (status) {
+        case 408:  // Request Timeout
+        case 425:  // Too Early
+        case 429:  // Too Many Requests
+        case 500:
+        case 502:
+        case 503:
+        case 504:
+            return true;
+        default:
+            break;
+    }
+    // any other error status is not going to change by asking again
+    if (status >= 400)
+        return false;
+
+    switch (error) {
+        case QNetworkReply::ContentAccessDenied:
+        case QNetworkReply::ContentOperationNotPermittedError:
+        case QNetworkReply::ContentNotFoundError:
+        case QNetworkReply::AuthenticationRequiredError:
+        case QNetworkReply::ContentGoneError:
+        case QNetworkReply::ProtocolUnknownError:
+        case QNetworkReply::ProtocolInvalidOperationError:
+        case QNetworkReply::SslHandshakeFailedError:
+            return false;
+        default:
+            // connection trouble, or a download that turned out bad (e.g. a checksum mismatch)
+            return true;
+    }
+}
+
+bool RetryPolicy::isHostFailure(int status, QNetworkReply::NetworkError error) const
+{
+    switch (status) {
+        case 408:
+        case 425:
+        case 429:
+        case 500:
+        case 502:
+        case 503:
+        case 504:
+            return true;
+        default:
+            break;
+    }
+    // the host answered, so whatever went wrong was the request's fault or ours (e.g. a checksum mismatch or a full disk)
+    if (status > 0)
+        return false;
+
+    switch (error) {
+        case QNetworkReply::ConnectionRefusedError:
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::HostNotFoundError:
+        case QNetworkReply::TimeoutError:
+        case QNetworkReply::TemporaryNetworkFailureError:
+        case QNetworkReply::UnknownNetworkError:
+        case QNetworkReply::ProxyTimeoutError:
+        case QNetworkReply::ProtocolFailure:
+        case QNetworkReply::InternalServerError:
+        case QNetworkReply::ServiceUnavailableError:
+        case QNetworkReply::UnknownServerError:
+            return true;
+        default:
+            return false;
+    }
+}
+
+qint64 RetryPolicy::retryDelay(const NetRequest& request, int failures) const
+{
+    if (failures >= max_tries || !isRetryable(request.replyStatusCode(), request.error()))
+        return -1;
+
+    auto backoff = std::min(max_delay_ms, base_delay_ms << std::clamp(failures - 1, 0, 20));
+    qint64 delay = QRandomGenerator::global()->bounded(static_cast<int>(backoff) + 1);
+
+    auto retry_after = parseRetryAfter(request.replyHeader("Retry-After"), QDateTime::currentDateTimeUtc());
+    if (retry_after > max_retry_after_ms) {
+        qCWarning(taskNetLogC) << "Not retrying" << request.url().toString() << "- the server asks to wait" << retry_after << "ms";
+        return -1;
+    }
+    return std::max(delay, retry_after);
+}
+
+void RetryPolicy::recordSuccess(const QString& host) const
+{
+    QMutexLocker locker(&s_breakers_lock);
+    s_breakers.remove(host);
+}
+
+void RetryPolicy::recordFailure(const QString& host) const
+{
+    QMutexLocker locker(&s_breakers_lock);
+    auto& breaker = s_breakers[host];
+    breaker.failures++;
+    if (breaker.failures >= breaker_threshold) {
+        qCWarning(taskNetLogC) << host << "failed" << breaker.failures << "times in a row, pausing requests to it for"
+                               << breaker_cooldown_ms << "ms";
+        breaker.open_until = std::chrono::steady_clock::now() + std::chrono::milliseconds(breaker_cooldown_ms);
+    }
+}
+
+qint64 RetryPolicy::blockedFor(const QString& host) const
+{
+    QMutexLocker locker(&s_breakers_lock);
+    auto it = s_breakers.find(host);
+    if (it == s_breakers.end() || it->failures < breaker_threshold)
+        return 0;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now < it->open_until)
+        return std::chrono::duration_cast<std::chrono::milliseconds>(it->open_until - now).count() + 1;
+
+    // the cooldown is over. let this one request through to see if the host is back, and hold the rest
+    it->open_until = now + std::chrono::milliseconds(breaker_cooldown_ms);
+    return 0;
+}
+
+bool RetryPolicy::isDown(const QString& host) const
+{
+    QMutexLocker locker(&s_breakers_lock);
+    auto it = s_breakers.constFind(host);
+    return it != s_breakers.constEnd() && it->failures >= breaker_threshold + max_tries;
+}
+
+qint64 RetryPolicy::parseRetryAfter(const QByteArray& value, const QDateTime& now)
+{
+    auto trimmed = value.trimmed();
+    if (trimmed.isEmpty())
+        return -1;
+
+    // Retry-After: <seconds>
+    bool ok = false;
+    auto seconds = trimmed.toLongLong(&ok);
+    if (ok)
+        return seconds < 0 ? -1 : seconds * 1000;
+
+    // Retry-After: <HTTP date>, e.g. Wed, 21 Oct 2015 07:28:00 GMT
+    auto date = QLocale::c().toDateTime(QString::fromLatin1(trimmed), "ddd, dd MMM yyyy HH:mm:ss 'GMT'");
+    date.setTimeZone(QTimeZone::utc());
+    if (!date.isValid())
+        return -1;
+    return std::max<qint64>(0, now.msecsTo(date));
+}
+}  // namespace Net
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QNetworkReply>
+#include <QString>
+
+#include <memory>
+
+namespace Net {
+class NetRequest;
+
+/* Decides whether and when NetJob tries a failed request again.
+ *
+ * Retries back off exponentially with full jitter, so a burst of failures doesn't turn into a burst of retries.
+ * A Retry-After header from the server is honored if it asks for a bearable wait.
+ * Hosts that keep failing get their circuit opened: for a while nothing is sent to them at all, by any job.
+ * Only failures that point at the host count for that. A download that fails its checksum, or can't be
+ * written to disk, is tried again without holding up anything else. */
+class RetryPolicy {
+   public:
+    using Ptr = std::shared_ptr<RetryPolicy>;
+    virtual ~RetryPolicy() = default;
+
+    // attempts per request, including the first one
+    int max_tries = 3;
+    qint64 base_delay_ms = 500;
+    qint64 max_delay_ms = 30 * 1000;
+    // a Retry-After asking for longer than this fails the request instead
+    qint64 max_retry_after_ms = 2 * 60 * 1000;
+
+    // failures in a row before a host's circuit opens, and how long it stays open
+    int breaker_threshold = 5;
+    qint64 breaker_cooldown_ms = 30 * 1000;
+
+    // whether a request that ended like this could succeed when tried again
+    virtual auto isRetryable(int status, QNetworkReply::NetworkError error) const -> bool;
+    // whether a request that ended like this says something about the host, rather than about the request or this machine
+    virtual auto isHostFailure(int status, QNetworkReply::NetworkError error) const -> bool;
+    // how long to wait before trying a request again that has failed this many times, -1 to give up
+    auto retryDelay(const NetRequest& request, int failures) const -> qint64;
+
+    void recordSuccess(const QString& host) const;
+    void recordFailure(const QString& host) const;
+    // how long requests to the host have to wait for its circuit to close, 0 if they can go now
+    auto blockedFor(const QString& host) const -> qint64;
+    // whether the host failed every request let through to it since its circuit opened, max_tries times over
+    auto isDown(const QString& host) const -> bool;
+
+    // the delay a Retry-After header asks for, in either of its forms. -1 if there is none
+    static auto parseRetryAfter(const QByteArray& value, const QDateTime& now) -> qint64;
+};
+}  // namespace Net
@@ -46,6 +46,8 @@ class Sink {
 
    public:
     virtual auto init(QNetworkRequest& request) -> Task::State = 0;
+    // called once the response headers are known, before any data is written
+    virtual auto receivedHeaders(QNetworkReply&) -> Task::State { return Task::State::Running; }
     virtual auto write(QByteArray& data) -> Task::State = 0;
     virtual auto abort() -> Task::State = 0;
     virtual auto finalize(QNetworkReply& reply) -> Task::State = 0;
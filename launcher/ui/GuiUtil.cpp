@@ -42,6 +42,8 @@
 #include <QFileDialog>
 #include <QStandardPaths>
 
+#include "CensorFilter.h"
+#include "minecraft/auth/AccountList.h"
 #include "net/PasteUpload.h"
 #include "ui/dialogs/CustomMessageBox.h"
 #include "ui/dialogs/ProgressDialog.h"
@@ -123,9 +125,9 @@ std::optional<QString> GuiUtil::uploadPaste(const QString& name, const QString&
         }
     }
 
-    QString textToUpload = text;
+    QString textToUpload = censorAccountSecrets(text);
     if (shouldTruncate) {
-        textToUpload = truncateLogForMclogs(text);
+        textToUpload = truncateLogForMclogs(textToUpload);
     }
 
     std::unique_ptr<PasteUpload> paste(new PasteUpload(parentWidget, textToUpload, pasteCustomAPIBaseSetting, pasteTypeSetting));
@@ -151,6 +153,20 @@ void GuiUtil::setClipboardText(const QString& text)
     QApplication::clipboard()->setText(text);
 }
 
+QString GuiUtil::censorAccountSecrets(const QString& text)
+{
+    QMap<QString, QString> secrets;
+    auto accounts = APPLICATION->accounts();
+    for (int i = 0; i < accounts->count(); i++) {
+        auto account = accounts->at(i);
+        if (account->accessToken().trimmed().size())
+            secrets[account->accessToken()] = QObject::tr("<ACCESS TOKEN>");
+        if (account->profileId().trimmed().size())
+            secrets[account->profileId()] = QObject::tr("<PROFILE ID>");
+    }
+    return CensorFilter(secrets).apply(text);
+}
+
 static QStringList BrowseForFileInternal(QString context,
                                          QString caption,
                                          QString filter,
@@ -6,6 +6,8 @@
 namespace GuiUtil {
 std::optional<QString> uploadPaste(const QString& name, const QString& text, QWidget* parentWidget);
 void setClipboardText(const QString& text);
+// replaces the tokens and profile ids of all accounts, for logs that didn't go through a launch's censor filter
+QString censorAccountSecrets(const QString& text);
 QStringList BrowseForFiles(QString context, QString caption, QString filter, QString defaultPath, QWidget* parentWidget);
 QString BrowseForFile(QString context, QString caption, QString filter, QString defaultPath, QWidget* parentWidget);
 }  // namespace GuiUtil
@@ -47,8 +47,10 @@
 
 #include <QDir>
 #include <QFileInfo>
+#include <QFutureWatcher>
 #include <QUrl>
 #include <QVariant>
+#include <QtConcurrentRun>
 
 #include <QAction>
 #include <QActionGroup>
@@ -117,6 +119,8 @@
 #include "minecraft/mod/tasks/LocalResourceParse.h"
 
 #include "modplatform/ModIndex.h"
+#include "minecraft/AssetsManifest.h"
+#include "modplatform/helpers/ResourceStore.h"
 #include "modplatform/flame/FlameAPI.h"
 #include "modplatform/flame/FlameModIndex.h"
 
@@ -127,6 +131,7 @@
 #include "Json.h"
 
 #include "MMCTime.h"
+#include "StringUtils.h"
 
 namespace {
 QString profileInUseFilter(const QString& profile, bool used)
@@ -1304,6 +1309,59 @@ void MainWindow::on_actionClearMetadata_triggered()
     APPLICATION->metacache()->SaveNow();
 }
 
+void MainWindow::on_actionCleanResourceStore_triggered()
+{
+    auto store = APPLICATION->resourceStore();
+    auto scan = makeShared<ResourceStoreScan>(store.get(), QStringList{ APPLICATION->settings()->get("InstanceDir").toString() });
+    ProgressDialog scanDialog(this);
+    if (scanDialog.execWithTask(scan.get()) != QDialog::Accepted)
+        return;
+
+    auto report = scan->report();
+    auto summary = tr("The shared mod files take %1 in %n file(s). Instances sharing them instead of keeping their own copies save %2.",
+                      nullptr, report.blobs)
+                       .arg(StringUtils::humanReadableFileSize(report.blob_bytes), StringUtils::humanReadableFileSize(report.saved_bytes));
+    if (report.unreferenced.isEmpty()) {
+        CustomMessageBox::selectable(this, tr("Shared mod files"), summary + "\n\n" + tr("All of them are still in use."),
+                                     QMessageBox::Information)
+            ->exec();
+        return;
+    }
+
+    auto response = CustomMessageBox::selectable(this, tr("Shared mod files"),
+                                                 summary + "\n\n" +
+                                                     tr("%n file(s) taking %1 are not used by any instance anymore. Remove them?", nullptr,
+                                                        static_cast<int>(report.unreferenced.size()))
+                                                         .arg(StringUtils::humanReadableFileSize(report.unreferenced_bytes)),
+                                                 QMessageBox::Question, QMessageBox::Yes | QMessageBox::No, QMessageBox::No)
+                        ->exec();
+    if (response == QMessageBox::Yes)
+        store->remove(report.unreferenced);
+}
+
+void MainWindow::on_actionVerifyAssets_triggered()
+{
+    // hashing every asset takes a while, it is done in the background
+    ui->actionVerifyAssets->setEnabled(false);
+    auto watcher = new QFutureWatcher<AssetsManifest::Report>(this);
+    connect(watcher, &QFutureWatcher<AssetsManifest::Report>::finished, this, [this, watcher] {
+        auto report = watcher->result();
+        watcher->deleteLater();
+        ui->actionVerifyAssets->setEnabled(true);
+        APPLICATION->assetsManifest()->save();
+
+        auto summary = tr("Checked %n game asset(s).", nullptr, report.objects);
+        if (report.broken == 0) {
+            summary += "\n\n" + tr("All of them are fine.");
+        } else {
+            summary += "\n\n" + tr("%n of them were missing or damaged, they will be downloaded again on the next launch.", nullptr,
+                                     report.broken);
+        }
+        CustomMessageBox::selectable(this, tr("Game assets"), summary, QMessageBox::Information)->show();
+    });
+    watcher->setFuture(QtConcurrent::run([manifest = APPLICATION->assetsManifest()] { return manifest->verify(); }));
+}
+
 #ifdef Q_OS_MAC
 void MainWindow::on_actionAddToPATH_triggered()
 {
@@ -136,6 +136,10 @@ class MainWindow : public QMainWindow {
 
     void on_actionClearMetadata_triggered();
 
+    void on_actionCleanResourceStore_triggered();
+
+    void on_actionVerifyAssets_triggered();
+
 #ifdef Q_OS_MAC
     void on_actionAddToPATH_triggered();
 #endif
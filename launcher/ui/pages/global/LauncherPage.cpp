@@ -225,6 +225,7 @@ void LauncherPage::applySettings()
     s->set("ConsoleFontSize", ui->fontSizeBox->value());
     s->set("ConsoleMaxLines", ui->lineLimitSpinBox->value());
     s->set("ConsoleOverflowStop", ui->checkStopLogging->checkState() != Qt::Unchecked);
+    s->set("ConsoleOverflowSpill", ui->checkSpillLog->isChecked());
 
     // Folders
     // TODO: Offer to move instances to new instance folder.
@@ -294,6 +295,7 @@ void LauncherPage::loadSettings()
     refreshFontPreview();
     ui->lineLimitSpinBox->setValue(s->get("ConsoleMaxLines").toInt());
     ui->checkStopLogging->setChecked(s->get("ConsoleOverflowStop").toBool());
+    ui->checkSpillLog->setChecked(s->get("ConsoleOverflowSpill").toBool());
 
     // Folders
     ui->instDirTextBox->setText(s->get("InstanceDir").toString());
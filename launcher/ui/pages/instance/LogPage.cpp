@@ -43,8 +43,10 @@
 #include <QIdentityProxyModel>
 #include <QScrollBar>
 #include <QShortcut>
+#include <QSortFilterProxyModel>
 
 #include "launch/LaunchTask.h"
+#include "launch/LogSpill.h"
 #include "settings/Setting.h"
 
 #include "ui/GuiUtil.h"
@@ -52,10 +54,30 @@
 
 #include <BuildConfig.h>
 
+#include <algorithm>
+
+namespace {
+// how many lines of the spill Earlier Lines shows at a time
+constexpr int earlierLines = 1000;
+}  // namespace
+
 class LogFormatProxyModel : public QIdentityProxyModel {
    public:
     LogFormatProxyModel(QObject* parent = nullptr) : QIdentityProxyModel(parent) {}
     QVariant data(const QModelIndex& index, int role) const override
+    {
+        if (role == Qt::FontRole || role == Qt::ForegroundRole || role == Qt::BackgroundRole) {
+            auto level = static_cast<MessageLevel::Enum>(QIdentityProxyModel::data(index, LogModel::LevelRole).toInt());
+            auto result = levelData(level, role);
+            if (result.isValid())
+                return result;
+        }
+
+        return QIdentityProxyModel::data(index, role);
+    }
+
+    // the font and colors of the lines of a level, also for lines that are not in the model
+    QVariant levelData(MessageLevel::Enum level, int role) const
     {
         const LogColors& colors = APPLICATION->themeManager()->getLogColors();
 
@@ -63,7 +85,6 @@ class LogFormatProxyModel : public QIdentityProxyModel {
             case Qt::FontRole:
                 return m_font;
             case Qt::ForegroundRole: {
-                auto level = static_cast<MessageLevel::Enum>(QIdentityProxyModel::data(index, LogModel::LevelRole).toInt());
                 QColor result = colors.foreground.value(level);
 
                 if (result.isValid())
@@ -72,7 +93,6 @@ class LogFormatProxyModel : public QIdentityProxyModel {
                 break;
             }
             case Qt::BackgroundRole: {
-                auto level = static_cast<MessageLevel::Enum>(QIdentityProxyModel::data(index, LogModel::LevelRole).toInt());
                 QColor result = colors.background.value(level);
 
                 if (result.isValid())
@@ -82,59 +102,28 @@ class LogFormatProxyModel : public QIdentityProxyModel {
             }
         }
 
-        return QIdentityProxyModel::data(index, role);
+        return QVariant();
     }
 
     void setFont(QFont font) { m_font = font; }
 
-    QModelIndex find(const QModelIndex& start, const QString& value, bool reverse) const
+   private:
+    QFont m_font;
+};
+
+// the lines of a level or any level after it in MessageLevel::Enum, as LogModel::toPlainText() gives them
+class LogLevelFilterModel : public QSortFilterProxyModel {
+   public:
+    LogLevelFilterModel(MessageLevel::Enum atLeast, QObject* parent = nullptr) : QSortFilterProxyModel(parent), m_atLeast(atLeast) {}
+
+   protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override
     {
-        QModelIndex parentIndex = parent(start);
-        auto compare = [this, start, parentIndex, value](int r) -> QModelIndex {
-            QModelIndex idx = index(r, start.column(), parentIndex);
-            if (!idx.isValid() || idx == start) {
-                return QModelIndex();
-            }
-            QVariant v = data(idx, Qt::DisplayRole);
-            QString t = v.toString();
-            if (t.contains(value, Qt::CaseInsensitive))
-                return idx;
-            return QModelIndex();
-        };
-        if (reverse) {
-            int from = start.row();
-            int to = 0;
-
-            for (int i = 0; i < 2; ++i) {
-                for (int r = from; (r >= to); --r) {
-                    auto idx = compare(r);
-                    if (idx.isValid())
-                        return idx;
-                }
-                // prepare for the next iteration
-                from = rowCount() - 1;
-                to = start.row();
-            }
-        } else {
-            int from = start.row();
-            int to = rowCount(parentIndex);
-
-            for (int i = 0; i < 2; ++i) {
-                for (int r = from; (r < to); ++r) {
-                    auto idx = compare(r);
-                    if (idx.isValid())
-                        return idx;
-                }
-                // prepare for the next iteration
-                from = 0;
-                to = start.row();
-            }
-        }
-        return QModelIndex();
+        return sourceModel()->index(sourceRow, 0, sourceParent).data(LogModel::LevelRole).toInt() >= m_atLeast;
     }
 
    private:
-    QFont m_font;
+    MessageLevel::Enum m_atLeast;
 };
 
 LogPage::LogPage(InstancePtr instance, QWidget* parent) : QWidget(parent), ui(new Ui::LogPage), m_instance(instance)
@@ -157,6 +146,10 @@ LogPage::LogPage(InstancePtr instance, QWidget* parent) : QWidget(parent), ui(ne
 
     ui->text->setModel(m_proxy);
 
+    ui->levelFilter->addItem(tr("All lines"), MessageLevel::Unknown);
+    ui->levelFilter->addItem(tr("Warnings and errors"), MessageLevel::Warning);
+    ui->levelFilter->addItem(tr("Errors"), MessageLevel::Error);
+
     // set up instance and launch process recognition
     {
         auto launchTask = m_instance->getLaunchTask();
@@ -208,18 +201,111 @@ void LogPage::UIToModelState()
 void LogPage::setInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc, bool initial)
 {
     m_process = proc;
+    if (m_model) {
+        disconnect(m_model.get(), nullptr, this, nullptr);
+    }
     if (m_process) {
         m_model = proc->getLogModel();
-        m_proxy->setSourceModel(m_model.get());
+        // the view starts over with the model's lines
+        connect(m_model.get(), &LogModel::modelReset, this, [this] { m_historyFront = m_model->spillLine(0); });
+        updateSourceModel();
         if (initial) {
             modelStateToUI();
         } else {
             UIToModelState();
         }
     } else {
-        m_proxy->setSourceModel(nullptr);
         m_model.reset();
+        updateSourceModel();
+    }
+}
+
+MessageLevel::Enum LogPage::levelFilter() const
+{
+    return static_cast<MessageLevel::Enum>(ui->levelFilter->currentData().toInt());
+}
+
+void LogPage::updateSourceModel()
+{
+    // changing the source resets the proxy, and the view fills itself again
+    auto oldFilter = m_filter;
+    m_filter = nullptr;
+    if (m_model && levelFilter() != MessageLevel::Unknown) {
+        m_filter = new LogLevelFilterModel(levelFilter(), this);
+        m_filter->setSourceModel(m_model.get());
+        m_proxy->setSourceModel(m_filter);
+    } else {
+        m_proxy->setSourceModel(m_model.get());
     }
+    delete oldFilter;
+    m_historyFront = m_model ? m_model->spillLine(0) : 0;
+    ui->btnEarlier->setVisible(m_model && m_model->spill());
+}
+
+void LogPage::showEarlierLines(qint64 from)
+{
+    auto spill = m_model->spill();
+    from = std::max(from, spill->firstLine());
+    if (from >= m_historyFront)
+        return;
+    QStringList lines;
+    QList<QTextCharFormat> formats;
+    for (auto& line : spill->lines(from, int(m_historyFront - from))) {
+        if (line.level < levelFilter())
+            continue;
+        lines.append(line.text);
+        formats.append(ui->text->lineFormat(m_proxy->levelData(line.level, Qt::FontRole),
+                                            m_proxy->levelData(line.level, Qt::ForegroundRole),
+                                            m_proxy->levelData(line.level, Qt::BackgroundRole)));
+    }
+    ui->text->prependLines(lines, formats);
+    m_historyFront = from;
+}
+
+bool LogPage::findInHistory(const QString& what, bool reverse)
+{
+    if (ui->text->findInHistory(what, reverse))
+        return true;
+    auto spill = m_model->spill();
+    if (!reverse || !spill)
+        return false;
+    // further back, the lines are read from the spill up to the match
+    for (auto line = spill->findText(what, m_historyFront, true); line != -1; line = spill->findText(what, line, true)) {
+        auto found = spill->lines(line, 1);
+        if (found.isEmpty())
+            return false;
+        if (found.first().level < levelFilter())
+            continue;
+        showEarlierLines(line);
+        ui->text->selectRow(-ui->text->historyRows(), what, true);
+        return true;
+    }
+    return false;
+}
+
+void LogPage::on_btnEarlier_clicked()
+{
+    if (m_model && m_model->spill())
+        showEarlierLines(m_historyFront - earlierLines);
+}
+
+int LogPage::modelRow(int viewRow) const
+{
+    if (!m_filter || viewRow < 0)
+        return viewRow;
+    return m_filter->mapToSource(m_filter->index(viewRow, 0)).row();
+}
+
+int LogPage::viewRow(int modelRow) const
+{
+    if (!m_filter || modelRow < 0)
+        return modelRow;
+    return m_filter->mapFromSource(m_model->index(modelRow, 0)).row();
+}
+
+void LogPage::on_levelFilter_currentIndexChanged([[maybe_unused]] int index)
+{
+    updateSourceModel();
 }
 
 void LogPage::onInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc)
@@ -245,7 +331,7 @@ void LogPage::on_btnPaste_clicked()
     // FIXME: turn this into a proper task and move the upload logic out of GuiUtil!
     m_model->append(MessageLevel::Launcher,
                     QString("Log upload triggered at: %1").arg(QDateTime::currentDateTime().toString(Qt::RFC2822Date)));
-    auto url = GuiUtil::uploadPaste(tr("Minecraft Log"), m_model->toPlainText(), this);
+    auto url = GuiUtil::uploadPaste(tr("Minecraft Log"), m_model->toPlainText(levelFilter()), this);
     if (!url.has_value()) {
         m_model->append(MessageLevel::Error, QString("Log upload canceled"));
     } else if (url->isNull()) {
@@ -260,7 +346,7 @@ void LogPage::on_btnCopy_clicked()
     if (!m_model)
         return;
     m_model->append(MessageLevel::Launcher, QString("Clipboard copy at: %1").arg(QDateTime::currentDateTime().toString(Qt::RFC2822Date)));
-    GuiUtil::setClipboardText(m_model->toPlainText());
+    GuiUtil::setClipboardText(m_model->toPlainText(levelFilter()));
 }
 
 void LogPage::on_btnClear_clicked()
@@ -291,21 +377,57 @@ void LogPage::on_wrapCheckbox_clicked(bool checked)
     m_model->setLineWrap(checked);
 }
 
+void LogPage::on_btnNextError_clicked()
+{
+    if (!m_model)
+        return;
+    bool reverse = QApplication::keyboardModifiers() & Qt::ShiftModifier;
+    // errors get through any level filter
+    auto row = m_model->findLevel(MessageLevel::Error, modelRow(ui->text->currentRow()), reverse);
+    if (row != -1)
+        ui->text->selectRow(viewRow(row));
+}
+
+void LogPage::find(bool reverse)
+{
+    auto what = ui->searchBar->text();
+    if (!m_model || what.isEmpty())
+        return;
+    // the rest of the current line first, then the model's index for the next line with a match.
+    // the lines before the model's first row are only in the view, or in the spill further back
+    if (ui->text->currentRow() == -1 ? findInHistory(what, reverse) : ui->text->findInCurrentRow(what, reverse))
+        return;
+    auto from = modelRow(ui->text->currentRow());
+    auto row = m_model->findText(what, from, reverse);
+    // matches in lines the level filter hides are passed over, until the search comes back around to the first one
+    auto first = row;
+    while (row != -1 && viewRow(row) == -1) {
+        row = m_model->findText(what, row, reverse);
+        if (row == first)
+            row = -1;
+    }
+    // going back past the model's first row, the search goes on in the history before it wraps around
+    if (reverse && from != -1 && (row == -1 || row >= from) && findInHistory(what, true))
+        return;
+    if (row != -1)
+        ui->text->selectRow(viewRow(row), what, reverse);
+}
+
 void LogPage::on_findButton_clicked()
 {
     auto modifiers = QApplication::keyboardModifiers();
     bool reverse = modifiers & Qt::ShiftModifier;
-    ui->text->findNext(ui->searchBar->text(), reverse);
+    find(reverse);
 }
 
 void LogPage::findNextActivated()
 {
-    ui->text->findNext(ui->searchBar->text(), false);
+    find(false);
 }
 
 void LogPage::findPreviousActivated()
 {
-    ui->text->findNext(ui->searchBar->text(), true);
+    find(true);
 }
 
 void LogPage::findActivated()
@@ -47,6 +47,7 @@ class LogPage;
 }
 class QTextCharFormat;
 class LogFormatProxyModel;
+class LogLevelFilterModel;
 
 class LogPage : public QWidget, public BasePage {
     Q_OBJECT
@@ -67,6 +68,9 @@ class LogPage : public QWidget, public BasePage {
     void on_btnCopy_clicked();
     void on_btnClear_clicked();
     void on_btnBottom_clicked();
+    void on_btnNextError_clicked();
+    void on_levelFilter_currentIndexChanged(int index);
+    void on_btnEarlier_clicked();
 
     void on_trackLogCheckbox_clicked(bool checked);
     void on_wrapCheckbox_clicked(bool checked);
@@ -79,6 +83,16 @@ class LogPage : public QWidget, public BasePage {
     void onInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc);
 
    private:
+    void find(bool reverse);
+    MessageLevel::Enum levelFilter() const;
+    // puts the level filter, if there is one, between the model and the view
+    void updateSourceModel();
+    // rows of the view and of the model, which differ with a level filter. -1 for a row the filter hides
+    int modelRow(int viewRow) const;
+    int viewRow(int modelRow) const;
+    // puts the lines from the spill from this one on before those in the view
+    void showEarlierLines(qint64 from);
+    bool findInHistory(const QString& what, bool reverse);
     void modelStateToUI();
     void UIToModelState();
     void setInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc, bool initial);
@@ -89,5 +103,8 @@ class LogPage : public QWidget, public BasePage {
     shared_qobject_ptr<LaunchTask> m_process;
 
     LogFormatProxyModel* m_proxy;
+    LogLevelFilterModel* m_filter = nullptr;
+    // the spill's number for the first line in the view
+    qint64 m_historyFront = 0;
     shared_qobject_ptr<LogModel> m_model;
 };
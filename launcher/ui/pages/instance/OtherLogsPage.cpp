@@ -184,7 +184,7 @@ void OtherLogsPage::on_btnPaste_clicked()
 
 void OtherLogsPage::on_btnCopy_clicked()
 {
-    GuiUtil::setClipboardText(ui->text->toPlainText());
+    GuiUtil::setClipboardText(GuiUtil::censorAccountSecrets(ui->text->toPlainText()));
 }
 
 void OtherLogsPage::on_btnDelete_clicked()
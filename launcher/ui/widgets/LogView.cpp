@@ -95,6 +95,7 @@ void LogView::repopulate()
 {
     auto doc = document();
     doc->clear();
+    m_removedRows = 0;
     if (!m_model) {
         return;
     }
@@ -124,19 +125,8 @@ void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
     for (int i = first; i <= last; i++) {
         auto idx = m_model->index(i, 0, parent);
         auto text = m_model->data(idx, Qt::DisplayRole).toString();
-        QTextCharFormat format(*m_defaultFormat);
-        auto font = m_model->data(idx, Qt::FontRole);
-        if (font.isValid()) {
-            format.setFont(font.value<QFont>());
-        }
-        auto fg = m_model->data(idx, Qt::ForegroundRole);
-        if (fg.isValid()) {
-            format.setForeground(fg.value<QColor>());
-        }
-        auto bg = m_model->data(idx, Qt::BackgroundRole);
-        if (bg.isValid()) {
-            format.setBackground(bg.value<QColor>());
-        }
+        auto format = lineFormat(m_model->data(idx, Qt::FontRole), m_model->data(idx, Qt::ForegroundRole),
+                                 m_model->data(idx, Qt::BackgroundRole));
         cursor.movePosition(QTextCursor::End);
         cursor.insertText(text, format);
         cursor.insertBlock();
@@ -153,12 +143,116 @@ void LogView::rowsInserted(const QModelIndex& parent, int first, int last)
     }
 }
 
+QTextCharFormat LogView::lineFormat(const QVariant& font, const QVariant& foreground, const QVariant& background) const
+{
+    QTextCharFormat format(*m_defaultFormat);
+    if (font.isValid()) {
+        format.setFont(font.value<QFont>());
+    }
+    if (foreground.isValid()) {
+        format.setForeground(foreground.value<QColor>());
+    }
+    if (background.isValid()) {
+        format.setBackground(background.value<QColor>());
+    }
+    return format;
+}
+
+void LogView::prependLines(const QStringList& lines, const QList<QTextCharFormat>& formats)
+{
+    if (lines.isEmpty()) {
+        return;
+    }
+    QTextDocument document;
+    QTextCursor cursor(&document);
+    for (int i = 0; i < lines.size(); i++) {
+        cursor.insertText(lines[i], formats.value(i, *m_defaultFormat));
+        cursor.insertBlock();
+    }
+
+    // the empty block the fragment ends with becomes the first line there was before
+    QTextCursor workCursor(this->document());
+    workCursor.movePosition(QTextCursor::Start);
+    workCursor.insertFragment(QTextDocumentFragment(&document));
+    m_removedRows += lines.size();
+}
+
+int LogView::historyRows() const
+{
+    return m_removedRows;
+}
+
+bool LogView::findInHistory(const QString& what, bool reverse)
+{
+    auto cursor = textCursor();
+    if (cursor.blockNumber() >= m_removedRows) {
+        if (!reverse) {
+            return false;
+        }
+        cursor = QTextCursor(document()->findBlockByNumber(m_removedRows));
+    }
+    auto found = document()->find(what, cursor, reverse ? QTextDocument::FindBackward : QTextDocument::FindFlags());
+    if (found.isNull() || found.blockNumber() >= m_removedRows) {
+        return false;
+    }
+    setTextCursor(found);
+    centerCursor();
+    return true;
+}
+
 void LogView::rowsRemoved(const QModelIndex& parent, int first, int last)
 {
     // TODO: some day... maybe
     Q_UNUSED(parent)
-    Q_UNUSED(first)
-    Q_UNUSED(last)
+    m_removedRows += last - first + 1;
+}
+
+int LogView::currentRow() const
+{
+    auto row = textCursor().blockNumber() - m_removedRows;
+    return row < 0 ? -1 : row;
+}
+
+bool LogView::findInCurrentRow(const QString& what, bool reverse)
+{
+    auto cursor = textCursor();
+    auto block = cursor.block();
+    if (what.isEmpty() || currentRow() == -1) {
+        return false;
+    }
+    int at;
+    if (reverse) {
+        auto before = cursor.selectionStart() - block.position() - 1;
+        at = before < 0 ? -1 : block.text().lastIndexOf(what, before, Qt::CaseInsensitive);
+    } else {
+        at = block.text().indexOf(what, cursor.selectionEnd() - block.position(), Qt::CaseInsensitive);
+    }
+    if (at == -1) {
+        return false;
+    }
+    cursor.setPosition(block.position() + at);
+    cursor.setPosition(block.position() + at + what.size(), QTextCursor::KeepAnchor);
+    setTextCursor(cursor);
+    return true;
+}
+
+void LogView::selectRow(int row, const QString& what, bool reverse)
+{
+    auto block = document()->findBlockByNumber(row + m_removedRows);
+    if (!block.isValid()) {
+        return;
+    }
+    QTextCursor cursor(block);
+    int at = -1;
+    if (!what.isEmpty()) {
+        at = reverse ? block.text().lastIndexOf(what, -1, Qt::CaseInsensitive) : block.text().indexOf(what, 0, Qt::CaseInsensitive);
+    }
+    if (at != -1) {
+        cursor.setPosition(block.position() + at);
+        cursor.setPosition(block.position() + at + what.size(), QTextCursor::KeepAnchor);
+    }
+    setTextCursor(cursor);
+    centerCursor();
 }
 
 void LogView::scrollToBottom()
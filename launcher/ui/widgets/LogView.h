@@ -13,6 +13,21 @@ class LogView : public QPlainTextEdit {
     virtual void setModel(QAbstractItemModel* model);
     QAbstractItemModel* model() const;
 
+    // the row of the model the cursor is in, -1 if it is in lines the model dropped already
+    int currentRow() const;
+    // selects the next occurrence of what in the line the cursor is in, returns whether there was one
+    bool findInCurrentRow(const QString& what, bool reverse);
+    // shows the row, with the first (or last, if reverse) occurrence of what in it selected. rows before 0 are history
+    void selectRow(int row, const QString& what = QString(), bool reverse = false);
+
+    // the lines before the model's first row: the rows it removed, and those put in front with prependLines()
+    int historyRows() const;
+    void prependLines(const QStringList& lines, const QList<QTextCharFormat>& formats);
+    // the format of a line with these font, foreground and background, any of which may be unset
+    QTextCharFormat lineFormat(const QVariant& font, const QVariant& foreground, const QVariant& background) const;
+    // selects the next occurrence of what in the history, searching back from the model's first row if the cursor is past it
+    bool findInHistory(const QString& what, bool reverse);
+
    public slots:
     void setWordWrap(bool wrapping);
     void findNext(const QString& what, bool reverse);
@@ -32,4 +47,6 @@ class LogView : public QPlainTextEdit {
     QTextCharFormat* m_defaultFormat = nullptr;
     bool m_scroll = false;
     bool m_scrolling = false;
+    // rows removed from the model are kept in the document, so its rows start this many blocks in
+    int m_removedRows = 0;
 };
@@ -0,0 +1,102 @@
+#include <QCryptographicHash>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/AssetsManifest.h>
+
+class AssetsManifestTest : public QObject {
+    Q_OBJECT
+
+    struct Object {
+        QString hash;
+        qint64 size;
+    };
+
+    static Object writeObject(const QString& objects, const QByteArray& data)
+    {
+        auto hash = QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+        FS::write(FS::PathCombine(objects, hash.left(2), hash), data);
+        return { hash, data.size() };
+    }
+
+   private slots:
+    void test_Contains()
+    {
+        QTemporaryDir dir;
+        auto objects = dir.filePath("objects");
+        auto manifestFile = dir.filePath("assets.json");
+        auto present = writeObject(objects, "present");
+        auto downloaded = writeObject(objects, "downloaded");
+
+        {
+            AssetsManifest manifest(objects, manifestFile);
+            // found on disk
+            QVERIFY(manifest.contains(present.hash, present.size));
+            QVERIFY(!manifest.contains(present.hash, present.size + 1));
+            QVERIFY(!manifest.contains("0000000000000000000000000000000000000000", 1));
+            manifest.add(downloaded.hash, downloaded.size);
+            manifest.save();
+        }
+
+        // as in a later session
+        {
+            AssetsManifest manifest(objects, manifestFile);
+            QVERIFY(manifest.contains(present.hash, present.size));
+            QVERIFY(manifest.contains(downloaded.hash, downloaded.size));
+        }
+
+        // objects removed behind the launcher's back are noticed through their folder
+        QTest::qSleep(20);
+        QVERIFY(QFile::remove(FS::PathCombine(objects, downloaded.hash.left(2), downloaded.hash)));
+        {
+            AssetsManifest manifest(objects, manifestFile);
+            QVERIFY(!manifest.contains(downloaded.hash, downloaded.size));
+            QVERIFY(manifest.contains(present.hash, present.size));
+        }
+
+        // a file written again is hashed, and removed if its data changed
+        auto presentPath = FS::PathCombine(objects, present.hash.left(2), present.hash);
+        auto rewritten = writeObject(objects, "rewritten");
+        auto rewrittenPath = FS::PathCombine(objects, rewritten.hash.left(2), rewritten.hash);
+        {
+            AssetsManifest manifest(objects, manifestFile);
+            QVERIFY(manifest.contains(present.hash, present.size));
+            QVERIFY(manifest.contains(rewritten.hash, rewritten.size));
+            manifest.save();
+        }
+        QTest::qSleep(20);
+        FS::write(presentPath, "present");
+        FS::write(rewrittenPath, "REWRITTEN");
+        {
+            AssetsManifest manifest(objects, manifestFile);
+            QVERIFY(manifest.contains(present.hash, present.size));
+            QVERIFY(!manifest.contains(rewritten.hash, rewritten.size));
+            QVERIFY(!QFile::exists(rewrittenPath));
+        }
+    }
+
+    void test_Verify()
+    {
+        QTemporaryDir dir;
+        auto objects = dir.filePath("objects");
+        AssetsManifest manifest(objects, dir.filePath("assets.json"));
+        auto good = writeObject(objects, "good");
+        auto damaged = writeObject(objects, "damaged");
+        QVERIFY(manifest.contains(good.hash, good.size));
+        QVERIFY(manifest.contains(damaged.hash, damaged.size));
+
+        auto damagedPath = FS::PathCombine(objects, damaged.hash.left(2), damaged.hash);
+        FS::write(damagedPath, "DAMAGED");
+        auto report = manifest.verify();
+        QCOMPARE(report.objects, 2);
+        QCOMPARE(report.broken, 1);
+        QVERIFY(!QFile::exists(damagedPath));
+        QVERIFY(!manifest.contains(damaged.hash, damaged.size));
+        QVERIFY(manifest.contains(good.hash, good.size));
+    }
+};
+
+QTEST_GUILESS_MAIN(AssetsManifestTest)
+
+#include "AssetsManifest_test.moc"
@@ -0,0 +1,87 @@
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/AssetsUtils.h>
+
+class AssetsUtilsTest : public QObject {
+    Q_OBJECT
+
+    // the assets live in paths relative to the data folder, the test runs in its own
+    QTemporaryDir m_dir;
+    QString m_previous;
+
+    static void writeIndex(const QString& id, const QMap<QString, QByteArray>& files, bool mapToResources = false)
+    {
+        QJsonObject objects;
+        for (auto it = files.cbegin(); it != files.cend(); ++it) {
+            auto hash = QString::fromLatin1(QCryptographicHash::hash(it.value(), QCryptographicHash::Sha1).toHex());
+            FS::write(FS::PathCombine("assets/objects", hash.left(2), hash), it.value());
+            objects.insert(it.key(), QJsonObject{ { "hash", hash }, { "size", it.value().size() } });
+        }
+        FS::write(FS::PathCombine("assets/indexes", id + ".json"),
+                  QJsonDocument(QJsonObject{ { mapToResources ? "map_to_resources" : "virtual", true }, { "objects", objects } }).toJson());
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        m_previous = QDir::currentPath();
+        QDir::setCurrent(m_dir.path());
+    }
+
+    void cleanupTestCase() { QDir::setCurrent(m_previous); }
+
+    void test_Reconstruct()
+    {
+        writeIndex("legacy", { { "sound/step.ogg", "step" }, { "lang/en_US.lang", "language" }, { "icons/icon.png", "icon" } });
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", QString()));
+        QCOMPARE(FS::read("assets/virtual/legacy/sound/step.ogg"), QByteArray("step"));
+        QCOMPARE(FS::read("assets/virtual/legacy/lang/en_US.lang"), QByteArray("language"));
+        QCOMPARE(FS::read("assets/virtual/legacy/icons/icon.png"), QByteArray("icon"));
+        QVERIFY(QFile::exists("assets/virtual/legacy/.reconstructed"));
+
+        // the stamp says the launcher's own folder is complete, so it isn't looked at again
+        QVERIFY(QFile::remove("assets/virtual/legacy/icons/icon.png"));
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", QString()));
+        QVERIFY(!QFile::exists("assets/virtual/legacy/icons/icon.png"));
+
+        // until the index changes
+        writeIndex("legacy", { { "sound/step.ogg", "step" }, { "icons/icon.png", "icon" }, { "sound/new.ogg", "new" } });
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", QString()));
+        QCOMPARE(FS::read("assets/virtual/legacy/icons/icon.png"), QByteArray("icon"));
+        QCOMPARE(FS::read("assets/virtual/legacy/sound/new.ogg"), QByteArray("new"));
+    }
+
+    void test_Resources()
+    {
+        writeIndex("pre-1.6", { { "sound/step.ogg", "step" }, { "music/calm.ogg", "calm" } }, true);
+        QVERIFY(AssetsUtils::reconstructAssets("pre-1.6", "resources"));
+        QCOMPARE(FS::read("resources/sound/step.ogg"), QByteArray("step"));
+        QVERIFY(!QFile::exists("resources/.reconstructed"));
+
+        // the instance's resources folder is not the launcher's, what went missing from it is put back every time
+        QVERIFY(QFile::remove("resources/music/calm.ogg"));
+        QVERIFY(AssetsUtils::reconstructAssets("pre-1.6", "resources"));
+        QCOMPARE(FS::read("resources/music/calm.ogg"), QByteArray("calm"));
+    }
+
+    void test_Incomplete()
+    {
+        writeIndex("partial", { { "sound/a.ogg", "a" }, { "sound/b.ogg", "b" } });
+        auto hash = QString::fromLatin1(QCryptographicHash::hash("b", QCryptographicHash::Sha1).toHex());
+        QVERIFY(QFile::remove(FS::PathCombine("assets/objects", hash.left(2), hash)));
+
+        QVERIFY(AssetsUtils::reconstructAssets("partial", QString()));
+        QCOMPARE(FS::read("assets/virtual/partial/sound/a.ogg"), QByteArray("a"));
+        // no stamp, the missing object is placed once it is there
+        QVERIFY(!QFile::exists("assets/virtual/partial/.reconstructed"));
+    }
+};
+
+QTEST_GUILESS_MAIN(AssetsUtilsTest)
+
+#include "AssetsUtils_test.moc"
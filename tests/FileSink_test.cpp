@@ -0,0 +1,268 @@
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <net/ChecksumValidator.h>
+#include <net/Download.h>
+#include <net/FileSink.h>
+
+/* Serves a single file over HTTP. Unless drop_first is unset, the first response is cut off halfway through the body. */
+class FlakyServer : public QTcpServer {
+    Q_OBJECT
+   public:
+    QByteArray payload;
+    bool support_ranges = true;
+    bool drop_first = true;
+    // the GET request with this number, counting from 1, is answered with an error page instead
+    int fail_request = 0;
+    // the Range header of every GET request so far, empty if there was none
+    QList<QByteArray> range_headers;
+    int head_requests = 0;
+
+   protected:
+    void incomingConnection(qintptr handle) override
+    {
+        auto socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] { respond(socket); });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+
+   private:
+    void respond(QTcpSocket* socket)
+    {
+        auto request = socket->property("request").toByteArray() + socket->readAll();
+        socket->setProperty("request", request);
+        if (!request.contains("\r\n\r\n"))
+            return;
+
+        bool head = request.startsWith("HEAD ");
+        QByteArray range;
+        for (auto line : request.split('\n')) {
+            line = line.trimmed();
+            if (line.toLower().startsWith("range:"))
+                range = line.mid(6).trimmed();
+        }
+        if (head)
+            head_requests++;
+        else
+            range_headers.append(range);
+
+        qint64 first = 0;
+        qint64 last = payload.size() - 1;
+        bool ranged = support_ranges && range.startsWith("bytes=");
+        if (ranged) {
+            auto dash = range.indexOf('-');
+            first = range.mid(6, dash - 6).toLongLong();
+            if (dash + 1 < range.size())
+                last = range.mid(dash + 1).toLongLong();
+        }
+        auto body = payload.mid(first, last - first + 1);
+
+        QByteArray response;
+        if (!head && range_headers.size() == fail_request) {
+            body = "<html><body>Service Unavailable</body></html>";
+            response += "HTTP/1.1 503 Service Unavailable\r\n";
+            response += "Content-Type: text/html\r\n";
+            response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+            response += "Connection: close\r\n\r\n";
+            socket->write(response + body);
+            socket->disconnectFromHost();
+            return;
+        }
+        if (ranged) {
+            response += "HTTP/1.1 206 Partial Content\r\n";
+            response += "Content-Range: bytes " + QByteArray::number(first) + "-" + QByteArray::number(last) + "/" +
+                        QByteArray::number(payload.size()) + "\r\n";
+        } else {
+            response += "HTTP/1.1 200 OK\r\n";
+        }
+        response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+        response += "ETag: \"payload-v1\"\r\n";
+        if (support_ranges)
+            response += "Accept-Ranges: bytes\r\n";
+        response += "Connection: close\r\n\r\n";
+
+        bool drop = drop_first && !head && range_headers.size() == 1;
+        if (!head)
+            response += drop ? body.left(body.size() / 2) : body;
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+};
+
+class FileSinkTest : public QObject {
+    Q_OBJECT
+
+    static bool run(Net::Download::Ptr dl)
+    {
+        QSignalSpy finished(dl.get(), &Task::finished);
+        QSignalSpy succeeded(dl.get(), &Task::succeeded);
+        dl->start();
+        if (finished.isEmpty())
+            finished.wait(10000);
+        return !succeeded.isEmpty();
+    }
+
+    static QByteArray makePayload(int size = 512 * 1024)
+    {
+        QByteArray payload;
+        for (int i = 0; i < size; i++)
+            payload.append(static_cast<char>((i * 31) ^ (i >> 8)));
+        return payload;
+    }
+
+    static Net::Download::Ptr makeDownload(FlakyServer& server,
+                                           const QString& target,
+                                           shared_qobject_ptr<QNetworkAccessManager> network,
+                                           Net::Download::Options options = Net::Download::Option::NoOptions)
+    {
+        auto url = QUrl(QString("http://127.0.0.1:%1/payload.bin").arg(server.serverPort()));
+        auto dl = Net::Download::makeFile(url, target, options);
+        dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, QCryptographicHash::hash(server.payload, QCryptographicHash::Sha1)));
+        dl->setNetwork(network);
+        return dl;
+    }
+
+   private slots:
+    void test_ResumeAfterDrop()
+    {
+        FlakyServer server;
+        server.payload = makePayload();
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QTemporaryDir dir;
+        auto target = FS::PathCombine(dir.path(), "payload.bin");
+        auto network = makeShared<QNetworkAccessManager>();
+        auto dl = makeDownload(server, target, network);
+
+        // the first attempt is cut off, but what arrived is kept
+        QVERIFY(!run(dl));
+        QVERIFY(!QFile::exists(target));
+        QVERIFY(QFile::exists(target + ".part"));
+        auto partial_size = QFileInfo(target + ".part").size();
+        QVERIFY(partial_size > 0);
+        // the resume info is only written now that it is needed
+        QVERIFY(QFile::exists(target + ".part.json"));
+        QVERIFY(Net::FileSink::isPartialFile(target + ".part"));
+
+        // the retry only asks for the rest, and the checksum still covers the whole file
+        QVERIFY(run(dl));
+        QCOMPARE(server.range_headers.size(), 2);
+        QCOMPARE(server.range_headers.last(), "bytes=" + QByteArray::number(partial_size) + "-");
+        QCOMPARE(FS::read(target), server.payload);
+        QVERIFY(!QFile::exists(target + ".part"));
+        QVERIFY(!QFile::exists(target + ".part.json"));
+    }
+
+    void test_ErrorOnResume()
+    {
+        FlakyServer server;
+        server.payload = makePayload();
+        server.fail_request = 2;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QTemporaryDir dir;
+        auto target = FS::PathCombine(dir.path(), "payload.bin");
+        auto network = makeShared<QNetworkAccessManager>();
+        auto dl = makeDownload(server, target, network);
+
+        QVERIFY(!run(dl));
+        QVERIFY(QFile::exists(target + ".part.json"));
+
+        // the error page must not be appended to the partial file, which can't be trusted anymore after it
+        QVERIFY(!run(dl));
+        QCOMPARE(server.range_headers.size(), 2);
+        QVERIFY(!server.range_headers.last().isEmpty());
+        QVERIFY(!QFile::exists(target + ".part"));
+        QVERIFY(!QFile::exists(target + ".part.json"));
+
+        QVERIFY(run(dl));
+        QVERIFY(server.range_headers.last().isEmpty());
+        QCOMPARE(FS::read(target), server.payload);
+    }
+
+    void test_NoResumeWithoutRangeSupport()
+    {
+        FlakyServer server;
+        server.payload = makePayload();
+        server.support_ranges = false;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QTemporaryDir dir;
+        auto target = FS::PathCombine(dir.path(), "payload.bin");
+        auto network = makeShared<QNetworkAccessManager>();
+        auto dl = makeDownload(server, target, network);
+
+        QVERIFY(!run(dl));
+        QVERIFY(!QFile::exists(target + ".part"));
+
+        QVERIFY(run(dl));
+        QVERIFY(server.range_headers.last().isEmpty());
+        QCOMPARE(FS::read(target), server.payload);
+    }
+
+    void test_PartialFiles()
+    {
+        QTemporaryDir dir;
+        auto user = FS::PathCombine(dir.path(), "notes.part");
+        FS::write(user, "not a download");
+        QVERIFY(!Net::FileSink::isPartialFile(user));
+        QVERIFY(!Net::FileSink::isPartialFile(FS::PathCombine(dir.path(), "mod.jar")));
+
+        auto kept = FS::PathCombine(dir.path(), "mod.jar.part");
+        FS::write(kept, "half a mod");
+        FS::write(kept + ".json", "{}");
+        QVERIFY(Net::FileSink::isPartialFile(kept));
+        QVERIFY(Net::FileSink::isPartialFile(kept + ".json"));
+    }
+
+    void test_Segmented()
+    {
+        FlakyServer server;
+        server.payload = makePayload(10 * 1024 * 1024);
+        server.drop_first = false;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QTemporaryDir dir;
+        auto target = FS::PathCombine(dir.path(), "payload.bin");
+        auto network = makeShared<QNetworkAccessManager>();
+        auto dl = makeDownload(server, target, network, Net::Download::Option::Segmented);
+
+        QVERIFY(run(dl));
+        QCOMPARE(server.head_requests, 1);
+        // 10 MiB splits into two ranges of at least 4 MiB each
+        QCOMPARE(server.range_headers.size(), 2);
+        QVERIFY(server.range_headers.contains("bytes=0-5242879"));
+        QVERIFY(server.range_headers.contains("bytes=5242880-10485759"));
+        QCOMPARE(FS::read(target), server.payload);
+        QVERIFY(!QFile::exists(target + ".part"));
+    }
+
+    void test_SegmentedFallback()
+    {
+        FlakyServer server;
+        server.payload = makePayload(10 * 1024 * 1024);
+        server.drop_first = false;
+        server.support_ranges = false;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QTemporaryDir dir;
+        auto target = FS::PathCombine(dir.path(), "payload.bin");
+        auto network = makeShared<QNetworkAccessManager>();
+        auto dl = makeDownload(server, target, network, Net::Download::Option::Segmented);
+
+        // without range support this is one plain request after the probe
+        QVERIFY(run(dl));
+        QCOMPARE(server.head_requests, 1);
+        QCOMPARE(server.range_headers, QList<QByteArray>{ QByteArray() });
+        QCOMPARE(FS::read(target), server.payload);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileSinkTest)
+
+#include "FileSink_test.moc"
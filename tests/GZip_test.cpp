@@ -45,6 +45,22 @@ class GZipTest : public QObject {
             fib(prev, cur);
         } while (cur < size);
     }
+
+    void test_Members()
+    {
+        QByteArray first, second;
+        QVERIFY(GZip::zip("first member\n", first));
+        QVERIFY(GZip::zip("second member\n", second, 1));
+
+        QByteArray decompressed;
+        QVERIFY(GZip::unzip(first + second, decompressed));
+        QCOMPARE(decompressed, QByteArray("first member\nsecond member\n"));
+
+        // a member cut off at the end is left out
+        QVERIFY(GZip::unzip(first + second.left(second.size() / 2), decompressed));
+        QVERIFY(decompressed.startsWith("first member\n"));
+        QVERIFY(!GZip::unzip(first.left(first.size() / 2), decompressed));
+    }
 };
 
 QTEST_GUILESS_MAIN(GZipTest)
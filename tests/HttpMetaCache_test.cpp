@@ -0,0 +1,171 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <net/HttpMetaCache.h>
+
+#include <memory>
+
+class HttpMetaCacheTest : public QObject {
+    Q_OBJECT
+
+    static MetaEntryPtr addEntry(HttpMetaCache& cache, const QString& base, const QString& path)
+    {
+        auto entry = cache.resolveEntry(base, path);
+        entry->setMD5Sum("d41d8cd98f00b204e9800998ecf8427e");
+        entry->setETag("\"" + path + "\"");
+        entry->setLocalChangedTimestamp(1700000000000);
+        entry->setRemoteChangedTimestamp("Tue, 14 Nov 2023 22:13:20 GMT");
+        entry->setMaximumAge(604800);
+        entry->setStale(false);
+        cache.updateEntry(entry);
+        return entry;
+    }
+
+    static std::unique_ptr<HttpMetaCache> makeCache(const QTemporaryDir& dir)
+    {
+        auto cache = std::make_unique<HttpMetaCache>(FS::PathCombine(dir.path(), "metacache"));
+        cache->addBase("libraries", FS::PathCombine(dir.path(), "libraries"));
+        cache->addBase("meta", FS::PathCombine(dir.path(), "meta"));
+        cache->Load();
+        return cache;
+    }
+
+   private slots:
+    void test_SaveAndLoad()
+    {
+        QTemporaryDir dir;
+        {
+            auto cache = makeCache(dir);
+            addEntry(*cache, "libraries", "org/lwjgl/lwjgl/3.3.1/lwjgl-3.3.1.jar");
+            addEntry(*cache, "meta", "index.json")->makeEternal(true);
+            cache->SaveNow();
+        }
+        QVERIFY(!QFile::exists(FS::PathCombine(dir.path(), "metacache.d/libraries.journal")));
+
+        auto cache = makeCache(dir);
+        auto entry = cache->getEntry("libraries", "org/lwjgl/lwjgl/3.3.1/lwjgl-3.3.1.jar");
+        QVERIFY(entry);
+        QVERIFY(!entry->isStale());
+        QCOMPARE(entry->getMD5Sum(), QString("d41d8cd98f00b204e9800998ecf8427e"));
+        QCOMPARE(entry->getETag(), QString("\"org/lwjgl/lwjgl/3.3.1/lwjgl-3.3.1.jar\""));
+        QCOMPARE(entry->getRemoteChangedTimestamp(), QString("Tue, 14 Nov 2023 22:13:20 GMT"));
+        QCOMPARE(entry->getMaximumAge(), qint64(604800));
+        QVERIFY(!entry->isEternal());
+
+        QVERIFY(cache->getEntry("meta", "index.json"));
+    }
+
+    void test_JournalReplay()
+    {
+        QTemporaryDir dir;
+        auto writer = makeCache(dir);
+        addEntry(*writer, "libraries", "a.jar");
+        addEntry(*writer, "libraries", "b.jar");
+        writer->evictEntry(writer->getEntry("libraries", "a.jar"));
+
+        // nothing was compacted, so this only sees what is in the journal
+        QVERIFY(QFile::exists(FS::PathCombine(dir.path(), "metacache.d/libraries.journal")));
+        auto reader = makeCache(dir);
+        QVERIFY(!reader->getEntry("libraries", "a.jar"));
+        QVERIFY(reader->getEntry("libraries", "b.jar"));
+    }
+
+    void test_ShardsSaveIndependently()
+    {
+        QTemporaryDir dir;
+        auto cache = makeCache(dir);
+        addEntry(*cache, "libraries", "a.jar");
+        addEntry(*cache, "meta", "index.json");
+        cache->evictAll();
+        addEntry(*cache, "meta", "index.json");
+        QVERIFY(cache->SaveNow());
+
+        // both shards were rewritten, but only meta had anything in it
+        QVERIFY(QFile::exists(FS::PathCombine(dir.path(), "metacache.d/meta")));
+        QVERIFY(!QFile::exists(FS::PathCombine(dir.path(), "metacache.d/meta.journal")));
+
+        // a journal that is still small is left alone
+        addEntry(*cache, "libraries", "b.jar");
+        QVERIFY(cache->SaveNow());
+        QVERIFY(QFile::exists(FS::PathCombine(dir.path(), "metacache.d/libraries.journal")));
+        QVERIFY(!QFile::exists(FS::PathCombine(dir.path(), "metacache.d/meta.journal")));
+    }
+
+    void test_ResolveEntries()
+    {
+        QTemporaryDir dir;
+        auto cache = makeCache(dir);
+        FS::write(FS::PathCombine(dir.path(), "libraries/same.jar"), "");
+        FS::write(FS::PathCombine(dir.path(), "libraries/changed.jar"), "changed");
+        // both entries have the md5 of an empty file and an outdated timestamp, so both files get hashed
+        addEntry(*cache, "libraries", "same.jar");
+        addEntry(*cache, "libraries", "changed.jar");
+
+        QList<MetaEntryPtr> entries;
+        bool done = false;
+        cache->resolveEntries("libraries", { "same.jar", "changed.jar", "missing.jar" }, this, [&](QList<MetaEntryPtr> resolved) {
+            entries = resolved;
+            done = true;
+        });
+        // the files are hashed on the thread pool
+        QVERIFY(!done);
+        QTRY_VERIFY(done);
+        QCOMPARE(entries.size(), 3);
+        QVERIFY(!entries[0]->isStale());
+        QVERIFY(entries[1]->isStale());
+        QVERIFY(entries[2]->isStale());
+
+        // the verified timestamp is kept, the mismatching entry is gone
+        QVERIFY(cache->getEntry("libraries", "same.jar"));
+        QVERIFY(!cache->getEntry("libraries", "changed.jar"));
+        QVERIFY(!cache->resolveEntry("libraries", "same.jar")->isStale());
+
+        // nothing to hash this time
+        done = false;
+        cache->resolveEntries("libraries", { "same.jar" }, this, [&](QList<MetaEntryPtr> resolved) {
+            entries = resolved;
+            done = true;
+        });
+        QVERIFY(done);
+        QVERIFY(!entries[0]->isStale());
+    }
+
+    void test_MigrateJson()
+    {
+        QTemporaryDir dir;
+        auto index = FS::PathCombine(dir.path(), "metacache");
+        FS::write(index, R"({"version": "1", "entries": [
+            {"base": "libraries", "path": "a.jar", "md5sum": "abc", "etag": "\"1\"", "last_changed_timestamp": 42, "eternal": true},
+            {"base": "unknown", "path": "b.jar", "md5sum": "def", "etag": "\"2\"", "last_changed_timestamp": 42, "eternal": true}
+        ]})");
+
+        makeCache(dir);
+        QVERIFY(!QFile::exists(index));
+        QVERIFY(QFile::exists(FS::PathCombine(dir.path(), "metacache.d/libraries")));
+
+        auto cache = makeCache(dir);
+        auto entry = cache->getEntry("libraries", "a.jar");
+        QVERIFY(entry);
+        QCOMPARE(entry->getMD5Sum(), QString("abc"));
+        QVERIFY(entry->isEternal());
+    }
+
+    void test_MigrateFailed()
+    {
+        QTemporaryDir dir;
+        auto index = FS::PathCombine(dir.path(), "metacache");
+        FS::write(index, R"({"version": "1", "entries": [
+            {"base": "libraries", "path": "a.jar", "md5sum": "abc", "etag": "\"1\"", "last_changed_timestamp": 42, "eternal": true}
+        ]})");
+        // the shards can't be written where a file is in the way
+        FS::write(index + ".d", "");
+
+        makeCache(dir);
+        QVERIFY(QFile::exists(index));
+    }
+};
+
+QTEST_GUILESS_MAIN(HttpMetaCacheTest)
+
+#include "HttpMetaCache_test.moc"
@@ -0,0 +1,105 @@
+#include <QDateTime>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <Json.h>
+#include <minecraft/launch/LaunchFingerprint.h>
+
+class LaunchFingerprintTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+    QString m_file;
+    QStringList m_files;
+
+    LaunchFingerprint fingerprint(const QString& context = "64|amd64|linux") const { return LaunchFingerprint(m_file, context); }
+
+   private slots:
+    void init()
+    {
+        m_file = m_dir.filePath("cache/launch/instance.json");
+        m_files = { m_dir.filePath("mmc-pack.json"), m_dir.filePath("libraries/lib.jar") };
+        FS::write(m_files[0], "{}");
+        FS::write(m_files[1], "library");
+        QVERIFY(fingerprint().recordFiles(m_files));
+    }
+
+    void test_Matches()
+    {
+        QVERIFY(fingerprint().matches());
+        // nothing was recorded for another instance
+        QVERIFY(!LaunchFingerprint(m_dir.filePath("cache/launch/other.json"), "64|amd64|linux").matches());
+    }
+
+    void test_MissingFile()
+    {
+        QVERIFY(QFile::remove(m_files[1]));
+        QVERIFY(!fingerprint().matches());
+
+        // what is recorded has to be complete, so none is kept
+        QVERIFY(!fingerprint().recordFiles(m_files));
+        QVERIFY(!QFile::exists(m_file));
+    }
+
+    void test_ChangedFile()
+    {
+        QFile file(m_files[1]);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(file.fileTime(QFileDevice::FileModificationTime).addSecs(-60), QFileDevice::FileModificationTime));
+        file.close();
+        QVERIFY(!fingerprint().matches());
+
+        QVERIFY(fingerprint().recordFiles(m_files));
+        QVERIFY(fingerprint().matches());
+        FS::write(m_files[1], "another library");
+        QVERIFY(!fingerprint().matches());
+    }
+
+    void test_Context()
+    {
+        QVERIFY(!fingerprint("32|x86|linux").matches());
+    }
+
+    void test_Expiry()
+    {
+        auto root = Json::requireObject(Json::requireDocument(m_file));
+        root.insert("recorded", double(QDateTime::currentDateTime().addDays(-2).toMSecsSinceEpoch()));
+        Json::write(root, m_file);
+        QVERIFY(!fingerprint().matches());
+    }
+
+    void test_ExpiryAfterSkippedUpdates()
+    {
+        auto setRecorded = [this](const QDateTime& time) {
+            auto root = Json::requireObject(Json::requireDocument(m_file));
+            root.insert("recorded", double(time.toMSecsSinceEpoch()));
+            Json::write(root, m_file);
+        };
+        auto recorded = [this] { return qint64(Json::requireObject(Json::requireDocument(m_file)).value("recorded").toDouble()); };
+
+        // launches that skipped the update keep the time of the last one that didn't
+        auto updatedAt = QDateTime::currentDateTime().addSecs(-23 * 60 * 60);
+        setRecorded(updatedAt);
+        for (int i = 0; i < 3; i++) {
+            QVERIFY(fingerprint().matches());
+            QVERIFY(fingerprint().recordFiles(m_files, {}, {}, false));
+            QCOMPARE(recorded(), updatedAt.toMSecsSinceEpoch());
+        }
+
+        // so however often the instance is launched, the day runs out
+        setRecorded(updatedAt.addSecs(-2 * 60 * 60));
+        QVERIFY(!fingerprint().matches());
+        QVERIFY(fingerprint().recordFiles(m_files, {}, {}, false));
+        QVERIFY(!fingerprint().matches());
+
+        // until a launch goes through the update again
+        QVERIFY(fingerprint().recordFiles(m_files));
+        QVERIFY(fingerprint().matches());
+    }
+};
+
+QTEST_GUILESS_MAIN(LaunchFingerprintTest)
+
+#include "LaunchFingerprint_test.moc"
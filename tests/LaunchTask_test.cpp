@@ -0,0 +1,202 @@
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <launch/LaunchTask.h>
+#include <minecraft/MinecraftInstance.h>
+#include <settings/INISettingsObject.h>
+
+// a step that does nothing but record what happens to it, and is finished by the test
+class FakeStep : public LaunchStep {
+    Q_OBJECT
+   public:
+    FakeStep(LaunchTask* parent, QString name, QStringList& events) : LaunchStep(parent), m_name(name), m_events(events)
+    {
+        setAbortable(true);
+    }
+
+    QString name() const override { return m_name; }
+    void executeTask() override
+    {
+        m_events.append("start " + m_name);
+        if (reportProgress)
+            emit progressReportingRequest();
+    }
+    void proceed() override { m_events.append("proceed " + m_name); }
+    void finalize() override { m_events.append("finalize " + m_name); }
+
+    void log(const QString& line) { emit logLine(line, MessageLevel::Launcher); }
+    void succeed() { emitSucceeded(); }
+    void fail() { emitFailed(m_name + " failed"); }
+
+    bool reportProgress = false;
+
+   private:
+    QString m_name;
+    QStringList& m_events;
+};
+
+class LaunchTaskTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+    MinecraftInstancePtr m_instance;
+
+    shared_qobject_ptr<FakeStep> addStep(LaunchTask* task, const QString& name, QStringList& events)
+    {
+        auto step = makeShared<FakeStep>(task, name, events);
+        task->appendStep(step);
+        return step;
+    }
+
+    static QStringList lines(LogModel* model)
+    {
+        QStringList lines;
+        for (int i = 0; i < model->rowCount(); i++)
+            lines.append(model->data(model->index(i), Qt::DisplayRole).toString());
+        return lines;
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        // what an instance takes from the launcher's settings
+        auto global = std::make_shared<INISettingsObject>(m_dir.filePath("global.cfg"));
+        for (auto name : { "ShowGameTime", "RecordGameTime", "ShowConsole", "AutoCloseConsole", "ShowConsoleOnError", "LogPrePostOutput",
+                           "ConsoleOverflowStop", "ConsoleOverflowSpill" })
+            global->registerSetting(QString(name), false);
+        for (auto name : { "PreLaunchCommand", "WrapperCommand", "PostExitCommand" })
+            global->registerSetting(QString(name), QString());
+        global->registerSetting("ConsoleMaxLines", 100000);
+        global->registerSetting("ConsoleSpillMaxSize", 64);
+        auto settings = std::make_shared<INISettingsObject>(m_dir.filePath("instance/instance.cfg"));
+        m_instance = std::make_shared<MinecraftInstance>(global, settings, m_dir.filePath("instance"));
+    }
+
+    void cleanupTestCase() { m_instance.reset(); }
+
+    void test_DependencyOrder()
+    {
+        auto task = LaunchTask::create(m_instance);
+        QStringList events;
+        auto libraries = addStep(task.get(), "libraries", events);
+        libraries->declare({}, LaunchStep::Libraries);
+        auto natives = addStep(task.get(), "natives", events);
+        natives->declare(LaunchStep::Libraries, LaunchStep::Natives);
+        auto assets = addStep(task.get(), "assets", events);
+        assets->declare({}, LaunchStep::Assets);
+        // declares nothing, so it waits for all of them
+        auto launch = addStep(task.get(), "launch", events);
+
+        task->start();
+        QCOMPARE(events, QStringList({ "start libraries", "start assets" }));
+        libraries->succeed();
+        QCOMPARE(events.last(), QString("start natives"));
+        natives->succeed();
+        QCOMPARE(events.size(), 3);
+        assets->succeed();
+        QCOMPARE(events.last(), QString("start launch"));
+        launch->succeed();
+
+        QVERIFY(task->wasSuccessful());
+        // the other way around than they started
+        QCOMPARE(events.mid(4), QStringList({ "finalize launch", "finalize natives", "finalize assets", "finalize libraries" }));
+    }
+
+    void test_LogOrder()
+    {
+        auto task = LaunchTask::create(m_instance);
+        QStringList events;
+        auto first = addStep(task.get(), "first", events);
+        first->declare({}, LaunchStep::Libraries);
+        auto second = addStep(task.get(), "second", events);
+        second->declare({}, LaunchStep::Assets);
+
+        task->start();
+        // the second step is done before the first, its lines still come after the first one's
+        second->log("from the second step");
+        second->succeed();
+        first->log("from the first step");
+        first->succeed();
+
+        auto model = task->getLogModel();
+        QTRY_COMPARE(model->rowCount(), 2);
+        QCOMPARE(lines(model.get()), QStringList({ "from the first step", "from the second step" }));
+    }
+
+    void test_Failure()
+    {
+        auto task = LaunchTask::create(m_instance);
+        QStringList events;
+        auto libraries = addStep(task.get(), "libraries", events);
+        libraries->declare({}, LaunchStep::Libraries);
+        auto assets = addStep(task.get(), "assets", events);
+        assets->declare({}, LaunchStep::Assets);
+        auto natives = addStep(task.get(), "natives", events);
+        natives->declare(LaunchStep::Libraries, LaunchStep::Natives);
+
+        task->start();
+        libraries->fail();
+
+        // the step running alongside is aborted, the one waiting for the failed one never starts
+        QCOMPARE(assets->getState(), Task::State::AbortedByUser);
+        QCOMPARE(natives->getState(), Task::State::Inactive);
+        QVERIFY(task->isFinished());
+        QVERIFY(!task->wasSuccessful());
+        QCOMPARE(task->failReason(), QString("libraries failed"));
+        QCOMPARE(events, QStringList({ "start libraries", "start assets", "finalize assets", "finalize libraries" }));
+    }
+
+    void test_Abort()
+    {
+        auto task = LaunchTask::create(m_instance);
+        QStringList events;
+        auto libraries = addStep(task.get(), "libraries", events);
+        libraries->declare({}, LaunchStep::Libraries);
+        auto assets = addStep(task.get(), "assets", events);
+        assets->declare({}, LaunchStep::Assets);
+        auto launch = addStep(task.get(), "launch", events);
+
+        task->start();
+        QVERIFY(task->canAbort());
+        QVERIFY(task->abort());
+
+        QCOMPARE(libraries->getState(), Task::State::AbortedByUser);
+        QCOMPARE(assets->getState(), Task::State::AbortedByUser);
+        QCOMPARE(launch->getState(), Task::State::Inactive);
+        QVERIFY(task->isFinished());
+        QVERIFY(!task->wasSuccessful());
+    }
+
+    void test_ProgressQueue()
+    {
+        auto task = LaunchTask::create(m_instance);
+        QSignalSpy requests(task.get(), &LaunchTask::requestProgress);
+        QStringList events;
+        auto libraries = addStep(task.get(), "libraries", events);
+        libraries->declare({}, LaunchStep::Libraries);
+        libraries->reportProgress = true;
+        auto assets = addStep(task.get(), "assets", events);
+        assets->declare({}, LaunchStep::Assets);
+        assets->reportProgress = true;
+
+        task->start();
+        // one step's progress is shown at a time, the other one goes on meanwhile
+        QCOMPARE(events, QStringList({ "start libraries", "start assets", "proceed assets" }));
+        QTRY_COMPARE(requests.count(), 1);
+        QCOMPARE(requests[0][0].value<Task*>(), libraries.get());
+        task->proceed();
+        QCOMPARE(events.last(), QString("proceed libraries"));
+
+        // and is shown once the first one is done
+        libraries->succeed();
+        QTRY_COMPARE(requests.count(), 2);
+        QCOMPARE(requests[1][0].value<Task*>(), assets.get());
+        assets->succeed();
+        QVERIFY(task->wasSuccessful());
+    }
+};
+
+QTEST_GUILESS_MAIN(LaunchTaskTest)
+
+#include "LaunchTask_test.moc"
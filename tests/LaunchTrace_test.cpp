@@ -0,0 +1,54 @@
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <Json.h>
+#include <launch/LaunchTrace.h>
+
+class LaunchTraceTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_Save()
+    {
+        QTemporaryDir dir;
+        LaunchTrace trace;
+        auto first = trace.begin("CreateGameFolders", "step");
+        auto second = trace.begin("LibrariesTask", "step");
+        auto task = trace.begin("LibrariesTask", "task", second);
+        QTest::qSleep(5);
+        trace.end(task);
+        trace.end(first);
+        trace.end(second);
+        // the first row is free again
+        auto third = trace.begin("ScanModFolders", "step");
+
+        auto path = dir.filePath("launch-trace.json");
+        QVERIFY(trace.save(path));
+        auto events = Json::requireObject(Json::requireDocument(path), "trace").value("traceEvents").toArray();
+        QCOMPARE(events.size(), 4);
+
+        auto event = [&](int index) { return events.at(index).toObject(); };
+        QCOMPARE(event(first)["name"].toString(), QString("CreateGameFolders"));
+        QCOMPARE(event(first)["ph"].toString(), QString("X"));
+        QCOMPARE(event(first)["tid"].toInt(), 0);
+        QCOMPARE(event(second)["tid"].toInt(), 1);
+        QCOMPARE(event(task)["tid"].toInt(), 1);
+        QCOMPARE(event(task)["cat"].toString(), QString("task"));
+        QCOMPARE(event(third)["tid"].toInt(), 0);
+        QVERIFY(event(task)["dur"].toDouble() >= 5000);
+        QVERIFY(event(task)["ts"].toDouble() >= event(second)["ts"].toDouble());
+        QVERIFY(event(third)["args"].toObject()["running"].toBool());
+        QVERIFY(!event(first)["args"].toObject().contains("running"));
+
+        auto summary = trace.summary();
+        QCOMPARE(summary.size(), 5);
+        QVERIFY(summary.last().contains("ScanModFolders"));
+        QVERIFY(summary.last().contains("running"));
+    }
+};
+
+QTEST_GUILESS_MAIN(LaunchTraceTest)
+
+#include "LaunchTrace_test.moc"
@@ -0,0 +1,44 @@
+#include <QTest>
+
+#include <minecraft/LogLevelClassifier.h>
+
+Q_DECLARE_METATYPE(MessageLevel::Enum)
+
+class LogLevelClassifierTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_Classify_data()
+    {
+        QTest::addColumn<QString>("line");
+        QTest::addColumn<MessageLevel::Enum>("level");
+
+        QTest::newRow("log4j info") << "[12:34:56] [Render thread/INFO]: Setting user: Steve" << MessageLevel::Message;
+        QTest::newRow("log4j warn") << "[12:34:56] [main/WARN]: Something is off" << MessageLevel::Warning;
+        QTest::newRow("log4j debug") << "[12:34:56] [modloading-worker-0/DEBUG] [net.minecraftforge/]: Loading" << MessageLevel::Debug;
+        QTest::newRow("log4j after prefix") << "Client> [12:34:56] [main/ERROR]: Broken" << MessageLevel::Error;
+        QTest::newRow("log4j unknown level") << "[12:34:56] [main/NOTICE]: Hi" << MessageLevel::StdOut;
+        QTest::newRow("log4j header wins over tags") << "[12:34:56] [main/INFO]: [SEVERE] not really" << MessageLevel::Message;
+        QTest::newRow("old forge") << "2013-01-01 12:00:00 [SEVERE] [ForgeModLoader] Oops" << MessageLevel::Error;
+        QTest::newRow("old forge, last tag wins") << "[INFO] [DEBUG] [WARNING]" << MessageLevel::Debug;
+        QTest::newRow("nested bracket") << "[[WARNING]" << MessageLevel::Warning;
+        QTest::newRow("plain") << "Hello there" << MessageLevel::StdOut;
+        QTest::newRow("fatal") << "[12:34:56] [main/INFO]: overwriting existing entry" << MessageLevel::Fatal;
+        QTest::newRow("stack frame") << "\tat net.minecraft.client.Minecraft.run(Minecraft.java:123)" << MessageLevel::Error;
+        QTest::newRow("caused by") << "Caused by: java.lang.NullPointerException" << MessageLevel::Error;
+        QTest::newRow("exception name") << "[12:34:56] [main/INFO]: got a java.io.IOException" << MessageLevel::Error;
+        QTest::newRow("more") << "\t... 12 more" << MessageLevel::Error;
+        QTest::newRow("hint without match") << "look at me" << MessageLevel::StdOut;
+    }
+
+    void test_Classify()
+    {
+        QFETCH(QString, line);
+        QFETCH(MessageLevel::Enum, level);
+        QCOMPARE(LogLevelClassifier::minecraft()->classify(line, MessageLevel::StdOut), level);
+    }
+};
+
+QTEST_GUILESS_MAIN(LogLevelClassifierTest)
+
+#include "LogLevelClassifier_test.moc"
@@ -0,0 +1,152 @@
+#include <QTest>
+
+#include <launch/LogModel.h>
+
+class LogModelTest : public QObject {
+    Q_OBJECT
+
+    static QString line(LogModel& model, int row) { return model.data(model.index(row), Qt::DisplayRole).toString(); }
+    static int level(LogModel& model, int row) { return model.data(model.index(row), LogModel::LevelRole).toInt(); }
+
+   private slots:
+    void test_Wrap()
+    {
+        LogModel model;
+        model.setMaxLines(3);
+        for (int i = 0; i < 5; i++)
+            model.append(i % 2 ? MessageLevel::Warning : MessageLevel::Error, QString("line %1 ü").arg(i));
+
+        QCOMPARE(model.rowCount(), 3);
+        QCOMPARE(line(model, 0), QString("line 2 ü"));
+        QCOMPARE(level(model, 0), int(MessageLevel::Error));
+        QCOMPARE(line(model, 2), QString("line 4 ü"));
+        QCOMPARE(level(model, 1), int(MessageLevel::Warning));
+        QCOMPARE(model.toPlainText(), QString("line 2 ü\nline 3 ü\nline 4 ü\n"));
+    }
+
+    void test_SetMaxLines()
+    {
+        LogModel model;
+        model.setMaxLines(4);
+        for (int i = 0; i < 6; i++)
+            model.append(MessageLevel::Message, QString::number(i));
+
+        // shrinking across the wrap boundary keeps the newest lines
+        model.setMaxLines(2);
+        QCOMPARE(model.rowCount(), 2);
+        QCOMPARE(model.toPlainText(), QString("4\n5\n"));
+
+        model.setMaxLines(10);
+        model.append(MessageLevel::Message, "6");
+        QCOMPARE(model.rowCount(), 3);
+        QCOMPARE(model.toPlainText(), QString("4\n5\n6\n"));
+    }
+
+    void test_StopOnOverflow()
+    {
+        LogModel model;
+        model.setMaxLines(3);
+        model.setStopOnOverflow(true);
+        model.setOverflowMessage("too much");
+        model.append({ { MessageLevel::Message, "a" }, { MessageLevel::Message, "b" } });
+        model.append({ { MessageLevel::Message, "c" }, { MessageLevel::Message, "d" } });
+        model.append(MessageLevel::Message, "e");
+
+        QCOMPARE(model.toPlainText(), QString("a\nb\ntoo much\n"));
+        QCOMPARE(level(model, 2), int(MessageLevel::Fatal));
+    }
+
+    void test_LongLines()
+    {
+        LogModel model;
+        model.setMaxLines(2);
+        QString big(200000, 'x');
+        model.append(MessageLevel::Message, big);
+        model.append(MessageLevel::Message, "small");
+        QCOMPARE(line(model, 0), big);
+        QCOMPARE(line(model, 1), QString("small"));
+
+        // once scrolled out, its chunk is gone
+        model.append(MessageLevel::Message, "small");
+        QVERIFY(model.memoryUsage() < 100000);
+
+        model.clear();
+        QCOMPARE(model.rowCount(), 0);
+        model.append(MessageLevel::Message, "after clear");
+        QCOMPARE(line(model, 0), QString("after clear"));
+    }
+
+    void test_MemoryPer100kLines()
+    {
+        LogModel model;
+        model.setMaxLines(100000);
+        // a typical line of a modded game log
+        auto text = QString("[12:34:56] [Worker-Main-12/INFO] [mixin/]: Mixing common.MixinEntity from examplemod.mixins.json into %1");
+        for (int i = 0; i < 200000; i++)
+            model.append(MessageLevel::Message, text.arg(i));
+
+        QCOMPARE(model.rowCount(), 100000);
+        auto perLine = model.memoryUsage() / 100000;
+        qDebug() << "bytes per line:" << perLine << "of which text:" << text.arg(199999).toUtf8().size();
+        // as QStrings in their own allocations this was well above 250, without any search index
+        QVERIFY(perLine < 200);
+    }
+
+    void test_FindText()
+    {
+        LogModel model;
+        model.setMaxLines(100);
+        for (int i = 0; i < 150; i++)
+            model.append(MessageLevel::Message, QString("old %1").arg(i));
+        // only 72 and up are left, the older ones were dropped along with their index
+        model.append(MessageLevel::Message, "Loading Mod ExampleMod");
+        for (int i = 0; i < 20; i++)
+            model.append(MessageLevel::Message, QString("filler %1").arg(i));
+        model.append(MessageLevel::Message, "loaded examplemod in 5ms");
+
+        QCOMPARE(model.rowCount(), 100);
+        QCOMPARE(model.findText("examplemod", -1, false), 78);
+        QCOMPARE(model.findText("examplemod", 78, false), 99);
+        // wraps around
+        QCOMPARE(model.findText("examplemod", 99, false), 78);
+        QCOMPARE(model.findText("examplemod", 99, true), 78);
+        QCOMPARE(model.findText("examplemod", 78, true), 99);
+        QCOMPARE(model.findText("examplemod", 0, false, Qt::CaseSensitive), 99);
+        QCOMPARE(model.findText("filler 3", 0, false), 82);
+        QCOMPARE(model.findText("ab", 0, false), -1);
+        QCOMPARE(model.findText("old 5", -1, false), -1);
+        QCOMPARE(model.findText("nowhere in the log", -1, false), -1);
+        QCOMPARE(model.findRegularExpression(QRegularExpression("in \\d+ms$"), -1, false), 99);
+
+        model.clear();
+        QCOMPARE(model.findText("examplemod", -1, false), -1);
+        model.append(MessageLevel::Message, "ExampleMod again");
+        QCOMPARE(model.findText("examplemod", -1, false), 0);
+    }
+
+    void test_FindLevel()
+    {
+        LogModel model;
+        model.setMaxLines(10);
+        for (int i = 0; i < 15; i++)
+            model.append(i % 4 == 0 ? MessageLevel::Error : i == 13 ? MessageLevel::Fatal : MessageLevel::Message, QString::number(i));
+
+        // lines 5 to 14 are left, with errors at 8 and 12 and a fatal error at 13
+        QCOMPARE(model.rowsAtLevel(MessageLevel::Error), QVector<int>({ 3, 7, 8 }));
+        QCOMPARE(model.rowsAtLevel(MessageLevel::Fatal), QVector<int>({ 8 }));
+        QCOMPARE(model.findLevel(MessageLevel::Error, -1, false), 3);
+        QCOMPARE(model.findLevel(MessageLevel::Error, 3, false), 7);
+        QCOMPARE(model.findLevel(MessageLevel::Error, 8, false), 3);
+        QCOMPARE(model.findLevel(MessageLevel::Error, 3, true), 8);
+        QCOMPARE(model.findLevel(MessageLevel::Error, 8, true), 7);
+        QCOMPARE(model.findLevel(MessageLevel::Warning, 0, false), 3);
+        QCOMPARE(model.toPlainText(MessageLevel::Error), QString("8\n12\n13\n"));
+
+        model.setMaxLines(4);
+        QCOMPARE(model.rowsAtLevel(MessageLevel::Error), QVector<int>({ 1, 2 }));
+    }
+};
+
+QTEST_GUILESS_MAIN(LogModelTest)
+
+#include "LogModel_test.moc"
@@ -0,0 +1,108 @@
+#include <QTest>
+#include <QTextCodec>
+
+#include <launch/LogModel.h>
+#include <launch/LogPipeline.h>
+
+class LogPipelineTest : public QObject {
+    Q_OBJECT
+
+    static QString lastLine(LogModel& model) { return model.data(model.index(model.rowCount() - 1), Qt::DisplayRole).toString(); }
+
+    static void connectModel(LogPipeline& pipeline, LogModel& model)
+    {
+        connect(&pipeline, &LogPipeline::linesReady, &model, QOverload<const QVector<LogModel::Line>&>::of(&LogModel::append));
+    }
+
+   private slots:
+    void test_Lines()
+    {
+        LogModel model;
+        LogPipeline pipeline([](const QString& line, MessageLevel::Enum level) { return line.contains("WARN") ? MessageLevel::Warning : level; },
+                             model.getMaxLines(), false);
+        connectModel(pipeline, model);
+        pipeline.setCodec(QTextCodec::codecForName("UTF-8"));
+        pipeline.setCensorFilter(CensorFilter({ { "secret", "<SECRET>" } }));
+
+        // lines split across chunks and streams, with windows line endings
+        pipeline.addData("first li", MessageLevel::StdOut);
+        pipeline.addData("[WARN] err", MessageLevel::StdErr);
+        pipeline.addData("ne\r\nsecret line\n", MessageLevel::StdOut);
+        pipeline.addData("or\n", MessageLevel::StdErr);
+        pipeline.addLines({ "!![Error]!from the launcher part" }, MessageLevel::StdOut);
+
+        QTRY_COMPARE(model.rowCount(), 4);
+        auto level = [&model](int row) { return model.data(model.index(row), LogModel::LevelRole).toInt(); };
+        QCOMPARE(model.data(model.index(0), Qt::DisplayRole).toString(), QString("first line"));
+        QCOMPARE(model.data(model.index(1), Qt::DisplayRole).toString(), QString("<SECRET> line"));
+        QCOMPARE(model.data(model.index(2), Qt::DisplayRole).toString(), QString("[WARN] error"));
+        QCOMPARE(level(2), int(MessageLevel::Warning));
+        QCOMPARE(model.data(model.index(3), Qt::DisplayRole).toString(), QString("from the launcher part"));
+        QCOMPARE(level(3), int(MessageLevel::Error));
+    }
+
+    void test_StopOnOverflow()
+    {
+        LogModel model;
+        model.setMaxLines(100);
+        model.setStopOnOverflow(true);
+        model.setOverflowMessage("full");
+        LogPipeline pipeline(nullptr, 100, true);
+        connectModel(pipeline, model);
+
+        QStringList lines;
+        for (int i = 0; i < 1000; i++)
+            lines << QString::number(i);
+        pipeline.addLines(lines, MessageLevel::Message);
+
+        QTRY_COMPARE(model.rowCount(), 100);
+        QCOMPARE(model.data(model.index(98), Qt::DisplayRole).toString(), QString("98"));
+        QCOMPARE(lastLine(model), QString("full"));
+    }
+
+    void test_FlushOnDestroy()
+    {
+        LogModel model;
+        {
+            LogPipeline pipeline(nullptr, model.getMaxLines(), false);
+            connectModel(pipeline, model);
+            for (int i = 0; i < 10; i++)
+                pipeline.addLines({ QString::number(i) }, MessageLevel::Message);
+        }
+        QCOMPARE(model.rowCount(), 10);
+        QCOMPARE(lastLine(model), QString("9"));
+    }
+
+    void test_Storm()
+    {
+        // a crashing mod spamming the log, as a fake process writing 500k lines in pipe sized chunks
+        const int total = 500000;
+        LogModel model;
+        model.setMaxLines(10000);
+        LogPipeline pipeline([](const QString&, MessageLevel::Enum level) { return level; }, model.getMaxLines(), false);
+        connectModel(pipeline, model);
+        int batches = 0;
+        connect(&pipeline, &LogPipeline::linesReady, this, [&batches] { batches++; });
+
+        QByteArray chunk;
+        for (int i = 0; i < total; i++) {
+            chunk += "[12:00:00] [main/ERROR]: Exception ticking world, line " + QByteArray::number(i) + '\n';
+            if (chunk.size() >= 65536) {
+                pipeline.addData(chunk, MessageLevel::StdOut);
+                chunk.clear();
+            }
+        }
+        pipeline.addData(chunk, MessageLevel::StdOut);
+
+        QTRY_COMPARE_WITH_TIMEOUT(lastLine(model), QString("[12:00:00] [main/ERROR]: Exception ticking world, line %1").arg(total - 1), 60000);
+        QCOMPARE(model.rowCount(), 10000);
+        QCOMPARE(model.data(model.index(0), Qt::DisplayRole).toString(),
+                 QString("[12:00:00] [main/ERROR]: Exception ticking world, line %1").arg(total - 10000));
+        // the GUI side sees batches, not lines
+        QVERIFY(batches < total / 10);
+    }
+};
+
+QTEST_GUILESS_MAIN(LogPipelineTest)
+
+#include "LogPipeline_test.moc"
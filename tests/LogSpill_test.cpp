@@ -0,0 +1,118 @@
+#include <QDateTime>
+#include <QDir>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <GZip.h>
+#include <launch/LogModel.h>
+#include <launch/LogSpill.h>
+
+class LogSpillTest : public QObject {
+    Q_OBJECT
+
+    static QStringList files(const QString& folder) { return QDir(folder).entryList({ "console-*.log.gz" }, QDir::Files); }
+
+   private slots:
+    void test_Spill()
+    {
+        QTemporaryDir folder;
+        LogModel model;
+        model.setMaxLines(10);
+        model.setSpill(std::make_unique<LogSpill>(folder.path(), "console", 64 * 1024 * 1024));
+        auto spill = model.spill();
+
+        for (int i = 0; i < 10000; i++)
+            model.append(i % 1000 == 0 ? MessageLevel::Error : MessageLevel::Message, QString("line %1").arg(i));
+        // lines that would scroll out right away go to the spill too
+        QVector<LogModel::Line> batch;
+        for (int i = 10000; i < 10020; i++)
+            batch.append({ MessageLevel::Message, QString("line %1").arg(i) });
+        model.append(batch);
+
+        QCOMPARE(model.rowCount(), 10);
+        QCOMPARE(model.data(model.index(0), Qt::DisplayRole).toString(), QString("line 10010"));
+        QCOMPARE(spill->firstLine(), 0);
+        QCOMPARE(spill->lineCount(), 10010);
+        QCOMPARE(model.spillLine(0), 10010);
+        QCOMPARE(model.spillLine(-1), 10009);
+
+        auto lines = spill->lines(4095, 3);
+        QCOMPARE(lines.size(), 3);
+        QCOMPARE(lines[0].text, QString("line 4095"));
+        QCOMPARE(lines[2].text, QString("line 4097"));
+        // the pending ones, not written yet
+        QCOMPARE(spill->lines(10005, 10).last().text, QString("line 10009"));
+
+        QCOMPARE(spill->findText("LINE 4242", -1, false), 4242);
+        QCOMPARE(spill->findText("line 4242", 4242, false), -1);
+        QCOMPARE(spill->findText("line 999", spill->lineCount(), true), 9999);
+        QCOMPARE(spill->findLevel(MessageLevel::Error, 1000, false), 2000);
+        QCOMPARE(spill->findLevel(MessageLevel::Error, 1000, true), 0);
+        QCOMPARE(spill->findLevel(MessageLevel::Fatal, -1, false), -1);
+
+        // the file is a plain gzip file of the log
+        spill->flush();
+        QCOMPARE(files(folder.path()).size(), 1);
+        QByteArray text;
+        QVERIFY(GZip::unzip(FS::read(spill->currentFile()), text));
+        QCOMPARE(text.count('\n'), 10010);
+        QVERIFY(text.startsWith("line 0\nline 1\n"));
+        QVERIFY(text.endsWith("line 10009\n"));
+    }
+
+    void test_Clear()
+    {
+        QTemporaryDir folder;
+        LogModel model;
+        model.setSpill(std::make_unique<LogSpill>(folder.path(), "console", 64 * 1024 * 1024));
+        model.append(MessageLevel::Launcher, "launching\nthe game");
+        model.clear();
+
+        QCOMPARE(model.spill()->lineCount(), 1);
+        QCOMPARE(model.spill()->lines(0, 1).first().text, QString("launching the game"));
+        QCOMPARE(model.spill()->lines(0, 1).first().level, MessageLevel::Launcher);
+        QCOMPARE(model.spillLine(0), 1);
+    }
+
+    void test_Prune()
+    {
+        QTemporaryDir folder;
+        auto old = FS::PathCombine(folder.path(), "console-2000-01-01-000000.log.gz");
+        FS::write(old, QByteArray(4096, 'x'));
+        QFile oldFile(old);
+        QVERIFY(oldFile.open(QIODevice::ReadWrite));
+        QVERIFY(oldFile.setFileTime(QDateTime(QDate(2000, 1, 1), QTime(0, 0)), QFileDevice::FileModificationTime));
+        oldFile.close();
+        auto unrelated = FS::PathCombine(folder.path(), "latest.log");
+        FS::write(unrelated, "not ours");
+
+        const qint64 maxSize = 8 * 1024;
+        LogSpill spill(folder.path(), "console", maxSize);
+        auto random = QRandomGenerator(42);
+        for (int block = 0; block < 20; block++) {
+            for (int i = 0; i < 100; i++)
+                spill.add(MessageLevel::Message, QString::number(random.generate64(), 16).repeated(4));
+            spill.flush();
+        }
+
+        QVERIFY(!QFile::exists(old));
+        QVERIFY(QFile::exists(unrelated));
+        qint64 total = 0;
+        for (auto& file : files(folder.path()))
+            total += QFileInfo(FS::PathCombine(folder.path(), file)).size();
+        // the file being written is never deleted, even if it alone is over the limit
+        QVERIFY(total <= maxSize || files(folder.path()).size() == 1);
+
+        QVERIFY(spill.firstLine() > 0);
+        QCOMPARE(spill.lineCount(), 2000);
+        QCOMPARE(spill.lines(spill.firstLine(), 1).size(), 1);
+        // pruned lines are just gone
+        QVERIFY(spill.lines(0, 1).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(LogSpillTest)
+
+#include "LogSpill_test.moc"
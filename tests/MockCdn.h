@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QSet>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+/* Answers every request with body_size bytes, after a fixed delay to mimic a far away CDN. */
+class MockCdn : public QTcpServer {
+   public:
+    int latency_ms = 20;
+    int body_size = 1024;
+    // paths answered with a 503 the first time they are asked for
+    QSet<QByteArray> fail_once;
+    // every path asked for so far, in order
+    QList<QByteArray> paths;
+
+   protected:
+    void incomingConnection(qintptr handle) override
+    {
+        auto socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] {
+            auto request = socket->property("request").toByteArray() + socket->readAll();
+            socket->setProperty("request", request);
+            if (!request.contains("\r\n\r\n"))
+                return;
+            auto path = request.split(' ').value(1);
+            paths.append(path);
+            bool fail = fail_once.remove(path);
+            QTimer::singleShot(latency_ms, socket, [this, socket, fail] {
+                QByteArray response;
+                if (fail) {
+                    response = "HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+                } else {
+                    response = "HTTP/1.1 200 OK\r\nContent-Length: " + QByteArray::number(body_size) + "\r\nConnection: close\r\n\r\n";
+                    response += QByteArray(body_size, 'x');
+                }
+                socket->write(response);
+                socket->disconnectFromHost();
+            });
+        });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+};
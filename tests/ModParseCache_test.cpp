@@ -0,0 +1,101 @@
+#include <QDateTime>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+
+#include <minecraft/mod/ModParseCache.h>
+#include <minecraft/mod/tasks/LocalModParseTask.h>
+
+class ModParseCacheTest : public QObject {
+    Q_OBJECT
+
+    static QString makeMod(const QTemporaryDir& dir, int n, const QString& version)
+    {
+        auto root = dir.filePath(QString("src/mod%1").arg(n));
+        auto info = QString(R"({ "schemaVersion": 1, "id": "mod%1", "name": "Mod %1", "version": "%2", "authors": [ "someone" ] })")
+                        .arg(n)
+                        .arg(version);
+        FS::write(FS::PathCombine(root, "fabric.mod.json"), info.toUtf8());
+        // something to skip over, like the classes of a real mod
+        FS::write(FS::PathCombine(root, "Mod.class"), QByteArray(64 * 1024, char(n)));
+        auto jar = dir.filePath(QString("mods/mod%1.jar").arg(n));
+        FS::ensureFilePathExists(jar);
+        QFileInfoList files{ QFileInfo(FS::PathCombine(root, "fabric.mod.json")), QFileInfo(FS::PathCombine(root, "Mod.class")) };
+        MMCZip::compressDirFiles(jar, root, files);
+        return jar;
+    }
+
+    static ModDetails parse(const QString& jar, std::shared_ptr<ModParseCache> cache)
+    {
+        LocalModParseTask task(0, ResourceType::ZIPFILE, QFileInfo(jar), cache);
+        task.start();
+        return task.result()->details;
+    }
+
+   private slots:
+    void test_Cache()
+    {
+        const int count = 5;
+        QTemporaryDir dir;
+        QStringList jars;
+        for (int i = 0; i < count; i++)
+            jars << makeMod(dir, i, "1.0.0");
+        auto cacheFile = dir.filePath("cache/mods.json");
+
+        auto cache = std::make_shared<ModParseCache>(cacheFile, dir.filePath("mods"));
+        QList<ModDetails> cold;
+        for (auto& jar : jars)
+            cold << parse(jar, cache);
+        cache->save();
+
+        // as in a later session
+        cache = std::make_shared<ModParseCache>(cacheFile, dir.filePath("mods"));
+        QList<ModDetails> warm;
+        for (auto& jar : jars)
+            warm << parse(jar, cache);
+
+        for (int i = 0; i < count; i++) {
+            QCOMPARE(cold[i].mod_id, QString("mod%1").arg(i));
+            QCOMPARE(warm[i].mod_id, cold[i].mod_id);
+            QCOMPARE(warm[i].name, cold[i].name);
+            QCOMPARE(warm[i].version, cold[i].version);
+            QCOMPARE(warm[i].authors, cold[i].authors);
+        }
+    }
+
+    void test_Changed()
+    {
+        QTemporaryDir dir;
+        auto jar = makeMod(dir, 1, "1.0.0");
+        auto cacheFile = dir.filePath("cache/mods.json");
+        auto cache = std::make_shared<ModParseCache>(cacheFile, dir.filePath("mods"));
+        QCOMPARE(parse(jar, cache).version, QString("1.0.0"));
+        QVERIFY(cache->find(QFileInfo(jar)).has_value());
+
+        QFile::remove(jar);
+        makeMod(dir, 1, "2.0.0");
+        QFile file(jar);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(3600), QFileDevice::FileModificationTime));
+        file.close();
+
+        QVERIFY(!cache->find(QFileInfo(jar)).has_value());
+        QCOMPARE(parse(jar, cache).version, QString("2.0.0"));
+
+        // entries of mods that are gone aren't kept
+        cache->save();
+        QFile::remove(jar);
+        makeMod(dir, 2, "1.0.0");
+        cache->insert(QFileInfo(dir.filePath("mods/mod2.jar")), ModDetails());
+        cache->save();
+        cache = std::make_shared<ModParseCache>(cacheFile, dir.filePath("mods"));
+        QVERIFY(!FS::read(cacheFile).contains("mod1.jar"));
+        QVERIFY(cache->find(QFileInfo(dir.filePath("mods/mod2.jar"))).has_value());
+    }
+};
+
+QTEST_GUILESS_MAIN(ModParseCacheTest)
+
+#include "ModParseCache_test.moc"
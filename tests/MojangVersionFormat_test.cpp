@@ -1,7 +1,9 @@
 #include <QDebug>
 #include <QTest>
 
+#include <minecraft/LaunchProfile.h>
 #include <minecraft/MojangVersionFormat.h>
+#include <minecraft/OneSixVersionFormat.h>
 
 class MojangVersionFormatTest : public QObject {
     Q_OBJECT
@@ -43,6 +45,35 @@ class MojangVersionFormatTest : public QObject {
         writeJson("1.9-passthorugh.json", doc2);
         QCOMPARE(doc.toJson(), doc2.toJson());
     }
+
+    void test_LaunchProfile_Through()
+    {
+        QJsonDocument doc = readJson(QFINDTESTDATA("testdata/MojangVersionFormat/1.9.json"));
+        auto vfile = OneSixVersionFormat::versionFileFromJson(doc, "1.9.json", false);
+        vfile->uid = "net.minecraft";
+        RuntimeContext context;
+        context.system = "linux";
+        context.javaRealArchitecture = "amd64";
+        LaunchProfile profile;
+        vfile->applyTo(&profile, context);
+
+        auto json = OneSixVersionFormat::launchProfileToJson(&profile);
+        auto cached = OneSixVersionFormat::launchProfileFromJson(json);
+        QCOMPARE(OneSixVersionFormat::launchProfileToJson(cached.get()), json);
+
+        QCOMPARE(cached->getMainClass(), profile.getMainClass());
+        QCOMPARE(cached->getMinecraftVersion(), profile.getMinecraftVersion());
+        QCOMPARE(cached->getMinecraftAssets()->id, profile.getMinecraftAssets()->id);
+        QCOMPARE(cached->getLibraries().size(), profile.getLibraries().size());
+        QCOMPARE(cached->getNativeLibraries().size(), profile.getNativeLibraries().size());
+        QVERIFY(!cached->getNativeLibraries().isEmpty());
+
+        QStringList jars, nativeJars, cachedJars, cachedNativeJars;
+        profile.getLibraryFiles(context, jars, nativeJars, "", "");
+        cached->getLibraryFiles(context, cachedJars, cachedNativeJars, "", "");
+        QCOMPARE(cachedJars, jars);
+        QCOMPARE(cachedNativeJars, nativeJars);
+    }
 };
 
 QTEST_GUILESS_MAIN(MojangVersionFormatTest)
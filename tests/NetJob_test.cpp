@@ -0,0 +1,274 @@
+#include <QSignalSpy>
+#include <QTest>
+#include <QTimeZone>
+#include <QTimer>
+
+#include <algorithm>
+
+#include <net/ChecksumValidator.h>
+#include <net/HostScheduler.h>
+#include <net/NetJob.h>
+#include <net/RetryPolicy.h>
+
+#include "MockCdn.h"
+
+class NetJobTest : public QObject {
+    Q_OBJECT
+
+    static Task::Ptr makeTask() { return Net::Download::makeByteArray(QUrl("http://example.com/"), std::make_shared<QByteArray>()); }
+
+   private slots:
+    void test_SmallRequestsFirst()
+    {
+        Net::HostScheduler scheduler(1, 4, 8);
+        auto bulk = makeTask();
+        auto small = makeTask();
+        scheduler.add(bulk, "a", -1);
+        scheduler.add(small, "a", 4096);
+
+        QCOMPARE(scheduler.next(), small);
+        QVERIFY(!scheduler.next());
+        scheduler.finished(small.get(), false, 4096, 10);
+        QCOMPARE(scheduler.next(), bulk);
+    }
+
+    void test_PerHostLimit()
+    {
+        Net::HostScheduler scheduler(2, 4, 8);
+        QList<Task::Ptr> a;
+        for (int i = 0; i < 5; i++) {
+            a.append(makeTask());
+            scheduler.add(a.last(), "a", -1);
+        }
+        auto b = makeTask();
+        scheduler.add(b, "b", -1);
+
+        // hosts take turns, and neither goes past its limit
+        QCOMPARE(scheduler.next(), a[0]);
+        QCOMPARE(scheduler.next(), b);
+        QCOMPARE(scheduler.next(), a[1]);
+        QVERIFY(!scheduler.next());
+        QCOMPARE(scheduler.inFlight("a"), 2);
+        QCOMPARE(scheduler.inFlight("b"), 1);
+    }
+
+    void test_AdaptiveLimit()
+    {
+        Net::HostScheduler scheduler(2, 8, 8);
+        for (int i = 0; i < 10; i++)
+            scheduler.add(makeTask(), "a", -1);
+
+        // a full round without trouble allows one more request
+        auto first = scheduler.next();
+        auto second = scheduler.next();
+        scheduler.finished(first.get(), false, 1000, 10);
+        scheduler.finished(second.get(), false, 1000, 10);
+        QCOMPARE(scheduler.limit("a"), 3);
+
+        // congestion halves it, but only once for the requests that were already out
+        QList<Task::Ptr> running;
+        while (auto task = scheduler.next())
+            running.append(task);
+        QCOMPARE(running.size(), 3);
+        scheduler.finished(running[0].get(), true, 0, -1);
+        QCOMPARE(scheduler.limit("a"), 1);
+        scheduler.finished(running[1].get(), true, 0, -1);
+        QCOMPARE(scheduler.limit("a"), 1);
+
+        // a response far slower than the fastest one counts as congestion too
+        scheduler.finished(running[2].get(), false, 1000, 10);
+        auto slow = scheduler.next();
+        scheduler.finished(slow.get(), false, 1000, 5000);
+        QCOMPARE(scheduler.limit("a"), 1);
+    }
+
+    void test_TotalLimit()
+    {
+        Net::HostScheduler scheduler(2, 4, 3);
+        for (auto host : { "a", "b" }) {
+            for (int i = 0; i < 4; i++)
+                scheduler.add(makeTask(), host, -1);
+        }
+
+        // each host could run two, but no more than three run at all
+        QList<Task::Ptr> running;
+        while (auto task = scheduler.next())
+            running.append(task);
+        QCOMPARE(running.size(), 3);
+        scheduler.finished(running[0].get(), false, 1000, 10);
+        QVERIFY(scheduler.next());
+        QVERIFY(!scheduler.next());
+    }
+
+    void test_TotalLimitAcrossHosts()
+    {
+        MockCdn first;
+        MockCdn second;
+        QVERIFY(first.listen(QHostAddress::LocalHost));
+        QVERIFY(second.listen(QHostAddress::LocalHost));
+
+        auto network = makeShared<QNetworkAccessManager>();
+        NetJob::Ptr job{ new NetJob("total", network) };
+        job->setMaxConcurrent(3);
+        int running = 0;
+        int most_running = 0;
+        for (auto server : { &first, &second }) {
+            for (int i = 0; i < 20; i++) {
+                auto dl = Net::Download::makeByteArray(QUrl(QString("http://127.0.0.1:%1/%2").arg(server->serverPort()).arg(i)),
+                                                       std::make_shared<QByteArray>());
+                connect(dl.get(), &Task::started, this, [&running, &most_running] { most_running = std::max(most_running, ++running); });
+                connect(dl.get(), &Task::finished, this, [&running] { running--; });
+                job->addNetAction(dl);
+            }
+        }
+
+        QSignalSpy finished(job.get(), &Task::finished);
+        QSignalSpy succeeded(job.get(), &Task::succeeded);
+        job->start();
+        QVERIFY(finished.wait(10000));
+        QCOMPARE(succeeded.size(), 1);
+        QCOMPARE(first.paths.size() + second.paths.size(), 40);
+        // the setting is for the whole job, not for each host
+        QCOMPARE(most_running, 3);
+    }
+
+    void test_RetryAfter()
+    {
+        auto now = QDateTime(QDate(2015, 10, 21), QTime(7, 28, 0), QTimeZone::utc());
+        QCOMPARE(Net::RetryPolicy::parseRetryAfter("120", now), qint64(120000));
+        QCOMPARE(Net::RetryPolicy::parseRetryAfter("Wed, 21 Oct 2015 07:28:30 GMT", now), qint64(30000));
+        // a date in the past means right away
+        QCOMPARE(Net::RetryPolicy::parseRetryAfter("Wed, 21 Oct 2015 07:00:00 GMT", now), qint64(0));
+        QCOMPARE(Net::RetryPolicy::parseRetryAfter("", now), qint64(-1));
+        QCOMPARE(Net::RetryPolicy::parseRetryAfter("soon", now), qint64(-1));
+    }
+
+    void test_Retryable()
+    {
+        Net::RetryPolicy policy;
+        QVERIFY(policy.isRetryable(429, QNetworkReply::UnknownContentError));
+        QVERIFY(policy.isRetryable(503, QNetworkReply::ServiceUnavailableError));
+        QVERIFY(!policy.isRetryable(404, QNetworkReply::ContentNotFoundError));
+        QVERIFY(!policy.isRetryable(403, QNetworkReply::ContentAccessDenied));
+        QVERIFY(policy.isRetryable(0, QNetworkReply::RemoteHostClosedError));
+        // e.g. a checksum mismatch
+        QVERIFY(policy.isRetryable(200, QNetworkReply::NoError));
+    }
+
+    void test_HostFailure()
+    {
+        Net::RetryPolicy policy;
+        QVERIFY(policy.isHostFailure(429, QNetworkReply::UnknownContentError));
+        QVERIFY(policy.isHostFailure(503, QNetworkReply::ServiceUnavailableError));
+        QVERIFY(policy.isHostFailure(0, QNetworkReply::RemoteHostClosedError));
+        QVERIFY(policy.isHostFailure(0, QNetworkReply::ConnectionRefusedError));
+        QVERIFY(!policy.isHostFailure(404, QNetworkReply::ContentNotFoundError));
+        // a checksum mismatch or a failed write is worth another try, but the host did nothing wrong
+        QVERIFY(!policy.isHostFailure(200, QNetworkReply::NoError));
+        QVERIFY(!policy.isHostFailure(0, QNetworkReply::OperationCanceledError));
+    }
+
+    void test_CircuitBreaker()
+    {
+        Net::RetryPolicy policy;
+        policy.breaker_threshold = 2;
+        policy.breaker_cooldown_ms = 60 * 1000;
+        policy.recordFailure("breaker.test");
+        QCOMPARE(policy.blockedFor("breaker.test"), qint64(0));
+        policy.recordFailure("breaker.test");
+        QVERIFY(policy.blockedFor("breaker.test") > 0);
+        QCOMPARE(policy.blockedFor("other.test"), qint64(0));
+        QVERIFY(!policy.isDown("breaker.test"));
+        // every request let through after that fails too
+        for (int i = 0; i < policy.max_tries; i++)
+            policy.recordFailure("breaker.test");
+        QVERIFY(policy.isDown("breaker.test"));
+        policy.recordSuccess("breaker.test");
+        QCOMPARE(policy.blockedFor("breaker.test"), qint64(0));
+        QVERIFY(!policy.isDown("breaker.test"));
+    }
+
+    void test_RetryDoesNotBlockQueue()
+    {
+        MockCdn server;
+        server.fail_once.insert("/a");
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        auto network = makeShared<QNetworkAccessManager>();
+        // one request at a time, so the others could only overtake the retry if it waits on the side
+        NetJob::Ptr job{ new NetJob("retry", network, 1) };
+        for (auto path : { "a", "b", "c" })
+            job->addNetAction(Net::Download::makeByteArray(QUrl(QString("http://127.0.0.1:%1/%2").arg(server.serverPort()).arg(path)),
+                                                           std::make_shared<QByteArray>()));
+
+        QSignalSpy finished(job.get(), &Task::finished);
+        QSignalSpy succeeded(job.get(), &Task::succeeded);
+        job->start();
+        QVERIFY(finished.wait(10000));
+        QCOMPARE(succeeded.size(), 1);
+        QCOMPARE(server.paths, (QList<QByteArray>{ "/a", "/b", "/c", "/a" }));
+    }
+
+    void test_BlockedRequestKeepsItsPlace()
+    {
+        MockCdn down;
+        MockCdn up;
+        QVERIFY(down.listen(QHostAddress::LocalHost));
+        QVERIFY(up.listen(QHostAddress::LocalHost));
+
+        auto policy = std::make_shared<Net::RetryPolicy>();
+        policy->breaker_threshold = 1;
+        policy->breaker_cooldown_ms = 100;
+        policy->recordFailure(QString("127.0.0.1:%1").arg(down.serverPort()));
+
+        auto network = makeShared<QNetworkAccessManager>();
+        NetJob::Ptr job{ new NetJob("blocked", network, 1) };
+        job->setRetryPolicy(policy);
+        QStringList order;
+        auto add = [&](MockCdn& server, QString path) {
+            auto dl = Net::Download::makeByteArray(QUrl(QString("http://127.0.0.1:%1/%2").arg(server.serverPort()).arg(path)),
+                                                   std::make_shared<QByteArray>());
+            connect(dl.get(), &Task::succeeded, this, [&order, path] { order.append(path); });
+            job->addNetAction(dl);
+        };
+        add(down, "first");
+        for (int i = 0; i < 10; i++)
+            add(up, QString::number(i));
+
+        QSignalSpy finished(job.get(), &Task::finished);
+        QSignalSpy succeeded(job.get(), &Task::succeeded);
+        job->start();
+        QVERIFY(finished.wait(10000));
+        QCOMPARE(succeeded.size(), 1);
+        // once its host can be asked again it goes first, instead of after everything that was queued behind it
+        QVERIFY(order.indexOf("first") < order.size() - 1);
+    }
+
+    void test_BadDownloadKeepsHostOpen()
+    {
+        MockCdn server;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        auto policy = std::make_shared<Net::RetryPolicy>();
+        policy->breaker_threshold = 1;
+        policy->base_delay_ms = 10;
+        auto network = makeShared<QNetworkAccessManager>();
+        NetJob::Ptr job{ new NetJob("checksum", network) };
+        job->setRetryPolicy(policy);
+        auto dl = Net::Download::makeByteArray(QUrl(QString("http://127.0.0.1:%1/bad").arg(server.serverPort())),
+                                               std::make_shared<QByteArray>());
+        dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, QByteArray(20, '\0')));
+        job->addNetAction(dl);
+
+        QSignalSpy finished(job.get(), &Task::finished);
+        job->start();
+        QVERIFY(finished.wait(10000));
+        // every attempt was made, and the host is still there for everyone else
+        QCOMPARE(server.paths.size(), policy->max_tries);
+        QCOMPARE(policy->blockedFor(QString("127.0.0.1:%1").arg(server.serverPort())), qint64(0));
+    }
+};
+
+QTEST_GUILESS_MAIN(NetJobTest)
+
+#include "NetJob_test.moc"
@@ -82,6 +82,37 @@ class PackwizTest : public QObject {
         QCOMPARE(metadata.file_id, 3509043);
         QCOMPARE(metadata.project_id, 327154);
     }
+
+    void index()
+    {
+        QTemporaryDir dir;
+        QDir index_dir(dir.path());
+        QString source = QFINDTESTDATA("testdata/Packwiz");
+        for (auto& file_name : QDir(source).entryList(QDir::Files))
+            QVERIFY(QFile::copy(QDir(source).absoluteFilePath(file_name), index_dir.absoluteFilePath(file_name)));
+
+        auto index = Packwiz::Index::get(index_dir);
+        QVERIFY(Packwiz::Index::get(index_dir) == index);
+        index->refresh();
+        QCOMPARE(index->mods().size(), 2);
+
+        QCOMPARE(index->bySlug("borderless-mining").name, "Borderless Mining");
+        QCOMPARE(index->bySlug("borderless-mining").slug, "borderless-mining");
+        QCOMPARE(index->bySlug("Screenshot-To-Clipboard-Fabric").name, "Screenshot to Clipboard (Fabric)");
+        QCOMPARE(index->byModId(QString("kYq5qkSL")).name, "Borderless Mining");
+        QCOMPARE(index->byModId(327154).name, "Screenshot to Clipboard (Fabric)");
+        QCOMPARE(index->byFilename("screenshot-to-clipboard-1.0.7-fabric.jar").hash, "1781245820");
+        QCOMPARE(index->byHash("1781245820").filename, "screenshot-to-clipboard-1.0.7-fabric.jar");
+        QVERIFY(!index->byModId(QString("missing")).isValid());
+
+        // what changed in the folder shows up on the next refresh
+        QVariant mod_id = 327154;
+        Packwiz::V1::deleteModIndex(index_dir, mod_id);
+        QVERIFY(!index_dir.exists("screenshot-to-clipboard-fabric.pw.toml"));
+        index->refresh();
+        QCOMPARE(index->mods().size(), 1);
+        QVERIFY(!index->byHash("1781245820").isValid());
+    }
 };
 
 QTEST_GUILESS_MAIN(PackwizTest)
@@ -0,0 +1,84 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <modplatform/helpers/ResourceStore.h>
+
+class ResourceStoreTest : public QObject {
+    Q_OBJECT
+
+    static QString write(const QString& path, const QByteArray& data)
+    {
+        FS::write(path, data);
+        return Hashing::hash(path, Hashing::Algorithm::Sha512);
+    }
+
+   private slots:
+    void test_AddAndDeploy()
+    {
+        QTemporaryDir dir;
+        ResourceStore store(dir.filePath("store"));
+        auto source = dir.filePath("a/mods/mod.jar");
+        auto hash = write(source, "some mod");
+
+        QVERIFY(!store.deploy(Hashing::Algorithm::Sha512, hash, dir.filePath("b/mods/mod.jar")));
+        QVERIFY(store.add(source, Hashing::Algorithm::Sha512, hash));
+        QVERIFY(QFile::exists(store.blobPath(Hashing::Algorithm::Sha512, hash)));
+
+        QVERIFY(store.deploy(Hashing::Algorithm::Sha512, hash, dir.filePath("b/mods/mod.jar")));
+        QCOMPARE(FS::read(dir.filePath("b/mods/mod.jar")), QByteArray("some mod"));
+
+        // weak hashes are not trusted
+        QVERIFY(!store.add(source, Hashing::Algorithm::Md5, Hashing::hash(source, Hashing::Algorithm::Md5)));
+    }
+
+    void test_DeployedFilesAreCopies()
+    {
+        QTemporaryDir dir;
+        ResourceStore store(dir.filePath("store"));
+        auto source = dir.filePath("a/mod.jar");
+        auto hash = write(source, "some mod");
+        QVERIFY(store.add(source, Hashing::Algorithm::Sha512, hash));
+        auto blob = store.blobPath(Hashing::Algorithm::Sha512, hash);
+        QVERIFY(!(QFile::permissions(blob) & QFile::WriteOwner));
+
+        // changing a file in an instance leaves the blob alone
+        auto target = dir.filePath("b/mod.jar");
+        QVERIFY(store.deploy(Hashing::Algorithm::Sha512, hash, target));
+        QVERIFY(QFile::permissions(target) & QFile::WriteOwner);
+        FS::write(target, "something else");
+        QCOMPARE(FS::read(blob), QByteArray("some mod"));
+        QCOMPARE(FS::hardLinkCount(blob), uintmax_t(1));
+    }
+
+    void test_CollectGarbage()
+    {
+        QTemporaryDir dir;
+        ResourceStore store(dir.filePath("store"));
+        auto used = write(dir.filePath("instances/a/mods/used.jar"), "used");
+        auto unused = write(dir.filePath("unused.jar"), "unused");
+        QVERIFY(store.add(dir.filePath("instances/a/mods/used.jar"), Hashing::Algorithm::Sha512, used));
+        QVERIFY(store.add(dir.filePath("unused.jar"), Hashing::Algorithm::Sha512, unused));
+        // the last instance using it goes away
+        QFile::remove(dir.filePath("unused.jar"));
+
+        qint64 checked = -1;
+        auto report = store.collectGarbage({ dir.filePath("instances") }, [&checked](qint64 done, qint64 total) {
+            QVERIFY(done <= total);
+            checked = done;
+        });
+        QCOMPARE(report.blobs, 2);
+        QCOMPARE(report.unreferenced, QStringList{ store.blobPath(Hashing::Algorithm::Sha512, unused) });
+        QCOMPARE(report.unreferenced_bytes, qint64(6));
+        QCOMPARE(checked, qint64(1));
+        QVERIFY(QFile::exists(store.blobPath(Hashing::Algorithm::Sha512, unused)));
+
+        QCOMPARE(store.remove(report.unreferenced), 1);
+        QVERIFY(!QFile::exists(store.blobPath(Hashing::Algorithm::Sha512, unused)));
+        QVERIFY(QFile::exists(store.blobPath(Hashing::Algorithm::Sha512, used)));
+    }
+};
+
+QTEST_GUILESS_MAIN(ResourceStoreTest)
+
+#include "ResourceStore_test.moc"
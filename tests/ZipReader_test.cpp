@@ -0,0 +1,82 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <ZipReader.h>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+#include <quazip/quazipnewinfo.h>
+#include <zlib.h>
+
+class ZipReaderTest : public QObject {
+    Q_OBJECT
+
+    // method is 0 to store the files, Z_DEFLATED to compress them
+    static bool makeZip(const QString& path, const QList<QPair<QString, QByteArray>>& files, int method)
+    {
+        QuaZip zip(path);
+        if (!zip.open(QuaZip::mdCreate))
+            return false;
+        for (auto& [name, data] : files) {
+            QuaZipFile file(&zip);
+            if (!file.open(QIODevice::WriteOnly, QuaZipNewInfo(name), nullptr, 0, method) || file.write(data) != data.size())
+                return false;
+            file.close();
+        }
+        zip.close();
+        return zip.getZipError() == 0;
+    }
+
+   private slots:
+    void test_Read_data()
+    {
+        QTest::addColumn<int>("method");
+        QTest::newRow("stored") << 0;
+        QTest::newRow("deflated") << int(Z_DEFLATED);
+    }
+
+    void test_Read()
+    {
+        QFETCH(int, method);
+        QTemporaryDir dir;
+        auto path = dir.filePath("mod.jar");
+        QByteArray big(300 * 1024, 'x');
+        QVERIFY(makeZip(path,
+                        { { "fabric.mod.json", R"({ "id": "mod" })" },
+                          { "assets/mod/icon.png", big },
+                          { "empty.txt", "" },
+                          { "fabric.mod.json", "the second one" } },
+                        method));
+
+        ZipReader zip(path);
+        QVERIFY(zip.open());
+        QCOMPARE(zip.fileNames(), QStringList({ "fabric.mod.json", "assets/mod/icon.png", "empty.txt" }));
+        QVERIFY(zip.contains("assets/mod/icon.png"));
+        QVERIFY(!zip.contains("mcmod.info"));
+        QVERIFY(zip.containsFolder("assets"));
+        QVERIFY(zip.containsFolder("assets/mod"));
+        QVERIFY(!zip.containsFolder("data"));
+        QVERIFY(!zip.containsFolder("fabric.mod.json"));
+
+        QCOMPARE(zip.read("fabric.mod.json"), QByteArray(R"({ "id": "mod" })"));
+        QCOMPARE(zip.read("assets/mod/icon.png"), big);
+        QVERIFY(!zip.read("empty.txt").isNull());
+        QVERIFY(zip.read("empty.txt").isEmpty());
+        QVERIFY(zip.read("mcmod.info").isNull());
+    }
+
+    void test_NotZip()
+    {
+        QTemporaryDir dir;
+        auto path = dir.filePath("mod.jar");
+        FS::write(path, QByteArray(1024, 'P'));
+        ZipReader zip(path);
+        QVERIFY(!zip.open());
+        QVERIFY(!ZipReader(dir.filePath("missing.jar")).open());
+    }
+};
+
+QTEST_GUILESS_MAIN(ZipReaderTest)
+
+#include "ZipReader_test.moc"
@@ -0,0 +1,60 @@
+#include <QCryptographicHash>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/AssetsManifest.h>
+
+class AssetsManifestBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_Check4000_data()
+    {
+        QTest::addColumn<bool>("manifest");
+        QTest::newRow("every file") << false;
+        QTest::newRow("manifest") << true;
+    }
+
+    // about the size of the 1.20 index, checked by looking at every file or through the manifest of an earlier session
+    void benchmark_Check4000()
+    {
+        QFETCH(bool, manifest);
+        QTemporaryDir dir;
+        auto objects = dir.filePath("objects");
+        auto manifestFile = dir.filePath("assets.json");
+        QList<QPair<QString, qint64>> index;
+        for (int i = 0; i < 4000; i++) {
+            auto data = QByteArray::number(i);
+            auto hash = QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+            FS::write(FS::PathCombine(objects, hash.left(2), hash), data);
+            index.append({ hash, data.size() });
+        }
+        {
+            AssetsManifest earlier(objects, manifestFile);
+            for (auto& [hash, size] : index)
+                earlier.contains(hash, size);
+            earlier.save();
+        }
+
+        int found = 0;
+        QBENCHMARK_ONCE
+        {
+            if (manifest) {
+                AssetsManifest later(objects, manifestFile);
+                for (auto& [hash, size] : index)
+                    found += later.contains(hash, size);
+            } else {
+                for (auto& [hash, size] : index) {
+                    QFileInfo info(FS::PathCombine(objects, hash.left(2), hash));
+                    found += info.isFile() && info.size() == size;
+                }
+            }
+        }
+        QCOMPARE(found, 4000);
+    }
+};
+
+QTEST_GUILESS_MAIN(AssetsManifestBenchmark)
+
+#include "AssetsManifest_benchmark.moc"
@@ -0,0 +1,52 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <net/HttpMetaCache.h>
+
+#include <memory>
+
+class HttpMetaCacheBenchmark : public QObject {
+    Q_OBJECT
+
+    static std::unique_ptr<HttpMetaCache> makeCache(const QTemporaryDir& dir)
+    {
+        auto cache = std::make_unique<HttpMetaCache>(FS::PathCombine(dir.path(), "metacache"));
+        cache->addBase("libraries", FS::PathCombine(dir.path(), "libraries"));
+        cache->Load();
+        return cache;
+    }
+
+   private slots:
+    // far more entries than any real cache, to see how saving and loading grow
+    void benchmark_SaveAndLoad500k()
+    {
+        QTemporaryDir dir;
+        {
+            auto cache = makeCache(dir);
+            for (int i = 0; i < 500000; i++) {
+                auto entry = cache->resolveEntry("libraries", QString("com/example/lib%1/1.0/lib%1-1.0.jar").arg(i));
+                entry->setMD5Sum("d41d8cd98f00b204e9800998ecf8427e");
+                entry->setETag(QString("\"%1\"").arg(i));
+                entry->setLocalChangedTimestamp(1700000000000);
+                entry->setRemoteChangedTimestamp("Tue, 14 Nov 2023 22:13:20 GMT");
+                entry->setMaximumAge(604800);
+                entry->setStale(false);
+                cache->updateEntry(entry);
+            }
+            QBENCHMARK_ONCE
+            {
+                QVERIFY(cache->SaveNow());
+            }
+        }
+        QBENCHMARK_ONCE
+        {
+            auto cache = makeCache(dir);
+            QVERIFY(cache->getEntry("libraries", "com/example/lib499999/1.0/lib499999-1.0.jar"));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(HttpMetaCacheBenchmark)
+
+#include "HttpMetaCache_benchmark.moc"
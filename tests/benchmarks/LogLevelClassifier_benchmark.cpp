@@ -0,0 +1,35 @@
+#include <QTest>
+
+#include <minecraft/LogLevelClassifier.h>
+
+class LogLevelClassifierBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_ForgeStartup()
+    {
+        // the mix of a modded client starting up: mostly log4j lines, now and then a stack trace
+        QStringList lines;
+        for (int i = 0; i < 1000; i++) {
+            lines << QString("[12:00:%1] [modloading-worker-%2/INFO] [net.minecraftforge.fml.ModLoader/]: Loading mod number %3")
+                         .arg(i % 60)
+                         .arg(i % 8)
+                         .arg(i);
+            if (i % 50 == 0) {
+                lines << "java.lang.IllegalStateException: Something went wrong"
+                      << "\tat net.minecraftforge.fml.ModLoader.dispatch(ModLoader.java:245)"
+                      << "\t... 42 more";
+            }
+        }
+        auto classifier = LogLevelClassifier::minecraft();
+        QBENCHMARK
+        {
+            for (auto& line : lines)
+                classifier->classify(line, MessageLevel::StdOut);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(LogLevelClassifierBenchmark)
+
+#include "LogLevelClassifier_benchmark.moc"
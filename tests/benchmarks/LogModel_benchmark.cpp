@@ -0,0 +1,70 @@
+#include <QTest>
+
+#include <launch/LogModel.h>
+
+class LogModelBenchmark : public QObject {
+    Q_OBJECT
+
+    // a million lines with a single error at the end
+    static void fillMillion(LogModel& model)
+    {
+        model.setMaxLines(1000000);
+        for (int i = 0; i < 1000000; i++)
+            model.append(MessageLevel::Message, QString("[12:34:56] [Worker-Main-%1/INFO]: Loaded chunk %2").arg(i % 16).arg(i));
+        model.append(MessageLevel::Error, "[12:34:56] [Server thread/ERROR]: Encountered an unexpected exception");
+    }
+
+   private slots:
+    void benchmark_FindText()
+    {
+        LogModel model;
+        fillMillion(model);
+        int row = -1;
+        QBENCHMARK
+        {
+            row = model.findText("unexpected exception", 0, false);
+        }
+        QCOMPARE(row, 999999);
+    }
+
+    void benchmark_FindLevel()
+    {
+        LogModel model;
+        fillMillion(model);
+        int row = -1;
+        QBENCHMARK
+        {
+            row = model.findLevel(MessageLevel::Error, 0, false);
+        }
+        QCOMPARE(row, 999999);
+    }
+
+    void benchmark_Append()
+    {
+        auto text = QString("[12:34:56] [Render thread/WARN]: Missing sound for event: minecraft:item.goat_horn.play");
+        QBENCHMARK
+        {
+            LogModel model;
+            model.setMaxLines(100000);
+            for (int i = 0; i < 200000; i++)
+                model.append(MessageLevel::Warning, text);
+        }
+    }
+
+    void benchmark_ToPlainText()
+    {
+        LogModel model;
+        model.setMaxLines(100000);
+        for (int i = 0; i < 100000; i++)
+            model.append(MessageLevel::Message, QString("line number %1 of the log").arg(i));
+        QBENCHMARK
+        {
+            auto text = model.toPlainText();
+            Q_UNUSED(text)
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(LogModelBenchmark)
+
+#include "LogModel_benchmark.moc"
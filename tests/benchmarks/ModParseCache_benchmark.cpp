@@ -0,0 +1,68 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+
+#include <minecraft/mod/ModParseCache.h>
+#include <minecraft/mod/tasks/LocalModParseTask.h>
+
+class ModParseCacheBenchmark : public QObject {
+    Q_OBJECT
+
+    static QString makeMod(const QTemporaryDir& dir, int n)
+    {
+        auto root = dir.filePath(QString("src/mod%1").arg(n));
+        auto info = QString(R"({ "schemaVersion": 1, "id": "mod%1", "name": "Mod %1", "version": "1.0.0", "authors": [ "someone" ] })").arg(n);
+        FS::write(FS::PathCombine(root, "fabric.mod.json"), info.toUtf8());
+        // something to skip over, like the classes of a real mod
+        FS::write(FS::PathCombine(root, "Mod.class"), QByteArray(64 * 1024, char(n)));
+        auto jar = dir.filePath(QString("mods/mod%1.jar").arg(n));
+        FS::ensureFilePathExists(jar);
+        QFileInfoList files{ QFileInfo(FS::PathCombine(root, "fabric.mod.json")), QFileInfo(FS::PathCombine(root, "Mod.class")) };
+        MMCZip::compressDirFiles(jar, root, files);
+        return jar;
+    }
+
+    static void parseAll(const QStringList& jars, std::shared_ptr<ModParseCache> cache)
+    {
+        for (auto& jar : jars) {
+            LocalModParseTask task(0, ResourceType::ZIPFILE, QFileInfo(jar), cache);
+            task.start();
+            QVERIFY(!task.result()->details.mod_id.isEmpty());
+        }
+    }
+
+   private slots:
+    void benchmark_Parse500_data()
+    {
+        QTest::addColumn<bool>("cached");
+        QTest::newRow("cold") << false;
+        QTest::newRow("cached") << true;
+    }
+
+    // a large modpack, read without and with the cache of an earlier session
+    void benchmark_Parse500()
+    {
+        QFETCH(bool, cached);
+        QTemporaryDir dir;
+        QStringList jars;
+        for (int i = 0; i < 500; i++)
+            jars << makeMod(dir, i);
+        auto cacheFile = dir.filePath("cache/mods.json");
+        if (cached) {
+            auto cache = std::make_shared<ModParseCache>(cacheFile, dir.filePath("mods"));
+            parseAll(jars, cache);
+            cache->save();
+        }
+
+        QBENCHMARK_ONCE
+        {
+            parseAll(jars, std::make_shared<ModParseCache>(cacheFile, dir.filePath("mods")));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ModParseCacheBenchmark)
+
+#include "ModParseCache_benchmark.moc"
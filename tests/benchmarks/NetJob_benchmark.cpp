@@ -0,0 +1,56 @@
+#include <QSignalSpy>
+#include <QTest>
+
+#include <net/NetJob.h>
+
+#include "../MockCdn.h"
+
+class NetJobBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_AssetIndex_data()
+    {
+        QTest::addColumn<bool>("per_host");
+        QTest::newRow("fixed") << false;
+        QTest::newRow("per host") << true;
+    }
+
+    void benchmark_AssetIndex()
+    {
+        QFETCH(bool, per_host);
+
+        // a few large jars on one server, then many tiny assets on another
+        MockCdn maven;
+        maven.body_size = 4 * 1024 * 1024;
+        maven.latency_ms = 50;
+        MockCdn assets;
+        QVERIFY(maven.listen(QHostAddress::LocalHost));
+        QVERIFY(assets.listen(QHostAddress::LocalHost));
+
+        auto network = makeShared<QNetworkAccessManager>();
+        NetJob::Ptr job{ new NetJob("benchmark", network, per_host ? -1 : 6) };
+        for (int i = 0; i < 4; i++)
+            job->addNetAction(Net::Download::makeByteArray(QUrl(QString("http://127.0.0.1:%1/lib%2.jar").arg(maven.serverPort()).arg(i)),
+                                                           std::make_shared<QByteArray>()));
+        for (int i = 0; i < 1000; i++) {
+            auto dl = Net::Download::makeByteArray(QUrl(QString("http://127.0.0.1:%1/%2").arg(assets.serverPort()).arg(i)),
+                                                   std::make_shared<QByteArray>());
+            dl->setExpectedSize(assets.body_size);
+            job->addNetAction(dl);
+        }
+
+        QSignalSpy succeeded(job.get(), &Task::succeeded);
+        QBENCHMARK_ONCE
+        {
+            QSignalSpy finished(job.get(), &Task::finished);
+            job->start();
+            QVERIFY(finished.wait(120000));
+        }
+        QCOMPARE(succeeded.size(), 1);
+    }
+};
+
+QTEST_GUILESS_MAIN(NetJobBenchmark)
+
+#include "NetJob_benchmark.moc"